@@ -43,6 +43,7 @@ namespace Mantid {
 namespace Kernel {
 // this is declared in MantidKernel/Timer.h
 using time_point_ns = std::chrono::time_point<std::chrono::high_resolution_clock>;
+class TraceSpan;
 } // namespace Kernel
 namespace Indexing {
 class SpectrumIndexSet;
@@ -494,6 +495,8 @@ private:
 
   void registerFeatureUsage() const;
 
+  void addTraceCounters(Kernel::TraceSpan &span) const;
+
   Parallel::ExecutionMode getExecutionMode() const;
   std::map<std::string, Parallel::StorageMode> getInputWorkspaceStorageModes() const;
   void setupSkipValidationMasterOnly();
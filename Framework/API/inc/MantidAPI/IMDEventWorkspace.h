@@ -21,6 +21,8 @@
 #include "MantidKernel/ProgressBase.h"
 #include "MantidKernel/ThreadScheduler.h"
 
+#include <atomic>
+
 namespace Mantid {
 namespace API {
 
@@ -86,6 +88,10 @@ public:
 
   void setFileNeedsUpdating(bool value);
 
+  uint64_t getModificationCount() const;
+
+  void markModified();
+
   bool threadSafe() const override;
 
   virtual void setCoordinateSystem(const Mantid::Kernel::SpecialCoordinateSystem coordinateSystem) = 0;
@@ -106,12 +112,14 @@ public:
 
 protected:
   /// Protected copy constructor. May be used by childs for cloning.
-  IMDEventWorkspace(const IMDEventWorkspace &) = default;
+  IMDEventWorkspace(const IMDEventWorkspace &other);
 
   const std::string toString() const override;
   /// Marker set to true when a file-backed workspace needs its back-end file
   /// updated (by calling SaveMD(UpdateFileBackEnd=1) )
   bool m_fileNeedsUpdating;
+  /// Count of the changes to the events, boxes or masking
+  std::atomic<uint64_t> m_modificationCount;
 
 private:
   IMDEventWorkspace *doClone() const override = 0;
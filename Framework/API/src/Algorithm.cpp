@@ -11,7 +11,11 @@
 #include "MantidAPI/AnalysisDataService.h"
 #include "MantidAPI/DeprecatedAlgorithm.h"
 #include "MantidAPI/DeprecatedAlias.h"
+#include "MantidAPI/FileProperty.h"
+#include "MantidAPI/IEventWorkspace.h"
+#include "MantidAPI/IMDEventWorkspace.h"
 #include "MantidAPI/IWorkspaceProperty.h"
+#include "MantidAPI/MatrixWorkspace.h"
 #include "MantidAPI/WorkspaceGroup.h"
 #include "MantidAPI/WorkspaceHistory.h"
 
@@ -23,6 +27,7 @@
 #include "MantidKernel/PropertyWithValue.h"
 #include "MantidKernel/Strings.h"
 #include "MantidKernel/Timer.h"
+#include "MantidKernel/TraceRecorder.h"
 #include "MantidKernel/UsageService.h"
 
 #include "MantidParallel/Communicator.h"
@@ -30,6 +35,7 @@
 #include "MantidKernel/StringTokenizer.h"
 #include <Poco/ActiveMethod.h>
 #include <Poco/ActiveResult.h>
+#include <Poco/File.h>
 #include <Poco/NotificationCenter.h>
 #include <Poco/RWLock.h>
 #include <Poco/Void.h>
@@ -40,6 +46,7 @@
 #include <iterator>
 #include <map>
 #include <memory>
+#include <optional>
 #include <utility>
 
 // Index property handling template definitions
@@ -654,8 +661,15 @@ bool Algorithm::executeInternal() {
       setExecutionState(ExecutionState::Running);
 
       startTime = Mantid::Types::Core::DateAndTime::getCurrentTime();
+      // Recorded in the performance trace, if it is enabled. The name is only
+      // built then, so a disabled trace costs nothing more than the check.
+      std::optional<TraceSpan> traceSpan;
+      if (TraceRecorder::Instance().isEnabled())
+        traceSpan.emplace(this->name() + ".v" + std::to_string(this->version()), "algorithm");
       // Call the concrete algorithm's exec method
       this->exec(executionMode);
+      if (traceSpan && traceSpan->isActive())
+        addTraceCounters(*traceSpan);
       registerFeatureUsage();
       // Check for a cancellation request in case the concrete algorithm doesn't
       interruption_point();
@@ -1739,6 +1753,36 @@ void Algorithm::registerFeatureUsage() const {
   }
 }
 
+/** Add to the trace span of the execution the sizes of the files and the
+ * numbers of spectra and events of the workspaces the algorithm read and wrote
+ * @param span :: the span of the execution
+ */
+void Algorithm::addTraceCounters(Kernel::TraceSpan &span) const {
+  for (const auto *prop : getProperties()) {
+    const auto *fileProp = dynamic_cast<const FileProperty *>(prop);
+    if (!fileProp || fileProp->isDirectoryProperty() || fileProp->value().empty())
+      continue;
+    const Poco::File file(fileProp->value());
+    if (!file.exists() || !file.isFile())
+      continue;
+    span.addCounter(fileProp->isLoadProperty() ? "bytes_read" : "bytes_written", static_cast<double>(file.getSize()));
+  }
+
+  const auto addWorkspaceCounters = [&span](const std::vector<IWorkspaceProperty *> &props, const std::string &prefix) {
+    for (const auto *prop : props) {
+      const auto workspace = prop->getWorkspace();
+      if (const auto eventWS = std::dynamic_pointer_cast<const IEventWorkspace>(workspace))
+        span.addCounter(prefix + "_events", static_cast<double>(eventWS->getNumberEvents()));
+      if (const auto matrixWS = std::dynamic_pointer_cast<const MatrixWorkspace>(workspace))
+        span.addCounter(prefix + "_spectra", static_cast<double>(matrixWS->getNumberHistograms()));
+      else if (const auto mdEventWS = std::dynamic_pointer_cast<const IMDEventWorkspace>(workspace))
+        span.addCounter(prefix + "_events", static_cast<double>(mdEventWS->getNEvents()));
+    }
+  };
+  addWorkspaceCounters(m_inputWorkspaceProps, "input");
+  addWorkspaceCounters(m_outputWorkspaceProps, "output");
+}
+
 /** Enable or disable Logging of start and end messages
 @param enabled : true to enable logging, false to disable
 */
@@ -17,7 +17,14 @@ namespace Mantid::API {
 
 //-----------------------------------------------------------------------------------------------
 /** Empty constructor */
-IMDEventWorkspace::IMDEventWorkspace() : IMDWorkspace(), MultipleExperimentInfos(), m_fileNeedsUpdating(false) {}
+IMDEventWorkspace::IMDEventWorkspace()
+    : IMDWorkspace(), MultipleExperimentInfos(), m_fileNeedsUpdating(false), m_modificationCount(0) {}
+
+//-----------------------------------------------------------------------------------------------
+/** Copy constructor. The copy starts with no recorded modifications */
+IMDEventWorkspace::IMDEventWorkspace(const IMDEventWorkspace &other)
+    : IMDWorkspace(other), MultipleExperimentInfos(other), m_fileNeedsUpdating(other.m_fileNeedsUpdating),
+      m_modificationCount(0) {}
 
 //-----------------------------------------------------------------------------------------------
 /** @return the marker set to true when a file-backed workspace needs its
@@ -32,6 +39,21 @@ bool IMDEventWorkspace::fileNeedsUpdating() const { return m_fileNeedsUpdating;
  */
 void IMDEventWorkspace::setFileNeedsUpdating(bool value) { m_fileNeedsUpdating = value; }
 
+//-----------------------------------------------------------------------------------------------
+/** @return a count of the changes made to the events, boxes or masking of the
+ * workspace, so that results cached from it can tell that it changed. It is
+ * increased whenever events are added, boxes are split or masked, the cache
+ * is refreshed, or markModified() is called.
+ */
+uint64_t IMDEventWorkspace::getModificationCount() const { return m_modificationCount.load(); }
+
+//-----------------------------------------------------------------------------------------------
+/** Record a change made to the events or boxes of the workspace. Call this
+ * after changing the boxes directly rather than through the workspace, e.g.
+ * when transforming them in place.
+ */
+void IMDEventWorkspace::markModified() { m_modificationCount.fetch_add(1, std::memory_order_relaxed); }
+
 //-----------------------------------------------------------------------------------------------
 /** Is the workspace thread-safe. For MDEventWorkspaces, this means operations
  * on separate boxes in separate threads. Don't try to write to the
@@ -24,6 +24,7 @@
 #include "MantidKernel/ReadLock.h"
 #include "MantidKernel/RebinParamsValidator.h"
 #include "MantidKernel/Strings.h"
+#include "MantidKernel/TraceRecorder.h"
 #include "MantidKernel/WriteLock.h"
 #include "PropertyManagerHelper.h"
 #include <map>
@@ -571,6 +572,37 @@ public:
     TS_ASSERT_EQUALS(1, inputWorkspace.use_count());
   }
 
+  void test_execute_records_a_trace_span() {
+    auto input = std::make_shared<WorkspaceTester>();
+    input->initialize(3, 4, 4);
+    auto &ads = AnalysisDataService::Instance();
+    ads.addOrReplace("traceIn", input);
+    auto &recorder = TraceRecorder::Instance();
+    recorder.clear();
+    recorder.enable();
+
+    StubbedWorkspaceAlgorithm alg;
+    alg.initialize();
+    alg.setPropertyValue("InputWorkspace1", "traceIn");
+    alg.setPropertyValue("OutputWorkspace1", "traceOut");
+    alg.execute();
+    recorder.disable();
+
+    const auto events = recorder.events();
+    TS_ASSERT_EQUALS(events.size(), 1);
+    const auto &event = events.front();
+    TS_ASSERT_EQUALS(event.name, "StubbedWorkspaceAlgorithm.v1");
+    TS_ASSERT_EQUALS(event.category, "algorithm");
+    const std::map<std::string, double> counters(event.counters.cbegin(), event.counters.cend());
+    TS_ASSERT_EQUALS(counters.at("input_spectra"), 3.);
+    TS_ASSERT_EQUALS(counters.at("output_spectra"), 10.);
+    TS_ASSERT_EQUALS(counters.count("bytes_read"), 0);
+
+    recorder.clear();
+    ads.remove("traceIn");
+    ads.remove("traceOut");
+  }
+
   void test_Algorithm_Keeps_Only_WorkspaceProperty_Ref_If_Not_Stored_In_ADS() {
     // create an input workspace, add it to the ADS
     auto inputWorkspace = std::make_shared<WorkspaceTester>();
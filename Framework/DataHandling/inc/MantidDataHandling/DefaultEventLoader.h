@@ -10,6 +10,8 @@
 #include "MantidDataHandling/DllConfig.h"
 #include "MantidDataHandling/EventWorkspaceCollection.h"
 
+#include <mutex>
+
 class BankPulseTimes;
 
 namespace Mantid {
@@ -27,6 +29,8 @@ public:
                    std::vector<std::size_t> bankNumEvents, const bool oldNeXusFileNames, const bool precount,
                    const int chunk, const int totalChunks);
 
+  static bool canReadBanksConcurrently();
+
   /// Flag for dealing with a simulated file
   bool m_haveWeights;
 
@@ -71,6 +75,8 @@ public:
 
   /// One entry of pulse times for each preprocessor
   std::vector<std::shared_ptr<BankPulseTimes>> m_bankPulseTimes;
+  /// Guards m_bankPulseTimes when banks are read concurrently
+  std::mutex m_bankPulseTimesMutex;
 
 private:
   DefaultEventLoader(LoadEventNexus *alg, EventWorkspaceCollection &ws, bool haveWeights, bool event_id_is_spec,
@@ -0,0 +1,94 @@
+// Mantid Repository : https://github.com/mantidproject/mantid
+//
+// Copyright &copy; 2022 ISIS Rutherford Appleton Laboratory UKRI,
+//   NScD Oak Ridge National Laboratory, European Spallation Source,
+//   Institut Laue - Langevin & CSNS, Institute of High Energy Physics, CAS
+// SPDX - License - Identifier: GPL - 3.0 +
+#pragma once
+
+#include "MantidAPI/IEventList.h"
+#include "MantidDataObjects/Events.h"
+#include "MantidTypes/Event/TofEvent.h"
+
+#include <array>
+#include <cstdint>
+#include <stdexcept>
+
+namespace Mantid {
+namespace DataHandling {
+namespace EventCache {
+
+/** On-disk layout shared by SaveEventCache and LoadEventCache.
+
+  The file is a fixed size FileHeader followed by three sections, each
+  starting on a SECTION_ALIGNMENT boundary:
+  <UL>
+  <LI> metadata - a processed NeXus file of the workspace with the events
+       dropped, holding the instrument, logs, spectrum numbers, detector IDs
+       and binning </LI>
+  <LI> table - one SpectrumEntry per spectrum </LI>
+  <LI> events - the raw event arrays of every spectrum back to back, in the
+       native in-memory layout of the event type of that spectrum </LI>
+  </UL>
+  Aligning the event section lets it be memory mapped directly so that only
+  the pages of the spectra that are read are ever faulted in.
+*/
+
+/// Identifies the file type; first bytes of every cache file
+constexpr std::array<char, 8> MAGIC{{'M', 'T', 'D', 'E', 'V', 'C', 'H', '\0'}};
+/// Bumped whenever the layout changes
+constexpr uint32_t VERSION = 1;
+/// Written in native byte order to detect files from a machine of different endianness
+constexpr uint32_t BYTE_ORDER_MARK = 0x01020304;
+/// Alignment of each section in bytes
+constexpr uint64_t SECTION_ALIGNMENT = 65536;
+
+struct FileHeader {
+  std::array<char, 8> magic;
+  uint32_t version;
+  uint32_t byteOrderMark;
+  uint64_t numberOfSpectra;
+  uint64_t metadataOffset;
+  uint64_t metadataSize;
+  uint64_t tableOffset;
+  uint64_t eventsOffset;
+  uint64_t eventsSize;
+};
+
+struct SpectrumEntry {
+  /// Byte offset of the first event relative to the start of the event section
+  uint64_t offset;
+  uint64_t numberOfEvents;
+  /// Value of API::EventType
+  uint32_t eventType;
+  /// Value of DataObjects::EventSortType
+  uint32_t sortOrder;
+};
+
+static_assert(sizeof(FileHeader) == 64, "EventCache::FileHeader must have a fixed layout");
+static_assert(sizeof(SpectrumEntry) == 24, "EventCache::SpectrumEntry must have a fixed layout");
+static_assert(sizeof(Types::Event::TofEvent) == 16, "Cached TofEvent layout has changed");
+static_assert(sizeof(DataObjects::WeightedEvent) == 24, "Cached WeightedEvent layout has changed");
+static_assert(sizeof(DataObjects::WeightedEventNoTime) == 16, "Cached WeightedEventNoTime layout has changed");
+
+/// Round offset up to the next section boundary
+constexpr uint64_t alignSection(const uint64_t offset) {
+  return (offset + SECTION_ALIGNMENT - 1) / SECTION_ALIGNMENT * SECTION_ALIGNMENT;
+}
+
+/// Size in bytes of a single event of the given type as stored in the event section
+inline uint64_t eventSize(const API::EventType type) {
+  switch (type) {
+  case API::TOF:
+    return sizeof(Types::Event::TofEvent);
+  case API::WEIGHTED:
+    return sizeof(DataObjects::WeightedEvent);
+  case API::WEIGHTED_NOTIME:
+    return sizeof(DataObjects::WeightedEventNoTime);
+  }
+  throw std::runtime_error("EventCache: unknown event type");
+}
+
+} // namespace EventCache
+} // namespace DataHandling
+} // namespace Mantid
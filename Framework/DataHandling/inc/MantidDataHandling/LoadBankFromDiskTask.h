@@ -12,6 +12,7 @@
 #include "MantidKernel/ThreadScheduler.h"
 
 #include <cstdint>
+#include <memory>
 
 class BankPulseTimes;
 
@@ -24,9 +25,12 @@ namespace DataHandling {
 class DefaultEventLoader;
 
 /** This task does the disk IO from loading the NXS file, and so will be on a
-  disk IO mutex
+  disk IO mutex (unless the HDF5 library is thread safe). Decoding of the
+  arrays read from disk is handed to a follow-up task without a mutex so that
+  it overlaps with the reading of the next bank.
 */
-class MANTID_DATAHANDLING_DLL LoadBankFromDiskTask : public Kernel::Task {
+class MANTID_DATAHANDLING_DLL LoadBankFromDiskTask : public Kernel::Task,
+                                                     public std::enable_shared_from_this<LoadBankFromDiskTask> {
 
 public:
   LoadBankFromDiskTask(DefaultEventLoader &loader, std::string entry_name, std::string entry_type,
@@ -44,6 +48,7 @@ private:
   std::unique_ptr<std::vector<uint32_t>> loadEventId(::NeXus::File &file);
   std::unique_ptr<std::vector<float>> loadTof(::NeXus::File &file);
   std::unique_ptr<std::vector<float>> loadEventWeights(::NeXus::File &file);
+  void decodeAndProcess();
   int64_t recalculateDataSize(const int64_t &size);
 
   /// Algorithm being run
@@ -74,6 +79,16 @@ private:
   bool m_have_weight;
   /// Frame period numbers
   const std::vector<int> m_framePeriodNumbers;
+  /// Event pixel IDs read from disk
+  std::unique_ptr<std::vector<uint32_t>> m_event_id;
+  /// Event times-of-flight read from disk, in m_tof_unit until decoded
+  std::unique_ptr<std::vector<float>> m_event_time_of_flight;
+  /// Event weights read from disk, if any
+  std::unique_ptr<std::vector<float>> m_event_weight;
+  /// Event index read from disk (length of # of pulses)
+  std::vector<uint64_t> m_event_index;
+  /// Units of the time-of-flight field in the file
+  std::string m_tof_unit;
 }; // END-DEF-CLASS LoadBankFromDiskTask
 
 } // namespace DataHandling
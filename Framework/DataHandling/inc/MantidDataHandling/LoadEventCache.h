@@ -0,0 +1,48 @@
+// Mantid Repository : https://github.com/mantidproject/mantid
+//
+// Copyright &copy; 2022 ISIS Rutherford Appleton Laboratory UKRI,
+//   NScD Oak Ridge National Laboratory, European Spallation Source,
+//   Institut Laue - Langevin & CSNS, Institute of High Energy Physics, CAS
+// SPDX - License - Identifier: GPL - 3.0 +
+#pragma once
+
+#include "MantidAPI/IFileLoader.h"
+#include "MantidDataHandling/DllConfig.h"
+#include "MantidDataHandling/EventCacheFormat.h"
+#include "MantidKernel/FileDescriptor.h"
+
+namespace Mantid {
+namespace DataHandling {
+
+/** LoadEventCache : Loads an EventWorkspace from a cache file written by
+  SaveEventCache.
+
+  The event section of the file is memory mapped and the events of each
+  requested spectrum are copied straight into its EventList, so only the pages
+  holding the requested spectra are read from disk and no decompression or
+  unit conversion takes place.
+ */
+class MANTID_DATAHANDLING_DLL LoadEventCache : public API::IFileLoader<Kernel::FileDescriptor> {
+public:
+  const std::string name() const override { return "LoadEventCache"; }
+  int version() const override { return 1; }
+  const std::vector<std::string> seeAlso() const override { return {"SaveEventCache", "LoadEventNexus"}; }
+  const std::string category() const override { return "DataHandling"; }
+  const std::string summary() const override {
+    return "Loads an EventWorkspace from an event cache file written by SaveEventCache.";
+  }
+
+  /// Returns a confidence value that this algorithm can load a file
+  int confidence(Kernel::FileDescriptor &descriptor) const override;
+
+private:
+  void init() override;
+  std::map<std::string, std::string> validateInputs() override;
+  void exec() override;
+
+  EventCache::FileHeader readHeader(std::ifstream &file, const std::string &filename) const;
+  API::MatrixWorkspace_sptr loadMetadata(std::ifstream &file, const EventCache::FileHeader &header);
+};
+
+} // namespace DataHandling
+} // namespace Mantid
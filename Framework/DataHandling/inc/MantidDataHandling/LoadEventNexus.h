@@ -152,6 +152,11 @@ public:
   /// not written properly within the instrument
   static std::string readInstrumentFromISIS_VMSCompat(::NeXus::File &hFile);
 
+  /// Callback run on every chunk when loading with MaxChunkSize
+  using ChunkProcessor = std::function<API::MatrixWorkspace_sptr(const API::MatrixWorkspace_sptr &)>;
+  /// Process each chunk with a callback instead of ChunkProcessingAlgorithm
+  void setChunkProcessor(ChunkProcessor processor) { m_chunkProcessor = std::move(processor); }
+
 public:
   /// The name and path of the input file
   std::string m_filename;
@@ -218,6 +223,15 @@ private:
   DataObjects::EventWorkspace_sptr createEmptyEventWorkspace();
 
   void loadEvents(API::Progress *const prog, const bool monitors);
+  void loadEventsInChunks(const double maxChunkSize, const bool haveWeights, const std::vector<std::string> &bankNames,
+                          const std::vector<std::size_t> &bankNumEvents, const std::vector<int> &periodLog,
+                          const std::string &classType, const bool oldNeXusFileNames,
+                          const Kernel::NexusHDF5Descriptor *descriptor, const bool is_time_filtered);
+  void finishLoadingEvents(const std::string &classType, const Kernel::NexusHDF5Descriptor *descriptor,
+                           const bool is_time_filtered);
+  HistogramData::BinEdges defaultBinEdges(const std::size_t eventsLoaded);
+  API::MatrixWorkspace_sptr processChunk(const API::MatrixWorkspace_sptr &chunkWS, const double progStart,
+                                         const double progEnd);
   void createSpectraMapping(const std::string &nxsfile, const bool monitorsOnly,
                             const std::vector<std::string> &bankNames = std::vector<std::string>());
   void deleteBanks(const EventWorkspaceCollection_sptr &workspace, const std::vector<std::string> &bankNames);
@@ -247,6 +261,11 @@ private:
   bool loadlogs;
   /// True if the event_id is spectrum no not pixel ID
   bool event_id_is_spec;
+
+  /// Optional callback used in place of ChunkProcessingAlgorithm
+  ChunkProcessor m_chunkProcessor;
+  /// Accumulated result when the file was loaded in chunks
+  API::MatrixWorkspace_sptr m_chunkedOutput;
 };
 
 //-----------------------------------------------------------------------------
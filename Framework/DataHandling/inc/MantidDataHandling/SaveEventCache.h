@@ -0,0 +1,43 @@
+// Mantid Repository : https://github.com/mantidproject/mantid
+//
+// Copyright &copy; 2022 ISIS Rutherford Appleton Laboratory UKRI,
+//   NScD Oak Ridge National Laboratory, European Spallation Source,
+//   Institut Laue - Langevin & CSNS, Institute of High Energy Physics, CAS
+// SPDX - License - Identifier: GPL - 3.0 +
+#pragma once
+
+#include "MantidAPI/Algorithm.h"
+#include "MantidDataHandling/DllConfig.h"
+#include "MantidDataObjects/EventWorkspace_fwd.h"
+
+namespace Mantid {
+namespace DataHandling {
+
+/** SaveEventCache : Saves an EventWorkspace to a flat binary cache file that
+  LoadEventCache can memory map, avoiding the cost of decoding the original
+  event NeXus file again when the same run is reduced repeatedly.
+
+Required Properties:
+<UL>
+<LI> InputWorkspace - The EventWorkspace to save </LI>
+<LI> Filename - The filename to use for the cache file </LI>
+</UL>
+ */
+class MANTID_DATAHANDLING_DLL SaveEventCache final : public API::Algorithm {
+public:
+  const std::string name() const override { return "SaveEventCache"; }
+  int version() const override { return 1; }
+  const std::vector<std::string> seeAlso() const override { return {"LoadEventCache", "SaveNexusProcessed"}; }
+  const std::string category() const override { return "DataHandling"; }
+  const std::string summary() const override {
+    return "Saves an EventWorkspace to a memory mappable event cache file for fast reloading.";
+  }
+
+private:
+  void init() override;
+  void exec() override;
+  std::string saveMetadata(const DataObjects::EventWorkspace &inputWS);
+};
+
+} // namespace DataHandling
+} // namespace Mantid
@@ -12,6 +12,8 @@
 #include "MantidKernel/BoundedValidator.h"
 #include "MantidKernel/DateAndTimeHelpers.h"
 #include "MantidKernel/DateTimeValidator.h"
+#include "MantidKernel/ListValidator.h"
+#include "MantidKernel/MultiThreaded.h"
 
 #include "tbb/parallel_for.h"
 
@@ -26,6 +28,16 @@ using namespace Kernel;
 using namespace API;
 using namespace DataObjects;
 
+namespace {
+namespace BinningMode {
+const std::string LINEAR("Linear");
+const std::string LOGARITHMIC("Logarithmic");
+} // namespace BinningMode
+
+/// Spectra with fewer events than this are always compressed by a single thread
+constexpr size_t MIN_EVENTS_FOR_PARALLEL_SPECTRUM = 1000000;
+} // namespace
+
 void CompressEvents::init() {
   declareProperty(std::make_unique<WorkspaceProperty<EventWorkspace>>("InputWorkspace", "", Direction::Input),
                   "The name of the EventWorkspace on which to perform the algorithm");
@@ -47,6 +59,13 @@ void CompressEvents::init() {
       "means compressing all wall-clock times together disabling pulsetime "
       "resolution.");
 
+  declareProperty("BinningMode", BinningMode::LINEAR,
+                  std::make_shared<StringListValidator>(std::vector<std::string>{BinningMode::LINEAR,
+                                                                                  BinningMode::LOGARITHMIC}),
+                  "Linear: events within Tolerance of the first event of a group are summed.\n"
+                  "Logarithmic: events within Tolerance times the X value of the first event of a group are "
+                  "summed, which keeps the relative resolution constant.");
+
   auto dateValidator = std::make_shared<DateTimeValidator>();
   dateValidator->allowEmpty(true);
   declareProperty("StartTime", "", dateValidator,
@@ -56,11 +75,22 @@ void CompressEvents::init() {
                   Direction::Input);
 }
 
+std::map<std::string, std::string> CompressEvents::validateInputs() {
+  std::map<std::string, std::string> result;
+  const double toleranceWallClock = getProperty("WallClockTolerance");
+  if (!isEmpty(toleranceWallClock) && getPropertyValue("BinningMode") == BinningMode::LOGARITHMIC)
+    result["BinningMode"] = "Logarithmic binning is not supported with WallClockTolerance";
+  return result;
+}
+
 void CompressEvents::exec() {
   // Get the input workspace
   EventWorkspace_sptr inputWS = getProperty("InputWorkspace");
   EventWorkspace_sptr outputWS = getProperty("OutputWorkspace");
-  const double toleranceTof = getProperty("Tolerance");
+  double toleranceTof = getProperty("Tolerance");
+  // EventList takes a negative tolerance to mean logarithmic, as Rebin does
+  if (getPropertyValue("BinningMode") == BinningMode::LOGARITHMIC)
+    toleranceTof = -toleranceTof;
   const double toleranceWallClock = getProperty("WallClockTolerance");
   const bool compressFat = !isEmpty(toleranceWallClock);
   Types::Core::DateAndTime startTime;
@@ -85,15 +115,28 @@ void CompressEvents::exec() {
   if (!compressFat)
     inputWS->sortAll(TOF_SORT, &prog);
 
+  // A spectrum with a large share of all the events would leave one thread
+  // doing most of the work, so those are compressed one at a time with all
+  // threads working on the same spectrum, and skipped in the loops below.
+  std::vector<bool> isLargeSpectrum(noSpectra, false);
+  const auto numThreads = static_cast<size_t>(PARALLEL_GET_MAX_THREADS);
+  if (!compressFat && numThreads > 1) {
+    const size_t largeThreshold = std::max(MIN_EVENTS_FOR_PARALLEL_SPECTRUM, inputWS->getNumberEvents() / numThreads);
+    for (size_t index = 0; index < noSpectra; ++index)
+      isLargeSpectrum[index] = inputWS->getSpectrum(index).getNumberEvents() >= largeThreshold;
+  }
+
   // Are we making a copy of the input workspace?
   if (!inplace) {
     outputWS = create<EventWorkspace>(*inputWS, HistogramData::BinEdges(2));
     // We DONT copy the data though
     // Loop over the histograms (detector spectra)
     tbb::parallel_for(tbb::blocked_range<size_t>(0, noSpectra),
-                      [compressFat, toleranceTof, startTime, toleranceWallClock, &inputWS, &outputWS,
-                       &prog](const tbb::blocked_range<size_t> &range) {
+                      [compressFat, toleranceTof, startTime, toleranceWallClock, &inputWS, &outputWS, &prog,
+                       &isLargeSpectrum](const tbb::blocked_range<size_t> &range) {
                         for (size_t index = range.begin(); index < range.end(); ++index) {
+                          if (isLargeSpectrum[index])
+                            continue;
                           // The input event list
                           EventList &input_el = inputWS->getSpectrum(index);
                           // And on the output side
@@ -110,9 +153,11 @@ void CompressEvents::exec() {
                       });
   } else { // inplace
     tbb::parallel_for(tbb::blocked_range<size_t>(0, noSpectra),
-                      [compressFat, toleranceTof, startTime, toleranceWallClock, &outputWS,
-                       &prog](const tbb::blocked_range<size_t> &range) {
+                      [compressFat, toleranceTof, startTime, toleranceWallClock, &outputWS, &prog,
+                       &isLargeSpectrum](const tbb::blocked_range<size_t> &range) {
                         for (size_t index = range.begin(); index < range.end(); ++index) {
+                          if (isLargeSpectrum[index])
+                            continue;
                           // The input (also output) event list
                           auto &output_el = outputWS->getSpectrum(index);
                           // The EventList method does the work.
@@ -125,6 +170,16 @@ void CompressEvents::exec() {
                       });
   }
 
+  for (size_t index = 0; index < noSpectra; ++index) {
+    if (!isLargeSpectrum[index])
+      continue;
+    auto &output_el = outputWS->getSpectrum(index);
+    if (!inplace)
+      output_el.setX(inputWS->getSpectrum(index).ptrX());
+    inputWS->getSpectrum(index).compressEvents(toleranceTof, &output_el, true);
+    prog.report("Compressing");
+  }
+
   // Cast to the matrixOutputWS and save it
   this->setProperty("OutputWorkspace", outputWS);
 }
@@ -9,7 +9,12 @@
 #include "MantidDataHandling/LoadBankFromDiskTask.h"
 #include "MantidDataHandling/LoadEventNexus.h"
 #include "MantidKernel/ThreadPool.h"
-#include "MantidKernel/ThreadSchedulerMutexes.h"
+#include "MantidKernel/ThreadSchedulerWorkStealing.h"
+
+#include <H5public.h>
+
+#include <algorithm>
+#include <numeric>
 
 using namespace Mantid::Kernel;
 
@@ -24,10 +29,16 @@ void DefaultEventLoader::load(LoadEventNexus *alg, EventWorkspaceCollection &ws,
 
   auto bankRange = loader.setupChunking(bankNames, bankNumEvents);
 
-  // Make the thread pool
-  auto scheduler = new ThreadSchedulerMutexes;
-  ThreadPool pool(scheduler);
-  auto diskIOMutex = std::make_shared<std::mutex>();
+  // Make the thread pool. The processing tasks a bank pushes run on the thread
+  // that read it, unless another thread is idle and steals them.
+  const size_t numThreads = ThreadPool::getNumPhysicalCores();
+  auto scheduler = new ThreadSchedulerWorkStealing(numThreads);
+  ThreadPool pool(scheduler, numThreads);
+  // Bank reads only need to be serialized if the HDF5 library cannot be used
+  // from several threads at once. Each task opens its own file handle.
+  std::shared_ptr<std::mutex> diskIOMutex;
+  if (!canReadBanksConcurrently())
+    diskIOMutex = std::make_shared<std::mutex>();
 
   // set up progress bar for the rest of the (multi-threaded) process
   size_t numProg = bankNames.size() * (1 + 3); // 1 = disktask, 3 = proc task
@@ -35,7 +46,13 @@ void DefaultEventLoader::load(LoadEventNexus *alg, EventWorkspaceCollection &ws,
     numProg += bankNames.size() * 3; // 3 = second proc task
   auto prog = std::make_unique<API::Progress>(loader.alg, 0.3, 1.0, numProg);
 
-  for (size_t i = bankRange.first; i < bankRange.second; i++) {
+  // Each thread takes the newest bank in its queue first, so schedule the
+  // smallest banks first to start the largest ones early
+  std::vector<size_t> bankOrder(bankRange.second - bankRange.first);
+  std::iota(bankOrder.begin(), bankOrder.end(), bankRange.first);
+  std::stable_sort(bankOrder.begin(), bankOrder.end(),
+                   [&bankNumEvents](const size_t a, const size_t b) { return bankNumEvents[a] < bankNumEvents[b]; });
+  for (const size_t i : bankOrder) {
     if (bankNumEvents[i] > 0)
       pool.schedule(std::make_shared<LoadBankFromDiskTask>(loader, bankNames[i], classType, bankNumEvents[i],
                                                            oldNeXusFileNames, prog.get(), diskIOMutex, *scheduler,
@@ -46,6 +63,17 @@ void DefaultEventLoader::load(LoadEventNexus *alg, EventWorkspaceCollection &ws,
   diskIOMutex.reset();
 }
 
+/** Check whether the banks can be read from disk at the same time. This is
+ * only the case if the HDF5 library has been built thread safe.
+ * @return true if the LoadBankFromDiskTasks need no disk IO mutex
+ */
+bool DefaultEventLoader::canReadBanksConcurrently() {
+  hbool_t threadSafe = false;
+  if (H5is_library_threadsafe(&threadSafe) < 0)
+    return false;
+  return threadSafe > 0;
+}
+
 DefaultEventLoader::DefaultEventLoader(LoadEventNexus *alg, EventWorkspaceCollection &ws, bool haveWeights,
                                        bool event_id_is_spec, const size_t numBanks, const bool precount,
                                        const int chunk, const int totalChunks)
@@ -9,6 +9,7 @@
 #include "MantidDataHandling/DefaultEventLoader.h"
 #include "MantidDataHandling/LoadEventNexus.h"
 #include "MantidDataHandling/ProcessBankData.h"
+#include "MantidKernel/FunctionTask.h"
 #include "MantidKernel/Unit.h"
 #include "MantidNexus/NexusIOHelper.h"
 
@@ -30,7 +31,8 @@ namespace Mantid::DataHandling {
  * @param numEvents :: The number of events in the bank.
  * @param oldNeXusFileNames :: Identify if file is of old variety.
  * @param prog :: an optional Progress object
- * @param ioMutex :: a mutex shared for all Disk I-O tasks
+ * @param ioMutex :: a mutex shared for all Disk I-O tasks, or nullptr if the
+ *banks may be read concurrently
  * @param scheduler :: the ThreadScheduler that runs this task.
  * @param framePeriodNumbers :: Period numbers corresponding to each frame
  */
@@ -75,6 +77,10 @@ void LoadBankFromDiskTask::loadPulseTimes(::NeXus::File &file) {
     thispulseTimes = file.getInfo().dims[0];
   file.closeData();
 
+  // The list of pulse times is shared between all banks, which may be read
+  // concurrently
+  std::lock_guard<std::mutex> lock(m_loader.m_bankPulseTimesMutex);
+
   // Now, we look through existing ones to see if it is already loaded
   // thisBankPulseTimes = NULL;
   for (auto &bankPulseTime : m_loader.m_bankPulseTimes) {
@@ -186,43 +192,18 @@ std::unique_ptr<std::vector<uint32_t>> LoadBankFromDiskTask::loadEventId(::NeXus
       m_loadError = true;
     }
     file.closeData();
-
-    // determine the range of pixel ids
-    m_min_id = *(std::min_element(event_id->data(), event_id->data() + m_loadSize[0]));
-    m_max_id = *(std::max_element(event_id->data(), event_id->data() + m_loadSize[0]));
-
-    if (m_min_id > static_cast<uint32_t>(m_loader.eventid_max)) {
-      // All the detector IDs in the bank are higher than the highest 'known'
-      // (from the IDF)
-      // ID. Setting this will abort the loading of the bank.
-      m_loadError = true;
-    }
-    // fixup the minimum pixel id in the case that it's lower than the lowest
-    // 'known' id. We test this by checking that when we add the offset we
-    // would not get a negative index into the vector. Note that m_min_id is
-    // a uint so we have to be cautious about adding it to an int which may be
-    // negative.
-    if (static_cast<int32_t>(m_min_id) + m_loader.pixelID_to_wi_offset < 0) {
-      m_min_id = static_cast<uint32_t>(abs(m_loader.pixelID_to_wi_offset));
-    }
-    // fixup the maximum pixel id in the case that it's higher than the
-    // highest 'known' id
-    if (m_max_id > static_cast<uint32_t>(m_loader.eventid_max))
-      m_max_id = static_cast<uint32_t>(m_loader.eventid_max);
   }
   return event_id;
 }
 
-/** Open and load the times-of-flight data
+/** Open and load the times-of-flight data. The values are returned in the
+ * units of the file, which are stored in m_tof_unit.
  * @param file An NeXus::File object opened at the correct group
  * @returns A new array containing the time of flights for this bank
  */
 std::unique_ptr<std::vector<float>> LoadBankFromDiskTask::loadTof(::NeXus::File &file) {
-  // Allocate the array
-  auto event_time_of_flight = std::make_unique<std::vector<float>>(m_loadSize[0]);
-
   // Get the list of event_time_of_flight's
-  std::string key, tof_unit;
+  std::string key;
   if (!m_oldNexusFileNames)
     key = "event_time_offset";
   else
@@ -246,13 +227,10 @@ std::unique_ptr<std::vector<float>> LoadBankFromDiskTask::loadTof(::NeXus::File
   // template argument.
   auto vec = Mantid::NeXus::NeXusIOHelper::readNexusSlab<float, Mantid::NeXus::NeXusIOHelper::AllowNarrowing>(
       file, key, m_loadStart, m_loadSize);
-  file.getAttr("units", tof_unit);
+  file.getAttr("units", m_tof_unit);
   file.closeData();
-  // Convert Tof to microseconds
-  Kernel::Units::timeConversionVector(vec, tof_unit, "microseconds");
-  std::copy(vec.begin(), vec.end(), event_time_of_flight->data());
 
-  return event_time_of_flight;
+  return std::make_unique<std::vector<float>>(std::move(vec));
 }
 
 /** Load weight of weigthed events if they exist
@@ -309,12 +287,6 @@ void LoadBankFromDiskTask::run() {
 
   prog->report(entry_name + ": load from disk");
 
-  // arrays to load into
-  std::unique_ptr<std::vector<uint32_t>> event_id;
-  std::unique_ptr<std::vector<float>> event_time_of_flight;
-  std::unique_ptr<std::vector<float>> event_weight;
-  std::vector<uint64_t> event_index;
-
   // Open the file
   ::NeXus::File file(m_loader.alg->m_filename);
   try {
@@ -324,7 +296,7 @@ void LoadBankFromDiskTask::run() {
     file.openGroup(entry_name, entry_type);
 
     // Load the event_index field.
-    event_index = this->loadEventIndex(file);
+    m_event_index = this->loadEventIndex(file);
 
     if (!m_loadError) {
       // Load and validate the pulse times
@@ -332,7 +304,7 @@ void LoadBankFromDiskTask::run() {
 
       // The event_index should be the same length as the pulse times from DAS
       // logs.
-      if (event_index.size() != thisBankPulseTimes->pulseTimes.size())
+      if (m_event_index.size() != thisBankPulseTimes->pulseTimes.size())
         m_loader.alg->getLogger().warning() << "Bank " << entry_name
                                             << " has a mismatch between the number of event_index entries "
                                                "and the number of pulse times in event_time_zero.\n";
@@ -340,7 +312,7 @@ void LoadBankFromDiskTask::run() {
       // Open and validate event_id field.
       int64_t start_event = 0;
       int64_t stop_event = 0;
-      this->prepareEventId(file, start_event, stop_event, event_index);
+      this->prepareEventId(file, start_event, stop_event, m_event_index);
 
       // These are the arguments to getSlab()
       m_loadStart[0] = start_event;
@@ -348,7 +320,7 @@ void LoadBankFromDiskTask::run() {
 
       if ((m_loadSize[0] > 0) && (m_loadStart[0] >= 0)) {
         // Load pixel IDs
-        event_id = this->loadEventId(file);
+        m_event_id = this->loadEventId(file);
         if (m_loader.alg->getCancel()) {
           m_loader.alg->getLogger().error() << "Loading bank " << entry_name << " is cancelled.\n";
           m_loadError = true; // To allow cancelling the algorithm
@@ -356,9 +328,9 @@ void LoadBankFromDiskTask::run() {
 
         // And TOF.
         if (!m_loadError) {
-          event_time_of_flight = this->loadTof(file);
+          m_event_time_of_flight = this->loadTof(file);
           if (m_have_weight) {
-            event_weight = this->loadEventWeights(file);
+            m_event_weight = this->loadEventWeights(file);
           }
         }
       } // Size is at least 1
@@ -391,6 +363,43 @@ void LoadBankFromDiskTask::run() {
     return;
   }
 
+  // Everything else works on the arrays in memory. Do it in a separate task
+  // without the disk IO mutex so the next bank can be read in the meantime.
+  scheduler.push(std::make_shared<Kernel::FunctionTask>([self = shared_from_this()]() { self->decodeAndProcess(); },
+                                                        static_cast<double>(m_loadSize[0])));
+}
+
+/** Convert the arrays read from disk, work out the range of pixel IDs in this
+ * bank and schedule the ProcessBankData tasks that fill the event lists.
+ */
+void LoadBankFromDiskTask::decodeAndProcess() {
+  // Convert Tof to microseconds
+  Kernel::Units::timeConversionVector(*m_event_time_of_flight, m_tof_unit, "microseconds");
+
+  // determine the range of pixel ids
+  const auto minmax = std::minmax_element(m_event_id->cbegin(), m_event_id->cend());
+  m_min_id = *minmax.first;
+  m_max_id = *minmax.second;
+
+  if (m_min_id > static_cast<uint32_t>(m_loader.eventid_max)) {
+    // All the detector IDs in the bank are higher than the highest 'known'
+    // (from the IDF)
+    // ID. Abort the loading of the bank.
+    return;
+  }
+  // fixup the minimum pixel id in the case that it's lower than the lowest
+  // 'known' id. We test this by checking that when we add the offset we
+  // would not get a negative index into the vector. Note that m_min_id is
+  // a uint so we have to be cautious about adding it to an int which may be
+  // negative.
+  if (static_cast<int32_t>(m_min_id) + m_loader.pixelID_to_wi_offset < 0) {
+    m_min_id = static_cast<uint32_t>(abs(m_loader.pixelID_to_wi_offset));
+  }
+  // fixup the maximum pixel id in the case that it's higher than the
+  // highest 'known' id
+  if (m_max_id > static_cast<uint32_t>(m_loader.eventid_max))
+    m_max_id = static_cast<uint32_t>(m_loader.eventid_max);
+
   const auto bank_size = m_max_id - m_min_id;
   const auto minSpectraToLoad = static_cast<uint32_t>(m_loader.alg->m_specMin);
   const auto maxSpectraToLoad = static_cast<uint32_t>(m_loader.alg->m_specMax);
@@ -431,10 +440,10 @@ void LoadBankFromDiskTask::run() {
   auto startAt = static_cast<size_t>(m_loadStart[0]);
 
   // convert things to shared_arrays to share between tasks
-  std::shared_ptr<std::vector<uint32_t>> event_id_shrd(event_id.release());
-  std::shared_ptr<std::vector<float>> event_time_of_flight_shrd(event_time_of_flight.release());
-  std::shared_ptr<std::vector<float>> event_weight_shrd(event_weight.release());
-  auto event_index_shrd = std::make_shared<std::vector<uint64_t>>(std::move(event_index));
+  std::shared_ptr<std::vector<uint32_t>> event_id_shrd(m_event_id.release());
+  std::shared_ptr<std::vector<float>> event_time_of_flight_shrd(m_event_time_of_flight.release());
+  std::shared_ptr<std::vector<float>> event_weight_shrd(m_event_weight.release());
+  auto event_index_shrd = std::make_shared<std::vector<uint64_t>>(std::move(m_event_index));
 
   std::shared_ptr<Task> newTask1 = std::make_shared<ProcessBankData>(
       m_loader, entry_name, prog, event_id_shrd, event_time_of_flight_shrd, numEvents, startAt, event_index_shrd,
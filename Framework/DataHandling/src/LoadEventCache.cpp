@@ -0,0 +1,246 @@
+// Mantid Repository : https://github.com/mantidproject/mantid
+//
+// Copyright &copy; 2022 ISIS Rutherford Appleton Laboratory UKRI,
+//   NScD Oak Ridge National Laboratory, European Spallation Source,
+//   Institut Laue - Langevin & CSNS, Institute of High Energy Physics, CAS
+// SPDX - License - Identifier: GPL - 3.0 +
+#include "MantidDataHandling/LoadEventCache.h"
+#include "MantidAPI/FileProperty.h"
+#include "MantidAPI/Progress.h"
+#include "MantidAPI/RegisterFileLoader.h"
+#include "MantidAPI/WorkspaceProperty.h"
+#include "MantidDataObjects/EventWorkspace.h"
+#include "MantidDataObjects/WorkspaceCreation.h"
+#include "MantidKernel/BoundedValidator.h"
+#include "MantidKernel/Exception.h"
+#include "MantidKernel/MultiThreaded.h"
+
+#include <Poco/File.h>
+#include <Poco/TemporaryFile.h>
+
+#include <boost/interprocess/file_mapping.hpp>
+#include <boost/interprocess/mapped_region.hpp>
+
+#include <fstream>
+
+namespace Mantid::DataHandling {
+
+using namespace Mantid::API;
+using namespace Mantid::DataObjects;
+using namespace Mantid::Kernel;
+
+DECLARE_FILELOADER_ALGORITHM(LoadEventCache)
+
+namespace {
+/// Copy numberOfEvents events of the given type from the mapped file into events
+template <typename T> void assignEvents(std::vector<T> &events, const char *data, const uint64_t numberOfEvents) {
+  const auto *first = reinterpret_cast<const T *>(data);
+  events.assign(first, first + numberOfEvents);
+}
+
+/// Fill an EventList from its entry in the cache file
+void copyEvents(EventList &eventList, const EventCache::SpectrumEntry &entry, const char *data) {
+  const auto type = static_cast<API::EventType>(entry.eventType);
+  eventList.switchTo(type);
+  switch (type) {
+  case API::TOF:
+    assignEvents(eventList.getEvents(), data, entry.numberOfEvents);
+    break;
+  case API::WEIGHTED:
+    assignEvents(eventList.getWeightedEvents(), data, entry.numberOfEvents);
+    break;
+  case API::WEIGHTED_NOTIME:
+    assignEvents(eventList.getWeightedEventsNoTime(), data, entry.numberOfEvents);
+    break;
+  }
+  eventList.setSortOrder(static_cast<EventSortType>(entry.sortOrder));
+}
+
+/// Number of bytes the events of an entry occupy in the event section
+uint64_t entryBytes(const EventCache::SpectrumEntry &entry) {
+  return entry.numberOfEvents * EventCache::eventSize(static_cast<API::EventType>(entry.eventType));
+}
+
+/// True if the section [offset, offset + size) lies within a region of the given length
+bool sectionFits(const uint64_t offset, const uint64_t size, const uint64_t length) {
+  return offset <= length && size <= length - offset;
+}
+} // namespace
+
+/**
+ * Return the confidence with with this algorithm can load the file
+ * @param descriptor A descriptor for the file
+ * @returns An integer specifying the confidence level. 0 indicates it will not
+ * be used
+ */
+int LoadEventCache::confidence(Kernel::FileDescriptor &descriptor) const {
+  if (descriptor.isAscii())
+    return 0;
+  auto &file = descriptor.data();
+  std::array<char, 8> magic{};
+  file.read(magic.data(), magic.size());
+  if (file.gcount() == static_cast<std::streamsize>(magic.size()) && magic == EventCache::MAGIC)
+    return 90;
+  return 0;
+}
+
+/** Initialize the algorithm's properties.
+ */
+void LoadEventCache::init() {
+  declareProperty(std::make_unique<FileProperty>("Filename", "", FileProperty::Load, ".evcache"),
+                  "The name of the event cache file to read, as written by SaveEventCache.");
+  declareProperty(std::make_unique<WorkspaceProperty<EventWorkspace>>("OutputWorkspace", "", Direction::Output),
+                  "The name of the output workspace.");
+
+  auto mustBePositive = std::make_shared<BoundedValidator<int>>();
+  mustBePositive->setLower(1);
+  declareProperty("SpectrumMin", 1, mustBePositive, "Number of first spectrum to read.");
+  declareProperty("SpectrumMax", EMPTY_INT(), mustBePositive, "Number of last spectrum to read.");
+}
+
+/// @copydoc Algorithm::validateInputs
+std::map<std::string, std::string> LoadEventCache::validateInputs() {
+  std::map<std::string, std::string> result;
+  const int specMin = getProperty("SpectrumMin");
+  const int specMax = getProperty("SpectrumMax");
+  if (specMax != EMPTY_INT() && specMax < specMin) {
+    result["SpectrumMax"] = "SpectrumMax must not be smaller than SpectrumMin";
+  }
+  return result;
+}
+
+/** Execute the algorithm.
+ */
+void LoadEventCache::exec() {
+  const std::string filename = getPropertyValue("Filename");
+  std::ifstream file(filename, std::ios::binary);
+  if (!file)
+    throw Exception::FileError("Unable to open file", filename);
+  const auto header = readHeader(file, filename);
+  if (header.numberOfSpectra == 0)
+    throw Exception::FileError("Event cache file contains no spectra", filename);
+
+  const int specMin = getProperty("SpectrumMin");
+  if (static_cast<uint64_t>(specMin) > header.numberOfSpectra)
+    throw std::invalid_argument("SpectrumMin is larger than the number of spectra in the file (" +
+                                std::to_string(header.numberOfSpectra) + ")");
+  int specMax = getProperty("SpectrumMax");
+  if (specMax == EMPTY_INT())
+    specMax = static_cast<int>(header.numberOfSpectra);
+  if (static_cast<uint64_t>(specMax) > header.numberOfSpectra)
+    throw std::invalid_argument("SpectrumMax is larger than the number of spectra in the file (" +
+                                std::to_string(header.numberOfSpectra) + ")");
+  const auto firstIndex = static_cast<uint64_t>(specMin - 1);
+  const auto numberOfSpectra = static_cast<size_t>(specMax - specMin + 1);
+
+  std::vector<EventCache::SpectrumEntry> table(numberOfSpectra);
+  file.seekg(static_cast<std::streamoff>(header.tableOffset + firstIndex * sizeof(EventCache::SpectrumEntry)));
+  file.read(reinterpret_cast<char *>(table.data()),
+            static_cast<std::streamsize>(numberOfSpectra * sizeof(EventCache::SpectrumEntry)));
+  if (!file)
+    throw Exception::FileError("Unable to read the spectrum table from", filename);
+  // Entries must be in order and lie within the event section so that every
+  // list is inside the mapped region below.
+  uint64_t previousEnd = table.front().offset;
+  for (const auto &entry : table) {
+    if (entry.eventType > API::WEIGHTED_NOTIME)
+      throw Exception::FileError("Corrupt spectrum table in", filename);
+    const auto maxEvents = header.eventsSize / EventCache::eventSize(static_cast<API::EventType>(entry.eventType));
+    if (entry.numberOfEvents > maxEvents || entry.offset < previousEnd ||
+        !sectionFits(entry.offset, entryBytes(entry), header.eventsSize))
+      throw Exception::FileError("Corrupt spectrum table in", filename);
+    previousEnd = entry.offset + entryBytes(entry);
+  }
+
+  MatrixWorkspace_sptr metadataWS = loadMetadata(file, header);
+  if (!metadataWS || metadataWS->getNumberHistograms() != numberOfSpectra)
+    throw Exception::FileError("Metadata does not match the spectrum table in", filename);
+  EventWorkspace_sptr outputWS = create<EventWorkspace>(*metadataWS);
+  metadataWS.reset();
+
+  // Map only the part of the event section holding the requested spectra.
+  // Pages are faulted in as each list is filled, so untouched spectra cost
+  // nothing.
+  const uint64_t begin = table.front().offset;
+  const uint64_t end = table.back().offset + entryBytes(table.back());
+  if (end > begin) {
+    using namespace boost::interprocess;
+    const file_mapping mapping(filename.c_str(), read_only);
+    const mapped_region region(mapping, read_only, static_cast<offset_t>(header.eventsOffset + begin),
+                               static_cast<std::size_t>(end - begin));
+    const auto *events = static_cast<const char *>(region.get_address());
+
+    Progress progress(this, 0.5, 1.0, numberOfSpectra);
+    PARALLEL_FOR_IF(Kernel::threadSafe(*outputWS))
+    for (int64_t i = 0; i < static_cast<int64_t>(numberOfSpectra); ++i) {
+      PARALLEL_START_INTERRUPT_REGION
+      const auto &entry = table[i];
+      copyEvents(outputWS->getSpectrum(i), entry, events + (entry.offset - begin));
+      progress.report();
+      PARALLEL_END_INTERRUPT_REGION
+    }
+    PARALLEL_CHECK_INTERRUPT_REGION
+  }
+
+  setProperty("OutputWorkspace", outputWS);
+}
+
+/** Read and check the file header
+ * @param file :: The open cache file
+ * @param filename :: The name of the file, for error messages
+ * @returns The file header
+ */
+EventCache::FileHeader LoadEventCache::readHeader(std::ifstream &file, const std::string &filename) const {
+  EventCache::FileHeader header{};
+  file.read(reinterpret_cast<char *>(&header), sizeof(header));
+  if (!file || header.magic != EventCache::MAGIC)
+    throw Exception::FileError("Not an event cache file", filename);
+  if (header.byteOrderMark != EventCache::BYTE_ORDER_MARK)
+    throw Exception::FileError("Event cache file was written on a machine with a different byte order", filename);
+  if (header.version != EventCache::VERSION)
+    throw Exception::FileError("Unsupported event cache version " + std::to_string(header.version) + " in", filename);
+
+  // The event section is memory mapped, so a truncated file would fault on
+  // access rather than fail a read. Check every section lies within the file.
+  const uint64_t fileSize = Poco::File(filename).getSize();
+  const uint64_t maxSpectra = fileSize / sizeof(EventCache::SpectrumEntry);
+  if (header.numberOfSpectra > maxSpectra ||
+      !sectionFits(header.tableOffset, header.numberOfSpectra * sizeof(EventCache::SpectrumEntry), fileSize) ||
+      !sectionFits(header.metadataOffset, header.metadataSize, fileSize) ||
+      !sectionFits(header.eventsOffset, header.eventsSize, fileSize))
+    throw Exception::FileError("Event cache file is truncated or corrupt", filename);
+  return header;
+}
+
+/** Extract the embedded processed NeXus file and load it. This gives a
+ * workspace with the instrument, logs, spectrum numbers, detector IDs and
+ * binning of the requested spectra but without events.
+ * @param file :: The open cache file
+ * @param header :: The header of the cache file
+ * @returns The metadata workspace
+ */
+MatrixWorkspace_sptr LoadEventCache::loadMetadata(std::ifstream &file, const EventCache::FileHeader &header) {
+  const std::string metadataFilename = Poco::TemporaryFile::tempName();
+  Poco::TemporaryFile::registerForDeletion(metadataFilename);
+  {
+    std::vector<char> buffer(header.metadataSize);
+    file.seekg(static_cast<std::streamoff>(header.metadataOffset));
+    file.read(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+    if (!file)
+      throw Exception::FileError("Unable to read the metadata from", getPropertyValue("Filename"));
+    std::ofstream metadata(metadataFilename, std::ios::binary);
+    metadata.write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+  }
+
+  auto loader = createChildAlgorithm("LoadNexusProcessed", 0.0, 0.5);
+  loader->setPropertyValue("Filename", metadataFilename);
+  loader->setProperty("SpectrumMin", static_cast<int>(getProperty("SpectrumMin")));
+  loader->setProperty("SpectrumMax", static_cast<int>(getProperty("SpectrumMax")));
+  loader->setProperty("LoadHistory", false);
+  loader->executeAsChildAlg();
+  Workspace_sptr metadataWS = loader->getProperty("OutputWorkspace");
+  Poco::File(metadataFilename).remove();
+  return std::dynamic_pointer_cast<MatrixWorkspace>(metadataWS);
+}
+
+} // namespace Mantid::DataHandling
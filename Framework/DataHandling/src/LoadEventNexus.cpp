@@ -18,6 +18,7 @@
 #include "MantidDataHandling/LoadHelper.h"
 #include "MantidDataHandling/ParallelEventLoader.h"
 #include "MantidDataObjects/EventWorkspace.h"
+#include "MantidDataObjects/WorkspaceCreation.h"
 #include "MantidGeometry/Instrument.h"
 #include "MantidGeometry/Instrument/Goniometer.h"
 #include "MantidGeometry/Instrument/RectangularDetector.h"
@@ -57,6 +58,9 @@ using Types::Core::DateAndTime;
 namespace {
 // detnotes the end of iteration for NeXus::getNextEntry
 const std::string NULL_STR("NULL");
+// Estimated memory per loaded event, the same estimate DetermineChunking uses
+constexpr double BYTES_PER_EVENT = 48.;
+constexpr double BYTES_TO_GiB = 1. / 1024. / 1024. / 1024.;
 } // namespace
 
 /**
@@ -187,11 +191,32 @@ void LoadEventNexus::init() {
   // validation
   setPropertySettings("TotalChunks", std::make_unique<VisibleWhenProperty>("ChunkNumber", IS_NOT_DEFAULT));
 
+  auto mustBePositiveDbl = std::make_shared<BoundedValidator<double>>();
+  mustBePositiveDbl->setLower(0.);
+  mustBePositiveDbl->setLowerExclusive(true);
+  declareProperty("MaxChunkSize", EMPTY_DBL(), mustBePositiveDbl,
+                  "Load the file in chunks that each need no more than this many GiB of memory. "
+                  "The file, instrument and logs are only read once and each chunk is reduced by "
+                  "ChunkProcessingAlgorithm before the results are summed.");
+  declareProperty("ChunkProcessingAlgorithm", "",
+                  "Name of an algorithm with InputWorkspace and OutputWorkspace properties that "
+                  "reduces every chunk, e.g. CompressEvents or AlignAndFocusPowder. Required with MaxChunkSize.");
+  declareProperty("ChunkProcessingProperties", "",
+                  "Optional: other properties of ChunkProcessingAlgorithm as a list of "
+                  "name=value pairs separated by semicolons.");
+  setPropertySettings("ChunkProcessingAlgorithm",
+                      std::make_unique<VisibleWhenProperty>("MaxChunkSize", IS_NOT_DEFAULT));
+  setPropertySettings("ChunkProcessingProperties",
+                      std::make_unique<VisibleWhenProperty>("MaxChunkSize", IS_NOT_DEFAULT));
+
   std::string grp3 = "Reduce Memory Use";
   setPropertyGroup("Precount", grp3);
   setPropertyGroup("CompressTolerance", grp3);
   setPropertyGroup("ChunkNumber", grp3);
   setPropertyGroup("TotalChunks", grp3);
+  setPropertyGroup("MaxChunkSize", grp3);
+  setPropertyGroup("ChunkProcessingAlgorithm", grp3);
+  setPropertyGroup("ChunkProcessingProperties", grp3);
 
   declareProperty(std::make_unique<PropertyWithValue<bool>>("LoadMonitors", false, Direction::Input),
                   "Load the monitors from the file (optional, default False).");
@@ -415,6 +440,7 @@ void LoadEventNexus::execLoader() {
   m_ws = std::make_shared<EventWorkspaceCollection>(); // Algorithm currently
                                                        // relies on an
   // object-level workspace ptr
+  m_chunkedOutput.reset();
   loadEvents(&prog, false); // Do not load monitor blocks
 
   if (discarded_events > 0) {
@@ -424,14 +450,20 @@ void LoadEventNexus::execLoader() {
                            "These events were discarded.\n";
   }
 
-  // If the run was paused at any point, filter out those events (SNS only, I
-  // think)
-  filterDuringPause(m_ws->getSingleHeldWorkspace());
-
-  // add filename
-  m_ws->mutableRun().addProperty("Filename", m_filename);
-  // Save output
-  this->setProperty("OutputWorkspace", m_ws->combinedWorkspace());
+  if (m_chunkedOutput) {
+    // Chunks have already been filtered and processed one at a time
+    m_chunkedOutput->mutableRun().addProperty("Filename", m_filename, true);
+    this->setProperty("OutputWorkspace", std::static_pointer_cast<Workspace>(m_chunkedOutput));
+  } else {
+    // If the run was paused at any point, filter out those events (SNS only, I
+    // think)
+    filterDuringPause(m_ws->getSingleHeldWorkspace());
+
+    // add filename
+    m_ws->mutableRun().addProperty("Filename", m_filename);
+    // Save output
+    this->setProperty("OutputWorkspace", m_ws->combinedWorkspace());
+  }
 
   // close the file since LoadNexusMonitors will take care of its own file
   // handle
@@ -1112,6 +1144,13 @@ void LoadEventNexus::loadEvents(API::Progress *const prog, const bool monitors)
   shortest_tof = static_cast<double>(std::numeric_limits<uint32_t>::max()) * 0.1;
   longest_tof = 0.;
 
+  const double maxChunkSize = getProperty("MaxChunkSize");
+  if (!monitors && !isEmpty(maxChunkSize)) {
+    loadEventsInChunks(maxChunkSize, haveWeights, bankNames, bankNumEvents, periodLog->valuesAsVector(), classType,
+                       oldNeXusFileNames, descriptor.get(), is_time_filtered);
+    return;
+  }
+
   bool loaded{false};
   auto loaderType = defineLoaderType(haveWeights, oldNeXusFileNames, classType);
   if (loaderType != LoaderType::DEFAULT) {
@@ -1165,6 +1204,18 @@ void LoadEventNexus::loadEvents(API::Progress *const prog, const bool monitors)
                              classType, bankNumEvents, oldNeXusFileNames, precount, chunk, totalChunks);
   }
 
+  finishLoadingEvents(classType, descriptor.get(), is_time_filtered);
+}
+
+/**
+ * Apply the corrections and filters that need all the events of the banks
+ * that were loaded into m_ws, and set up the default binning.
+ * @param classType :: NXevent_data or NXmonitor
+ * @param descriptor :: descriptor of the file being loaded
+ * @param is_time_filtered :: whether to filter the events by pulse time
+ */
+void LoadEventNexus::finishLoadingEvents(const std::string &classType, const NexusHDF5Descriptor *descriptor,
+                                         const bool is_time_filtered) {
   // Info reporting
   const std::size_t eventsLoaded = m_ws->getNumberEvents();
   g_log.information() << "Read " << eventsLoaded << " events"
@@ -1202,21 +1253,10 @@ void LoadEventNexus::loadEvents(API::Progress *const prog, const bool monitors)
     }
   }
   // Now, create a default X-vector for histogramming, with just 2 bins.
-  if (eventsLoaded > 0) {
-    int nBins = getProperty("NumberOfBins");
-    auto binEdgesVec = std::vector<double>(nBins + 1);
-    binEdgesVec[0] = shortest_tof - 1;
-    binEdgesVec[nBins] = longest_tof + 1;
-    double binStep = (binEdgesVec[nBins] - binEdgesVec[0]) / nBins;
-    for (int binIndex = 1; binIndex < nBins; binIndex++) {
-      binEdgesVec[binIndex] = binEdgesVec[0] + (binStep * binIndex);
-    }
-    m_ws->setAllX(HistogramData::BinEdges{binEdgesVec});
-  } else
-    m_ws->setAllX(HistogramData::BinEdges{0.0, 1.0});
+  m_ws->setAllX(defaultBinEdges(eventsLoaded));
 
   // if there is time_of_flight load it
-  adjustTimeOfFlightISISLegacy(*m_file, m_ws, m_top_entry_name, classType, descriptor.get());
+  adjustTimeOfFlightISISLegacy(*m_file, m_ws, m_top_entry_name, classType, descriptor);
 
   if (is_time_filtered) {
     // Now filter out the run and events, using the DateAndTime type.
@@ -1225,6 +1265,144 @@ void LoadEventNexus::loadEvents(API::Progress *const prog, const bool monitors)
   }
 }
 
+/**
+ * The default binning of the output, NumberOfBins bins spanning the range of
+ * time-of-flight found while loading.
+ * @param eventsLoaded :: number of events in the workspace
+ * @return the bin edges
+ */
+HistogramData::BinEdges LoadEventNexus::defaultBinEdges(const std::size_t eventsLoaded) {
+  if (eventsLoaded == 0)
+    return HistogramData::BinEdges{0.0, 1.0};
+  int nBins = getProperty("NumberOfBins");
+  auto binEdgesVec = std::vector<double>(nBins + 1);
+  binEdgesVec[0] = shortest_tof - 1;
+  binEdgesVec[nBins] = longest_tof + 1;
+  double binStep = (binEdgesVec[nBins] - binEdgesVec[0]) / nBins;
+  for (int binIndex = 1; binIndex < nBins; binIndex++) {
+    binEdgesVec[binIndex] = binEdgesVec[0] + (binStep * binIndex);
+  }
+  return HistogramData::BinEdges{binEdgesVec};
+}
+
+/**
+ * Load the events in chunks that each fit in maxChunkSize GiB. The file
+ * header, instrument, logs and spectrum mapping already in m_ws are reused for
+ * every chunk. Each chunk is filtered, reduced by the chunk processor or
+ * ChunkProcessingAlgorithm and summed into m_chunkedOutput, so the raw events
+ * of only one chunk are held in memory at a time alongside the reduced sum.
+ * @param maxChunkSize :: memory budget of a chunk in GiB
+ * @param haveWeights :: flag to check if the events have weights
+ * @param bankNames :: names of the banks to load
+ * @param bankNumEvents :: number of events in each bank
+ * @param periodLog :: period of each pulse
+ * @param classType :: NXevent_data or NXmonitor
+ * @param oldNeXusFileNames :: whether the file uses the old field names
+ * @param descriptor :: descriptor of the file being loaded
+ * @param is_time_filtered :: whether to filter the events by pulse time
+ */
+void LoadEventNexus::loadEventsInChunks(const double maxChunkSize, const bool haveWeights,
+                                        const std::vector<std::string> &bankNames,
+                                        const std::vector<std::size_t> &bankNumEvents,
+                                        const std::vector<int> &periodLog, const std::string &classType,
+                                        const bool oldNeXusFileNames, const NexusHDF5Descriptor *descriptor,
+                                        const bool is_time_filtered) {
+  const int chunkNumber = getProperty("ChunkNumber");
+  if (!isEmpty(chunkNumber))
+    throw std::invalid_argument("MaxChunkSize cannot be combined with ChunkNumber and TotalChunks");
+  if (m_ws->nPeriods() > 1)
+    throw std::invalid_argument("MaxChunkSize is not supported for multi-period data");
+  // Summing unreduced chunks would hold every event of the file by the end
+  if (!m_chunkProcessor && getPropertyValue("ChunkProcessingAlgorithm").empty())
+    throw std::invalid_argument("MaxChunkSize needs a ChunkProcessingAlgorithm to reduce each chunk");
+
+  const auto totalEvents = std::accumulate(bankNumEvents.cbegin(), bankNumEvents.cend(), std::size_t{0});
+  const double wkspSizeGiB = static_cast<double>(totalEvents) * BYTES_PER_EVENT * BYTES_TO_GiB;
+  const int totalChunks = static_cast<int>(wkspSizeGiB / maxChunkSize) + 1;
+  g_log.information() << "Loading " << totalEvents << " events in " << totalChunks << " chunks\n";
+
+  // Every chunk starts from an empty copy of the workspace with the
+  // instrument, logs and spectrum mapping set up
+  const EventWorkspace_sptr chunkTemplate = create<EventWorkspace>(*m_ws->getSingleHeldWorkspace());
+  const bool precount = getProperty("Precount");
+
+  m_chunkedOutput.reset();
+  for (int chunk = 1; chunk <= totalChunks; ++chunk) {
+    if (chunk > 1) {
+      m_ws->applyFilter([&chunkTemplate](const EventWorkspace_sptr &) {
+        EventWorkspace_sptr ws = create<EventWorkspace>(*chunkTemplate);
+        for (size_t i = 0; i < ws->getNumberHistograms(); i++)
+          ws->getSpectrum(i).setSortOrder(DataObjects::PULSETIME_SORT);
+        return ws;
+      });
+    }
+
+    if (totalChunks > 1)
+      DefaultEventLoader::load(this, *m_ws, haveWeights, event_id_is_spec, bankNames, periodLog, classType,
+                               bankNumEvents, oldNeXusFileNames, precount, chunk, totalChunks);
+    else
+      DefaultEventLoader::load(this, *m_ws, haveWeights, event_id_is_spec, bankNames, periodLog, classType,
+                               bankNumEvents, oldNeXusFileNames, precount, EMPTY_INT(), EMPTY_INT());
+
+    finishLoadingEvents(classType, descriptor, is_time_filtered);
+    filterDuringPause(m_ws->getSingleHeldWorkspace());
+
+    const double progStart = static_cast<double>(chunk - 1) / totalChunks;
+    const double progEnd = static_cast<double>(chunk) / totalChunks;
+    auto result = processChunk(m_ws->getSingleHeldWorkspace(), progStart, progEnd);
+
+    if (!m_chunkedOutput) {
+      m_chunkedOutput = result;
+    } else {
+      auto removeLogsAlg = createChildAlgorithm("RemoveLogs");
+      removeLogsAlg->setProperty("Workspace", result);
+      removeLogsAlg->executeAsChildAlg();
+      result = removeLogsAlg->getProperty("Workspace");
+
+      auto plusAlg = createChildAlgorithm("Plus");
+      plusAlg->setProperty("LHSWorkspace", m_chunkedOutput);
+      plusAlg->setProperty("RHSWorkspace", result);
+      plusAlg->setProperty("OutputWorkspace", m_chunkedOutput);
+      plusAlg->setProperty("ClearRHSWorkspace", true);
+      plusAlg->executeAsChildAlg();
+      m_chunkedOutput = plusAlg->getProperty("OutputWorkspace");
+    }
+  }
+
+  // Release the last raw chunk, the collection only holds a placeholder from here
+  m_ws->applyFilter([&chunkTemplate](const EventWorkspace_sptr &) { return chunkTemplate; });
+
+  // The binning of each chunk only covered the events seen so far
+  if (auto eventWS = std::dynamic_pointer_cast<EventWorkspace>(m_chunkedOutput))
+    eventWS->setAllX(defaultBinEdges(eventWS->getNumberEvents()));
+}
+
+/**
+ * Run the chunk processor, or ChunkProcessingAlgorithm if no processor was
+ * set, on a chunk of loaded events.
+ * @param chunkWS :: the events of one chunk
+ * @param progStart :: start of the progress range of the child algorithm
+ * @param progEnd :: end of the progress range of the child algorithm
+ * @return the processed chunk
+ */
+API::MatrixWorkspace_sptr LoadEventNexus::processChunk(const API::MatrixWorkspace_sptr &chunkWS,
+                                                       const double progStart, const double progEnd) {
+  if (m_chunkProcessor)
+    return m_chunkProcessor(chunkWS);
+
+  const std::string algName = getPropertyValue("ChunkProcessingAlgorithm");
+  auto alg = createChildAlgorithm(algName, progStart, progEnd);
+  alg->setPropertiesWithString(getPropertyValue("ChunkProcessingProperties"), {"InputWorkspace", "OutputWorkspace"});
+  alg->setProperty("InputWorkspace", chunkWS);
+  alg->setProperty("OutputWorkspace", chunkWS);
+  alg->executeAsChildAlg();
+  Workspace_sptr result = alg->getProperty("OutputWorkspace");
+  auto matrixResult = std::dynamic_pointer_cast<MatrixWorkspace>(result);
+  if (!matrixResult)
+    throw std::runtime_error(algName + " did not produce a MatrixWorkspace from a chunk");
+  return matrixResult;
+}
+
 //-----------------------------------------------------------------------------
 /** Load the instrument from the nexus file
  *
@@ -1443,7 +1621,10 @@ void LoadEventNexus::runLoadMonitors() {
   MatrixWorkspace_sptr mons = std::dynamic_pointer_cast<MatrixWorkspace>(monsOut);
   if (mons) {
     // Set the internal monitor workspace pointer as well
-    m_ws->setMonitorWorkspace(mons);
+    if (m_chunkedOutput)
+      m_chunkedOutput->setMonitorWorkspace(mons);
+    else
+      m_ws->setMonitorWorkspace(mons);
 
     filterDuringPause(mons);
   } else {
@@ -4,6 +4,8 @@
 //   NScD Oak Ridge National Laboratory, European Spallation Source,
 //   Institut Laue - Langevin & CSNS, Institute of High Energy Physics, CAS
 // SPDX - License - Identifier: GPL - 3.0 +
+#include <unordered_map>
+#include <unordered_set>
 #include <utility>
 
 #include "MantidDataHandling/DefaultEventLoader.h"
@@ -54,6 +56,9 @@ inline size_t getPulseIndex(const size_t event_index, const size_t last_pulse_in
   }
   return std::distance(event_index_vec->cbegin(), event_index_iter);
 }
+
+/// Most raw events of a bank held at once while compressing
+constexpr size_t MAX_EVENTS_PER_COMPRESS_PASS = size_t{1} << 23;
 } // namespace
 
 /** Run the data processing
@@ -71,19 +76,47 @@ void ProcessBankData::run() { // override {
   // ---- Pre-counting events per pixel ID ----
   auto &outputWS = m_loader.m_ws;
   auto *alg = m_loader.alg;
-  if (m_loader.precount) {
+  // Will we need to compress?
+  const bool compress = (alg->compressTolerance >= 0);
 
-    std::vector<size_t> counts(m_max_id - m_min_id + 1, 0);
+  // The number of events of each pixel is also needed to split the pixels
+  // into passes when compressing
+  std::vector<size_t> counts;
+  if (m_loader.precount || compress) {
+    counts.assign(m_max_id - m_min_id + 1, 0);
     for (size_t i = 0; i < numEvents; i++) {
       const auto thisId = detid_t((*event_id)[i]);
       if (thisId >= m_min_id && thisId <= m_max_id)
         counts[thisId - m_min_id]++;
     }
+  }
 
-    // Now we pre-allocate (reserve) the vectors of events in each pixel
-    // counted
-    const size_t numEventLists = outputWS.getNumberHistograms();
+  // Compressing a pixel needs all of its raw events, but holding the raw
+  // events of the whole bank at once defeats the point of compressing. The
+  // pixels are instead filled and compressed in ranges holding a bounded
+  // number of events.
+  std::vector<std::pair<detid_t, detid_t>> pixelRanges;
+  if (compress && numEvents <= std::numeric_limits<uint32_t>::max()) {
+    detid_t first = m_min_id;
+    size_t eventsInRange = 0;
     for (detid_t pixID = m_min_id; pixID <= m_max_id; ++pixID) {
+      const size_t count = counts[pixID - m_min_id];
+      if (pixID > first && eventsInRange + count > MAX_EVENTS_PER_COMPRESS_PASS) {
+        pixelRanges.emplace_back(first, pixID - 1);
+        first = pixID;
+        eventsInRange = 0;
+      }
+      eventsInRange += count;
+    }
+    pixelRanges.emplace_back(first, m_max_id);
+  } else {
+    pixelRanges.emplace_back(m_min_id, m_max_id);
+  }
+
+  const size_t numEventLists = outputWS.getNumberHistograms();
+  // Pre-allocate (reserve) the vectors of events in each pixel counted
+  auto reserveEventLists = [&](const detid_t first, const detid_t last) {
+    for (detid_t pixID = first; pixID <= last; ++pixID) {
       if (counts[pixID - m_min_id] > 0) {
         size_t wi = getWorkspaceIndexFromPixelID(pixID);
         // Find the the workspace index corresponding to that pixel ID
@@ -92,10 +125,13 @@ void ProcessBankData::run() { // override {
           outputWS.reserveEventListAt(wi, counts[pixID - m_min_id]);
         }
         if (alg->getCancel())
-          return; // User cancellation
+          return false; // User cancellation
       }
     }
-  }
+    return true;
+  };
+  if (m_loader.precount && !compress && !reserveEventLists(m_min_id, m_max_id))
+    return;
 
   // Default pulse time (if none are found)
   const bool pulsetimesincreasing =
@@ -107,9 +143,6 @@ void ProcessBankData::run() { // override {
   const auto NUM_PULSES = thisBankPulseTimes->pulseTimes.size();
   prog->report(entry_name + ": filling events");
 
-  // Will we need to compress?
-  const bool compress = (alg->compressTolerance >= 0);
-
   // Which detector IDs were touched?
   std::vector<bool> usedDetIds;
   usedDetIds.assign(m_max_id - m_min_id + 1, false);
@@ -117,95 +150,178 @@ void ProcessBankData::run() { // override {
   const double TOF_MIN = alg->filter_tof_min;
   const double TOF_MAX = alg->filter_tof_max;
 
-  for (std::size_t pulseIndex = getPulseIndex(startAt, 0, event_index); pulseIndex < NUM_PULSES; pulseIndex++) {
+  // Calls visit(pulseIndex, eventIndex) for each event in file order. Returns
+  // false if the user cancelled.
+  auto forEachEvent = [&](const auto &visit) {
+    for (std::size_t pulseIndex = getPulseIndex(startAt, 0, event_index); pulseIndex < NUM_PULSES; pulseIndex++) {
+      const auto firstEventIndex = getFirstEventIndex(pulseIndex);
+      if (firstEventIndex > numEvents)
+        break;
+
+      const auto lastEventIndex = getLastEventIndex(pulseIndex, NUM_PULSES);
+      if (firstEventIndex == lastEventIndex)
+        continue;
+      else if (firstEventIndex > lastEventIndex) {
+        std::stringstream msg;
+        msg << "Something went really wrong: " << firstEventIndex << " > " << lastEventIndex << "| " << entry_name
+            << " startAt=" << startAt << " numEvents=" << event_index->size() << " RAWINDICES=["
+            << firstEventIndex + startAt << ",?)"
+            << " pulseIndex=" << pulseIndex << " of " << event_index->size();
+        throw std::runtime_error(msg.str());
+      }
+
+      for (std::size_t eventIndex = firstEventIndex; eventIndex < lastEventIndex; ++eventIndex)
+        visit(pulseIndex, eventIndex);
+      // check if cancelled after each pulse
+      if (alg->getCancel())
+        return false;
+    }
+    return true;
+  };
+
+  // Add one event to the event list of its pixel
+  auto addEvent = [&](const std::size_t pulseIndex, const std::size_t eventIndex) {
+    // We cached a pointer to the vector<tofEvent> -> so retrieve it and add
+    // the event
+    const detid_t detId = (*event_id)[eventIndex];
+    if (detId < m_min_id || detId > m_max_id)
+      return;
+    // Create the tofevent
+    const auto tof = static_cast<double>((*event_time_of_flight)[eventIndex]);
+    // this is fancy for check if value is in range
+    if ((tof - TOF_MIN) * (tof - TOF_MAX) > 0.)
+      return;
     // Save the pulse time at this index for creating those events
     const auto pulsetime = thisBankPulseTimes->pulseTimes[pulseIndex];
-    const int logPeriodNumber = thisBankPulseTimes->periodNumbers[pulseIndex];
-    const int periodIndex = logPeriodNumber - 1;
+    const int periodIndex = thisBankPulseTimes->periodNumbers[pulseIndex] - 1;
+
+    // Handle simulated data if present
+    if (have_weight) {
+      auto *eventVector = m_loader.weightedEventVectors[periodIndex][detId];
+      // NULL eventVector indicates a bad spectrum lookup
+      if (eventVector) {
+        const auto weight = static_cast<double>((*event_weight)[eventIndex]);
+        const double errorSq = weight * weight;
+        eventVector->emplace_back(tof, pulsetime, weight, errorSq);
+      } else {
+        ++my_discarded_events;
+      }
+    } else {
+      // We have cached the vector of events for this detector ID
+      auto *eventVector = m_loader.eventVectors[periodIndex][detId];
+      // NULL eventVector indicates a bad spectrum lookup
+      if (eventVector) {
+        eventVector->emplace_back(tof, pulsetime);
+      } else {
+        ++my_discarded_events;
+      }
+    }
 
-    const auto firstEventIndex = getFirstEventIndex(pulseIndex);
-    if (firstEventIndex > numEvents)
-      break;
+    // Skip any events that are the cause of bad DAS data (e.g. a negative
+    // number in uint32 -> 2.4 billion * 100 nanosec = 2.4e8 microsec)
+    if (tof < 2e8) {
+      // tof limits from things observed here
+      if (tof > my_longest_tof) {
+        my_longest_tof = tof;
+      }
+      if (tof < my_shortest_tof) {
+        my_shortest_tof = tof;
+      }
+    } else
+      badTofs++;
+
+    // Track all the touched wi
+    usedDetIds[detId - m_min_id] = true;
+  };
+
+  // With more than one range, sort the events by range in a single pass, so
+  // that filling a range only visits its own events
+  std::vector<uint32_t> eventsByRange;
+  std::vector<size_t> rangeEnd;
+  if (pixelRanges.size() > 1) {
+    std::vector<size_t> rangeOfPixel(counts.size());
+    rangeEnd.assign(pixelRanges.size(), 0);
+    size_t rangeStart = 0;
+    for (size_t range = 0; range < pixelRanges.size(); ++range) {
+      rangeEnd[range] = rangeStart;
+      for (detid_t pixID = pixelRanges[range].first; pixID <= pixelRanges[range].second; ++pixID) {
+        rangeOfPixel[pixID - m_min_id] = range;
+        rangeStart += counts[pixID - m_min_id];
+      }
+    }
+    eventsByRange.resize(rangeStart);
+    const bool sorted = forEachEvent([&](const std::size_t, const std::size_t eventIndex) {
+      const detid_t detId = (*event_id)[eventIndex];
+      if (detId >= m_min_id && detId <= m_max_id)
+        eventsByRange[rangeEnd[rangeOfPixel[detId - m_min_id]]++] = static_cast<uint32_t>(eventIndex);
+    });
+    if (!sorted)
+      return;
+  }
 
-    const auto lastEventIndex = getLastEventIndex(pulseIndex, NUM_PULSES);
-    if (firstEventIndex == lastEventIndex)
-      continue;
-    else if (firstEventIndex > lastEventIndex) {
-      std::stringstream msg;
-      msg << "Something went really wrong: " << firstEventIndex << " > " << lastEventIndex << "| " << entry_name
-          << " startAt=" << startAt << " numEvents=" << event_index->size() << " RAWINDICES=["
-          << firstEventIndex + startAt << ",?)"
-          << " pulseIndex=" << pulseIndex << " of " << event_index->size();
-      throw std::runtime_error(msg.str());
+  // A workspace index may be fed by several pixels in different ranges. It is
+  // compressed once the range holding the last of its pixels is filled.
+  std::unordered_map<size_t, detid_t> lastPixelOfIndex;
+  std::unordered_set<size_t> usedIndices;
+  if (compress) {
+    for (detid_t pixID = m_min_id; pixID <= m_max_id; ++pixID) {
+      if (counts[pixID - m_min_id] > 0)
+        lastPixelOfIndex[getWorkspaceIndexFromPixelID(pixID)] = pixID;
     }
+  }
 
-    for (std::size_t eventIndex = firstEventIndex; eventIndex < lastEventIndex; ++eventIndex) {
-      // We cached a pointer to the vector<tofEvent> -> so retrieve it and add
-      // the event
-      const detid_t detId = (*event_id)[eventIndex];
-      if (detId >= m_min_id && detId <= m_max_id) {
-        // Create the tofevent
-        const auto tof = static_cast<double>((*event_time_of_flight)[eventIndex]);
-        // this is fancy for check if value is in range
-        if ((tof - TOF_MIN) * (tof - TOF_MAX) <= 0.) {
-          // Handle simulated data if present
-          if (have_weight) {
-            auto *eventVector = m_loader.weightedEventVectors[periodIndex][detId];
-            // NULL eventVector indicates a bad spectrum lookup
-            if (eventVector) {
-              const auto weight = static_cast<double>((*event_weight)[eventIndex]);
-              const double errorSq = weight * weight;
-              eventVector->emplace_back(tof, pulsetime, weight, errorSq);
-            } else {
-              ++my_discarded_events;
-            }
-          } else {
-            // We have cached the vector of events for this detector ID
-            auto *eventVector = m_loader.eventVectors[periodIndex][detId];
-            // NULL eventVector indicates a bad spectrum lookup
-            if (eventVector) {
-              eventVector->emplace_back(tof, pulsetime);
-            } else {
-              ++my_discarded_events;
-            }
-          }
-
-          // Skip any events that are the cause of bad DAS data (e.g. a negative
-          // number in uint32 -> 2.4 billion * 100 nanosec = 2.4e8 microsec)
-          if (tof < 2e8) {
-            // tof limits from things observed here
-            if (tof > my_longest_tof) {
-              my_longest_tof = tof;
-            }
-            if (tof < my_shortest_tof) {
-              my_shortest_tof = tof;
-            }
-          } else
-            badTofs++;
-
-          // Track all the touched wi
-          usedDetIds[detId - m_min_id] = true;
-        } // valid time-of-flight
-
-      } // valid detector IDs
-    }   // for events in pulse
-    // check if cancelled after each pulse
-    if (alg->getCancel())
+  for (size_t range = 0; range < pixelRanges.size(); ++range) {
+    const detid_t firstId = pixelRanges[range].first;
+    const detid_t lastId = pixelRanges[range].second;
+    if (m_loader.precount && compress && !reserveEventLists(firstId, lastId))
       return;
-  } // for pulses
 
-  //------------ Compress Events (or set sort order) ------------------
-  // Do it on all the detector IDs we touched
-  const size_t numEventLists = outputWS.getNumberHistograms();
-  for (detid_t pixID = m_min_id; pixID <= m_max_id; ++pixID) {
-    if (usedDetIds[pixID - m_min_id]) {
-      // Find the the workspace index corresponding to that pixel ID
-      size_t wi = getWorkspaceIndexFromPixelID(pixID);
-      if (wi < numEventLists) {
-        auto &el = outputWS.getSpectrum(wi);
-        if (compress)
+    if (pixelRanges.size() == 1) {
+      if (!forEachEvent(addEvent))
+        return;
+    } else {
+      // The events of a range are in file order, so the pulse only moves forward
+      size_t pulseIndex = getPulseIndex(startAt, 0, event_index);
+      const size_t rangeBegin = range == 0 ? 0 : rangeEnd[range - 1];
+      for (size_t i = rangeBegin; i < rangeEnd[range]; ++i) {
+        const size_t eventIndex = eventsByRange[i];
+        while (eventIndex >= getLastEventIndex(pulseIndex, NUM_PULSES))
+          ++pulseIndex;
+        addEvent(pulseIndex, eventIndex);
+      }
+      if (alg->getCancel())
+        return;
+    }
+
+    //------------ Compress Events ------------------
+    // Do it on the workspace indices whose last pixel is in this range
+    if (compress) {
+      for (detid_t pixID = firstId; pixID <= lastId; ++pixID) {
+        if (usedDetIds[pixID - m_min_id])
+          usedIndices.insert(getWorkspaceIndexFromPixelID(pixID));
+      }
+      for (detid_t pixID = firstId; pixID <= lastId; ++pixID) {
+        if (counts[pixID - m_min_id] == 0)
+          continue;
+        // Find the the workspace index corresponding to that pixel ID
+        size_t wi = getWorkspaceIndexFromPixelID(pixID);
+        if (wi < numEventLists && lastPixelOfIndex[wi] == pixID && usedIndices.count(wi) > 0) {
+          auto &el = outputWS.getSpectrum(wi);
           el.compressEvents(alg->compressTolerance, &el);
-        else {
+        }
+      }
+    }
+  } // for pixel ranges
+
+  //------------ Set sort order ------------------
+  // Do it on all the detector IDs we touched
+  if (!compress) {
+    for (detid_t pixID = m_min_id; pixID <= m_max_id; ++pixID) {
+      if (usedDetIds[pixID - m_min_id]) {
+        // Find the the workspace index corresponding to that pixel ID
+        size_t wi = getWorkspaceIndexFromPixelID(pixID);
+        if (wi < numEventLists) {
+          auto &el = outputWS.getSpectrum(wi);
           if (pulsetimesincreasing)
             el.setSortOrder(DataObjects::PULSETIME_SORT);
           else
@@ -0,0 +1,163 @@
+// Mantid Repository : https://github.com/mantidproject/mantid
+//
+// Copyright &copy; 2022 ISIS Rutherford Appleton Laboratory UKRI,
+//   NScD Oak Ridge National Laboratory, European Spallation Source,
+//   Institut Laue - Langevin & CSNS, Institute of High Energy Physics, CAS
+// SPDX - License - Identifier: GPL - 3.0 +
+#include "MantidDataHandling/SaveEventCache.h"
+#include "MantidAPI/FileProperty.h"
+#include "MantidAPI/Progress.h"
+#include "MantidAPI/WorkspaceProperty.h"
+#include "MantidDataHandling/EventCacheFormat.h"
+#include "MantidDataObjects/EventWorkspace.h"
+#include "MantidDataObjects/Workspace2D.h"
+#include "MantidDataObjects/WorkspaceCreation.h"
+#include "MantidKernel/Exception.h"
+
+#include <Poco/File.h>
+#include <Poco/TemporaryFile.h>
+
+#include <fstream>
+
+namespace Mantid::DataHandling {
+
+using namespace Mantid::API;
+using namespace Mantid::DataObjects;
+using namespace Mantid::Kernel;
+
+// Register the algorithm into the AlgorithmFactory
+DECLARE_ALGORITHM(SaveEventCache)
+
+namespace {
+/// Write size bytes of data to the stream
+void writeBlock(std::ofstream &out, const void *data, const uint64_t size) {
+  out.write(static_cast<const char *>(data), static_cast<std::streamsize>(size));
+}
+
+/// Pad the stream with zeros up to the given absolute offset
+void padTo(std::ofstream &out, const uint64_t offset) {
+  const auto position = static_cast<uint64_t>(out.tellp());
+  if (position < offset) {
+    const std::vector<char> zeros(offset - position, 0);
+    writeBlock(out, zeros.data(), zeros.size());
+  }
+}
+
+/// Write the raw events of a list in their in-memory layout
+void writeEvents(std::ofstream &out, const EventList &eventList) {
+  switch (eventList.getEventType()) {
+  case API::TOF: {
+    const auto &events = eventList.getEvents();
+    writeBlock(out, events.data(), events.size() * sizeof(Types::Event::TofEvent));
+    break;
+  }
+  case API::WEIGHTED: {
+    const auto &events = eventList.getWeightedEvents();
+    writeBlock(out, events.data(), events.size() * sizeof(WeightedEvent));
+    break;
+  }
+  case API::WEIGHTED_NOTIME: {
+    const auto &events = eventList.getWeightedEventsNoTime();
+    writeBlock(out, events.data(), events.size() * sizeof(WeightedEventNoTime));
+    break;
+  }
+  }
+}
+} // namespace
+
+/** Initialize the algorithm's properties.
+ */
+void SaveEventCache::init() {
+  declareProperty(std::make_unique<WorkspaceProperty<EventWorkspace>>("InputWorkspace", "", Direction::Input),
+                  "The EventWorkspace to save.");
+  declareProperty(std::make_unique<FileProperty>("Filename", "", FileProperty::Save, ".evcache"),
+                  "The name of the event cache file to write.");
+}
+
+/** Execute the algorithm.
+ */
+void SaveEventCache::exec() {
+  EventWorkspace_const_sptr inputWS = getProperty("InputWorkspace");
+  const std::string filename = getPropertyValue("Filename");
+  const size_t numberOfSpectra = inputWS->getNumberHistograms();
+
+  Progress progress(this, 0.0, 1.0, numberOfSpectra + 1);
+
+  const std::string metadataFilename = saveMetadata(*inputWS);
+  Poco::TemporaryFile::registerForDeletion(metadataFilename);
+  progress.report("Saved metadata");
+
+  EventCache::FileHeader header{};
+  header.magic = EventCache::MAGIC;
+  header.version = EventCache::VERSION;
+  header.byteOrderMark = EventCache::BYTE_ORDER_MARK;
+  header.numberOfSpectra = numberOfSpectra;
+  header.metadataOffset = EventCache::alignSection(sizeof(EventCache::FileHeader));
+  header.metadataSize = static_cast<uint64_t>(Poco::File(metadataFilename).getSize());
+  header.tableOffset = EventCache::alignSection(header.metadataOffset + header.metadataSize);
+
+  std::vector<EventCache::SpectrumEntry> table(numberOfSpectra);
+  uint64_t eventsSize = 0;
+  for (size_t i = 0; i < numberOfSpectra; ++i) {
+    const auto &eventList = inputWS->getSpectrum(i);
+    auto &entry = table[i];
+    entry.offset = eventsSize;
+    entry.numberOfEvents = eventList.getNumberEvents();
+    entry.eventType = static_cast<uint32_t>(eventList.getEventType());
+    entry.sortOrder = static_cast<uint32_t>(eventList.getSortType());
+    eventsSize += entry.numberOfEvents * EventCache::eventSize(eventList.getEventType());
+  }
+  header.eventsOffset =
+      EventCache::alignSection(header.tableOffset + numberOfSpectra * sizeof(EventCache::SpectrumEntry));
+  header.eventsSize = eventsSize;
+
+  // Write to a partial file and rename it once complete so an interrupted
+  // save never leaves a valid-looking but incomplete cache behind.
+  const std::string partialFilename = filename + ".part";
+  std::ofstream out(partialFilename, std::ios::binary | std::ios::trunc);
+  if (!out)
+    throw Exception::FileError("Unable to create file", partialFilename);
+
+  std::ifstream metadata(metadataFilename, std::ios::binary);
+  try {
+    writeBlock(out, &header, sizeof(header));
+    padTo(out, header.metadataOffset);
+    out << metadata.rdbuf();
+    padTo(out, header.tableOffset);
+    writeBlock(out, table.data(), table.size() * sizeof(EventCache::SpectrumEntry));
+    padTo(out, header.eventsOffset);
+    for (size_t i = 0; i < numberOfSpectra; ++i) {
+      writeEvents(out, inputWS->getSpectrum(i));
+      progress.report();
+    }
+    out.close();
+    if (!out)
+      throw Exception::FileError("Failed while writing file", filename);
+    Poco::File(partialFilename).renameTo(filename);
+  } catch (...) {
+    out.close();
+    if (Poco::File(partialFilename).exists())
+      Poco::File(partialFilename).remove();
+    throw;
+  }
+  metadata.close();
+  Poco::File(metadataFilename).remove();
+}
+
+/** Save everything but the events, i.e. instrument, logs, spectrum numbers,
+ * detector IDs and binning, to a temporary processed NeXus file.
+ * @param inputWS :: The workspace being cached
+ * @returns The path of the temporary file
+ */
+std::string SaveEventCache::saveMetadata(const EventWorkspace &inputWS) {
+  MatrixWorkspace_sptr metadataWS = create<Workspace2D>(inputWS);
+  const std::string metadataFilename = Poco::TemporaryFile::tempName();
+
+  auto saver = createChildAlgorithm("SaveNexusProcessed", 0.0, 0.0);
+  saver->setProperty("InputWorkspace", metadataWS);
+  saver->setPropertyValue("Filename", metadataFilename);
+  saver->executeAsChildAlg();
+  return metadataFilename;
+}
+
+} // namespace Mantid::DataHandling
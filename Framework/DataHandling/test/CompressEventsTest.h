@@ -128,4 +128,44 @@ public:
   void test_InPlace_ZeroTolerance_WithPulseTime() {
     doTest("CompressEvents_input", "CompressEvents_input", 0.0, 50, .001);
   }
+
+  void test_Logarithmic() {
+    // 200 events at tof 0.5, 1.5, ..., 99.5 in pairs
+    EventWorkspace_sptr input = WorkspaceCreationHelper::createEventWorkspace(5, 100, 100, 0.0, 1.0, 2);
+    const double inputIntegral = input->getSpectrum(0).integrate(0., 100., true);
+
+    CompressEvents alg;
+    alg.initialize();
+    alg.setChild(true);
+    alg.setProperty("InputWorkspace", input);
+    alg.setPropertyValue("OutputWorkspace", "unused_for_child");
+    alg.setProperty("Tolerance", 0.1);
+    alg.setProperty("BinningMode", "Logarithmic");
+    TS_ASSERT_THROWS_NOTHING(alg.execute());
+    TS_ASSERT(alg.isExecuted());
+    EventWorkspace_sptr output = alg.getProperty("OutputWorkspace");
+    TS_ASSERT(output);
+    if (!output)
+      return;
+
+    const auto &el = output->getSpectrum(0);
+    TS_ASSERT_EQUALS(el.getEventType(), WEIGHTED_NOTIME);
+    // groups widen with tof so there are far fewer than the 100 linear groups
+    TS_ASSERT_LESS_THAN(el.getNumberEvents(), 50);
+    TS_ASSERT_LESS_THAN(10, el.getNumberEvents());
+    TS_ASSERT_DELTA(el.integrate(0., 100., true), inputIntegral, 1e-6);
+  }
+
+  void test_Logarithmic_with_WallClockTolerance_is_invalid() {
+    EventWorkspace_sptr input = WorkspaceCreationHelper::createEventWorkspace(2, 10, 10, 0.0, 1.0, 2);
+    CompressEvents alg;
+    alg.initialize();
+    alg.setChild(true);
+    alg.setProperty("InputWorkspace", input);
+    alg.setPropertyValue("OutputWorkspace", "unused_for_child");
+    alg.setProperty("BinningMode", "Logarithmic");
+    alg.setProperty("WallClockTolerance", 0.001);
+    TS_ASSERT_THROWS(alg.execute(), const std::runtime_error &);
+    TS_ASSERT(!alg.isExecuted());
+  }
 };
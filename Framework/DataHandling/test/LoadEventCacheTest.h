@@ -0,0 +1,159 @@
+// Mantid Repository : https://github.com/mantidproject/mantid
+//
+// Copyright &copy; 2022 ISIS Rutherford Appleton Laboratory UKRI,
+//   NScD Oak Ridge National Laboratory, European Spallation Source,
+//   Institut Laue - Langevin & CSNS, Institute of High Energy Physics, CAS
+// SPDX - License - Identifier: GPL - 3.0 +
+#pragma once
+
+#include <cxxtest/TestSuite.h>
+
+#include "MantidAPI/Run.h"
+#include "MantidDataHandling/LoadEventCache.h"
+#include "MantidDataHandling/SaveEventCache.h"
+#include "MantidDataObjects/EventWorkspace.h"
+#include "MantidFrameworkTestHelpers/WorkspaceCreationHelper.h"
+#include "MantidGeometry/Instrument.h"
+#include "MantidKernel/Exception.h"
+#include "MantidKernel/FileDescriptor.h"
+
+#include <Poco/File.h>
+#include <Poco/TemporaryFile.h>
+
+using Mantid::DataHandling::LoadEventCache;
+using Mantid::DataHandling::SaveEventCache;
+using namespace Mantid::API;
+using namespace Mantid::DataObjects;
+
+class LoadEventCacheTest : public CxxTest::TestSuite {
+public:
+  // This pair of boilerplate methods prevent the suite being created statically
+  // This means the constructor isn't called when running other tests
+  static LoadEventCacheTest *createSuite() { return new LoadEventCacheTest(); }
+  static void destroySuite(LoadEventCacheTest *suite) { delete suite; }
+
+  void setUp() override {
+    m_inputWS = WorkspaceCreationHelper::createEventWorkspaceWithFullInstrument(1, 4, false);
+    m_inputWS->getSpectrum(1).switchTo(WEIGHTED);
+    m_inputWS->getSpectrum(2).switchTo(WEIGHTED_NOTIME);
+    m_inputWS->getSpectrum(3).clear(false);
+    m_inputWS->getSpectrum(4).sortTof();
+    m_inputWS->mutableRun().addProperty("cache_test_log", std::string("cached run"));
+    m_filename = Poco::TemporaryFile::tempName() + ".evcache";
+
+    SaveEventCache saver;
+    saver.initialize();
+    saver.setChild(true);
+    saver.setProperty("InputWorkspace", m_inputWS);
+    saver.setPropertyValue("Filename", m_filename);
+    saver.execute();
+  }
+
+  void tearDown() override {
+    if (Poco::File(m_filename).exists())
+      Poco::File(m_filename).remove();
+  }
+
+  void test_Init() {
+    LoadEventCache alg;
+    TS_ASSERT_THROWS_NOTHING(alg.initialize())
+    TS_ASSERT(alg.isInitialized())
+  }
+
+  void test_confidence() {
+    LoadEventCache alg;
+    Mantid::Kernel::FileDescriptor descriptor(m_filename);
+    TS_ASSERT_EQUALS(alg.confidence(descriptor), 90);
+  }
+
+  void test_round_trip() {
+    auto outputWS = load();
+    TS_ASSERT(outputWS);
+    if (!outputWS)
+      return;
+
+    const size_t numberOfSpectra = m_inputWS->getNumberHistograms();
+    TS_ASSERT_EQUALS(outputWS->getNumberHistograms(), numberOfSpectra);
+    TS_ASSERT_EQUALS(outputWS->getNumberEvents(), m_inputWS->getNumberEvents());
+    TS_ASSERT_EQUALS(outputWS->getInstrument()->getName(), m_inputWS->getInstrument()->getName());
+    TS_ASSERT_EQUALS(outputWS->run().getPropertyValueAsType<std::string>("cache_test_log"), "cached run");
+    for (size_t i = 0; i < numberOfSpectra; ++i) {
+      const auto &expected = m_inputWS->getSpectrum(i);
+      const auto &actual = outputWS->getSpectrum(i);
+      TS_ASSERT_EQUALS(actual.getSpectrumNo(), expected.getSpectrumNo());
+      TS_ASSERT_EQUALS(actual.getDetectorIDs(), expected.getDetectorIDs());
+      TS_ASSERT_EQUALS(actual.getEventType(), expected.getEventType());
+      TS_ASSERT_EQUALS(actual.getSortType(), expected.getSortType());
+      TS_ASSERT(actual == expected);
+      TS_ASSERT_EQUALS(actual.x().rawData(), expected.x().rawData());
+    }
+  }
+
+  void test_spectrum_range() {
+    auto outputWS = load(2, 4);
+    TS_ASSERT(outputWS);
+    if (!outputWS)
+      return;
+
+    TS_ASSERT_EQUALS(outputWS->getNumberHistograms(), 3);
+    for (size_t i = 0; i < 3; ++i) {
+      const auto &expected = m_inputWS->getSpectrum(i + 1);
+      const auto &actual = outputWS->getSpectrum(i);
+      TS_ASSERT_EQUALS(actual.getSpectrumNo(), expected.getSpectrumNo());
+      TS_ASSERT(actual == expected);
+    }
+  }
+
+  void test_spectrum_max_beyond_file_throws() {
+    LoadEventCache alg;
+    alg.initialize();
+    alg.setChild(true);
+    alg.setRethrows(true);
+    alg.setPropertyValue("Filename", m_filename);
+    alg.setPropertyValue("OutputWorkspace", "unused");
+    alg.setProperty("SpectrumMax", static_cast<int>(m_inputWS->getNumberHistograms()) + 1);
+    TS_ASSERT_THROWS(alg.execute(), const std::invalid_argument &);
+  }
+
+  void test_spectrum_min_beyond_file_throws() {
+    LoadEventCache alg;
+    alg.initialize();
+    alg.setChild(true);
+    alg.setRethrows(true);
+    alg.setPropertyValue("Filename", m_filename);
+    alg.setPropertyValue("OutputWorkspace", "unused");
+    alg.setProperty("SpectrumMin", static_cast<int>(m_inputWS->getNumberHistograms()) + 1);
+    TS_ASSERT_THROWS(alg.execute(), const std::invalid_argument &);
+  }
+
+  void test_truncated_file_throws() {
+    // Drop the last event so the event section runs past the end of the file
+    const auto size = Poco::File(m_filename).getSize();
+    Poco::File(m_filename).setSize(size - sizeof(Mantid::Types::Event::TofEvent));
+
+    LoadEventCache alg;
+    alg.initialize();
+    alg.setChild(true);
+    alg.setRethrows(true);
+    alg.setPropertyValue("Filename", m_filename);
+    alg.setPropertyValue("OutputWorkspace", "unused");
+    TS_ASSERT_THROWS(alg.execute(), const Mantid::Kernel::Exception::FileError &);
+  }
+
+private:
+  EventWorkspace_sptr load(const int specMin = 1, const int specMax = Mantid::EMPTY_INT()) {
+    LoadEventCache alg;
+    alg.initialize();
+    alg.setChild(true);
+    alg.setPropertyValue("Filename", m_filename);
+    alg.setPropertyValue("OutputWorkspace", "unused");
+    alg.setProperty("SpectrumMin", specMin);
+    alg.setProperty("SpectrumMax", specMax);
+    TS_ASSERT_THROWS_NOTHING(alg.execute());
+    TS_ASSERT(alg.isExecuted());
+    return alg.getProperty("OutputWorkspace");
+  }
+
+  EventWorkspace_sptr m_inputWS;
+  std::string m_filename;
+};
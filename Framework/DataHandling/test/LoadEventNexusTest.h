@@ -382,6 +382,91 @@ public:
     TS_ASSERT_DELTA(duration, 7200.012, 0.01);
   }
 
+  void test_MaxChunkSize_matches_single_load() {
+    LoadEventNexus ld;
+    ld.initialize();
+    ld.setChild(true);
+    ld.setPropertyValue("Filename", "CNCS_7860_event.nxs");
+    ld.setPropertyValue("OutputWorkspace", "unused");
+    ld.setProperty<bool>("LoadLogs", false);
+    ld.execute();
+    TS_ASSERT(ld.isExecuted());
+    Workspace_sptr ws = ld.getProperty("OutputWorkspace");
+    auto WS = std::dynamic_pointer_cast<EventWorkspace>(ws);
+
+    // 112266 events are ~5MiB so this gives several chunks
+    LoadEventNexus ldChunked;
+    ldChunked.initialize();
+    ldChunked.setChild(true);
+    ldChunked.setPropertyValue("Filename", "CNCS_7860_event.nxs");
+    ldChunked.setPropertyValue("OutputWorkspace", "unused");
+    ldChunked.setProperty<bool>("LoadLogs", false);
+    ldChunked.setProperty("MaxChunkSize", 0.001);
+    size_t numChunks = 0;
+    ldChunked.setChunkProcessor([&numChunks](const MatrixWorkspace_sptr &chunk) {
+      ++numChunks;
+      return chunk;
+    });
+    ldChunked.execute();
+    TS_ASSERT(ldChunked.isExecuted());
+    Workspace_sptr chunkedOut = ldChunked.getProperty("OutputWorkspace");
+    auto chunkedWS = std::dynamic_pointer_cast<EventWorkspace>(chunkedOut);
+
+    TS_ASSERT_LESS_THAN(1, numChunks);
+    TS_ASSERT(chunkedWS);
+    TS_ASSERT_EQUALS(chunkedWS->getNumberHistograms(), WS->getNumberHistograms());
+    TS_ASSERT_EQUALS(chunkedWS->getNumberEvents(), WS->getNumberEvents());
+    TS_ASSERT_EQUALS(chunkedWS->getSpectrum(1000).getNumberEvents(), WS->getSpectrum(1000).getNumberEvents());
+    TS_ASSERT_DELTA(chunkedWS->x(0).front(), WS->x(0).front(), 1e-6);
+    TS_ASSERT_DELTA(chunkedWS->x(0).back(), WS->x(0).back(), 1e-6);
+    TS_ASSERT_EQUALS(ldChunked.getPropertyValue("Filename"), chunkedWS->run().getProperty("Filename")->value());
+  }
+
+  void test_MaxChunkSize_with_ChunkProcessingAlgorithm() {
+    LoadEventNexus ld;
+    ld.initialize();
+    ld.setChild(true);
+    ld.setPropertyValue("Filename", "CNCS_7860_event.nxs");
+    ld.setPropertyValue("OutputWorkspace", "unused");
+    ld.setProperty<bool>("LoadLogs", false);
+    ld.setProperty("MaxChunkSize", 0.001);
+    ld.setProperty("ChunkProcessingAlgorithm", "CompressEvents");
+    ld.setProperty("ChunkProcessingProperties", "Tolerance=0.1");
+    ld.execute();
+    TS_ASSERT(ld.isExecuted());
+    Workspace_sptr ws = ld.getProperty("OutputWorkspace");
+    auto WS = std::dynamic_pointer_cast<EventWorkspace>(ws);
+    TS_ASSERT(WS);
+    TS_ASSERT_EQUALS(WS->getEventType(), WEIGHTED_NOTIME);
+    TS_ASSERT_DELTA(WS->getTofMin(), 44163.6, 0.5);
+  }
+
+  void test_MaxChunkSize_without_ChunkProcessingAlgorithm_throws() {
+    LoadEventNexus ld;
+    ld.initialize();
+    ld.setChild(true);
+    ld.setRethrows(true);
+    ld.setPropertyValue("Filename", "CNCS_7860_event.nxs");
+    ld.setPropertyValue("OutputWorkspace", "unused");
+    ld.setProperty<bool>("LoadLogs", false);
+    ld.setProperty("MaxChunkSize", 0.001);
+    TS_ASSERT_THROWS(ld.execute(), const std::invalid_argument &);
+  }
+
+  void test_MaxChunkSize_with_ChunkNumber_throws() {
+    LoadEventNexus ld;
+    ld.initialize();
+    ld.setChild(true);
+    ld.setRethrows(true);
+    ld.setPropertyValue("Filename", "CNCS_7860_event.nxs");
+    ld.setPropertyValue("OutputWorkspace", "unused");
+    ld.setProperty<bool>("LoadLogs", false);
+    ld.setProperty("MaxChunkSize", 0.001);
+    ld.setProperty("ChunkNumber", 1);
+    ld.setProperty("TotalChunks", 2);
+    TS_ASSERT_THROWS(ld.execute(), const std::invalid_argument &);
+  }
+
   void test_Normal_vs_Precount() {
     Mantid::API::FrameworkManager::Instance();
     LoadEventNexus ld;
@@ -0,0 +1,75 @@
+// Mantid Repository : https://github.com/mantidproject/mantid
+//
+// Copyright &copy; 2022 ISIS Rutherford Appleton Laboratory UKRI,
+//   NScD Oak Ridge National Laboratory, European Spallation Source,
+//   Institut Laue - Langevin & CSNS, Institute of High Energy Physics, CAS
+// SPDX - License - Identifier: GPL - 3.0 +
+#pragma once
+
+#include <cxxtest/TestSuite.h>
+
+#include "MantidDataHandling/EventCacheFormat.h"
+#include "MantidDataHandling/SaveEventCache.h"
+#include "MantidDataObjects/EventWorkspace.h"
+#include "MantidFrameworkTestHelpers/WorkspaceCreationHelper.h"
+
+#include <Poco/File.h>
+#include <Poco/TemporaryFile.h>
+
+#include <fstream>
+
+using Mantid::DataHandling::SaveEventCache;
+using namespace Mantid::DataHandling;
+
+class SaveEventCacheTest : public CxxTest::TestSuite {
+public:
+  // This pair of boilerplate methods prevent the suite being created statically
+  // This means the constructor isn't called when running other tests
+  static SaveEventCacheTest *createSuite() { return new SaveEventCacheTest(); }
+  static void destroySuite(SaveEventCacheTest *suite) { delete suite; }
+
+  void test_Init() {
+    SaveEventCache alg;
+    TS_ASSERT_THROWS_NOTHING(alg.initialize())
+    TS_ASSERT(alg.isInitialized())
+  }
+
+  void test_layout() {
+    auto inputWS = WorkspaceCreationHelper::createEventWorkspace2(3, 10);
+    inputWS->getSpectrum(1).switchTo(Mantid::API::WEIGHTED);
+    const std::string filename = Poco::TemporaryFile::tempName() + ".evcache";
+
+    SaveEventCache alg;
+    alg.initialize();
+    alg.setChild(true);
+    alg.setProperty("InputWorkspace", inputWS);
+    alg.setPropertyValue("Filename", filename);
+    TS_ASSERT_THROWS_NOTHING(alg.execute());
+    TS_ASSERT(alg.isExecuted());
+
+    std::ifstream file(filename, std::ios::binary);
+    EventCache::FileHeader header{};
+    file.read(reinterpret_cast<char *>(&header), sizeof(header));
+    TS_ASSERT(header.magic == EventCache::MAGIC);
+    TS_ASSERT_EQUALS(header.version, EventCache::VERSION);
+    TS_ASSERT_EQUALS(header.numberOfSpectra, 3);
+    TS_ASSERT_EQUALS(header.metadataOffset % EventCache::SECTION_ALIGNMENT, 0);
+    TS_ASSERT_EQUALS(header.tableOffset % EventCache::SECTION_ALIGNMENT, 0);
+    TS_ASSERT_EQUALS(header.eventsOffset % EventCache::SECTION_ALIGNMENT, 0);
+    TS_ASSERT_EQUALS(header.eventsSize, 2 * 200 * sizeof(Mantid::Types::Event::TofEvent) +
+                                            200 * sizeof(Mantid::DataObjects::WeightedEvent));
+
+    std::vector<EventCache::SpectrumEntry> table(3);
+    file.seekg(static_cast<std::streamoff>(header.tableOffset));
+    file.read(reinterpret_cast<char *>(table.data()), table.size() * sizeof(EventCache::SpectrumEntry));
+    TS_ASSERT_EQUALS(table[0].offset, 0);
+    TS_ASSERT_EQUALS(table[1].offset, 200 * sizeof(Mantid::Types::Event::TofEvent));
+    TS_ASSERT_EQUALS(table[1].eventType, Mantid::API::WEIGHTED);
+    TS_ASSERT_EQUALS(table[2].offset, table[1].offset + 200 * sizeof(Mantid::DataObjects::WeightedEvent));
+    file.close();
+    TS_ASSERT(!Poco::File(filename + ".part").exists());
+
+    if (Poco::File(filename).exists())
+      Poco::File(filename).remove();
+  }
+};
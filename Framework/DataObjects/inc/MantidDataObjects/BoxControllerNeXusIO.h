@@ -51,6 +51,13 @@ public:
   // not fully supported. Should be replaced by some IBoxControllerIO factory
   void setDataType(const size_t blockSize, const std::string &typeName) override;
   void getDataType(size_t &CoordSize, std::string &typeName) const override;
+  /** Store each event field (signal, error, indices and each coordinate) in
+   * its own deflate-compressed column when a file is given new event data.
+   * Files which already have event data keep the layout they were written in.
+   */
+  void setCompressedColumns(const bool compress) { m_compressColumns = compress; }
+  ///@return true if the events are stored, or will be stored, in compressed columns
+  bool compressedColumns() const { return m_compressColumns; }
   //------------------------------------------------------------------------------------------------------------------------
   // Auxiliary functions (non-virtual, used for testing)
   int64_t getNDataColums() const { return m_BlockSize[1]; }
@@ -148,6 +155,10 @@ private:
 
   /// The version of the md events data block
   std::string m_EventsVersion;
+  /// The version of the md events data block stored in columns
+  std::string m_ColumnsVersion;
+  /// true if the events are stored in compressed columns, not in one table
+  bool m_compressColumns;
 
   /// "data_event" dataset version in the current Nexus file
   EventDataVersion m_EventDataVersion;
@@ -170,6 +181,7 @@ private:
   void getDiskBufferFileData();
   void prepareNxSToWrite_CurVersion();
   void prepareNxSdata_CurVersion();
+  std::vector<std::string> columnNames() const;
   // get the event type from event name
   static EventType TypeFromString(const std::vector<std::string> &typesSupported, const std::string &typeName);
   /// the enum, which suggests the way (currently)two possible data types are
@@ -23,6 +23,7 @@ class DateAndTime;
 namespace Kernel {
 class SplittingInterval;
 using TimeSplitterType = std::vector<SplittingInterval>;
+struct TOFCoefficients;
 class Unit;
 } // namespace Kernel
 namespace DataObjects {
@@ -201,7 +202,7 @@ public:
 
   virtual size_t histogram_size() const;
 
-  void compressEvents(double tolerance, EventList *destination);
+  void compressEvents(double tolerance, EventList *destination, const bool parallel = false);
   void compressFatEvents(const double tolerance, const Types::Core::DateAndTime &timeStart, const double seconds,
                          EventList *destination);
   // get EventType declaration
@@ -348,9 +349,14 @@ private:
   /// MRU lists of the parent EventWorkspace
   mutable EventWorkspaceMRU *mru;
 
+  /// Tags the histograms cached in the MRU, changed whenever they become invalid
+  uint64_t m_mruGeneration;
+
   /// Mutex that is locked while sorting an event list
   mutable std::mutex m_sortMutex;
 
+  void invalidateMRU();
+
   template <class T>
   static typename std::vector<T>::const_iterator findFirstPulseEvent(const std::vector<T> &events,
                                                                      const double seek_pulsetime);
@@ -457,6 +463,12 @@ private:
                                 Mantid::Kernel::Unit *toUnit);
   template <class T>
   void convertUnitsQuicklyHelper(typename std::vector<T> &events, const double &factor, const double &power);
+  template <class T>
+  static void convertUnitsViaTofHelper(typename std::vector<T> &events, const Mantid::Kernel::TOFCoefficients &from,
+                                       const Mantid::Kernel::TOFCoefficients &to);
+  template <int FromPower, int ToPower, class T>
+  static void convertUnitsViaTofHelper(typename std::vector<T> &events, const Mantid::Kernel::TOFCoefficients &from,
+                                       const Mantid::Kernel::TOFCoefficients &to);
 };
 
 // Methods overloaded to get event vectors.
@@ -136,6 +136,8 @@ public:
 
   std::size_t MRUSize() const;
 
+  double MRUHitRate() const;
+
   void clearMRU() const override;
 
   EventSortType getSortType() const;
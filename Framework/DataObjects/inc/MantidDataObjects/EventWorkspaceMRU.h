@@ -13,8 +13,8 @@
 #include "MantidKernel/System.h"
 #include "MantidKernel/cow_ptr.h"
 
-#include "Poco/RWLock.h"
-
+#include <array>
+#include <atomic>
 #include <cstdint>
 #include <vector>
 
@@ -34,8 +34,10 @@ public:
   /**
    * Constructor.
    * @param the_index :: unique index into the workspace of this data
+   * @param generation :: generation of the source data this was made from
    */
-  TypeWithMarker(const uintptr_t the_index) : m_index(the_index) {}
+  TypeWithMarker(const uintptr_t the_index, const uint64_t generation = 0)
+      : m_index(the_index), m_generation(generation) {}
   TypeWithMarker(const TypeWithMarker &other) = delete;
   TypeWithMarker &operator=(const TypeWithMarker &other) = delete;
 
@@ -43,6 +45,9 @@ public:
   /// Unique index value.
   uintptr_t m_index;
 
+  /// Generation of the EventList when the data was generated
+  uint64_t m_generation;
+
   /// Pointer to a vector of data
   T m_data;
 
@@ -57,6 +62,12 @@ public:
 //============================================================================
 /** This is a container for the MRU (most-recently-used) list
  * of generated histograms.
+ *
+ * There is one shard of MRU lists per thread number, so concurrent readers
+ * never share a lock or a cache line. Entries are tagged with the generation
+ * of the EventList they were made from. An EventList takes a new generation
+ * whenever its histogram becomes invalid, which turns any cached entry into a
+ * miss without having to visit the shards of the other threads.
  */
 class DLLExport EventWorkspaceMRU {
 public:
@@ -68,19 +79,34 @@ public:
   using mru_listY = Kernel::MRUList<YWithMarker>;
   using mru_listE = Kernel::MRUList<EWithMarker>;
 
+  /// Number of lookups that found, or did not find, a cached histogram
+  struct Statistics {
+    uint64_t hits{0};
+    uint64_t misses{0};
+    /// Fraction of lookups that were hits, 0 if there were none
+    double hitRate() const {
+      const auto total = hits + misses;
+      return total > 0 ? static_cast<double>(hits) / static_cast<double>(total) : 0.;
+    }
+  };
+
+  EventWorkspaceMRU();
   ~EventWorkspaceMRU();
-
-  void ensureEnoughBuffersY(size_t thread_num) const;
-  void ensureEnoughBuffersE(size_t thread_num) const;
+  EventWorkspaceMRU(const EventWorkspaceMRU &) = delete;
+  EventWorkspaceMRU &operator=(const EventWorkspaceMRU &) = delete;
 
   void clear();
 
-  YType findY(size_t thread_num, const EventList *index);
-  EType findE(size_t thread_num, const EventList *index);
-  void insertY(size_t thread_num, YType data, const EventList *index);
-  void insertE(size_t thread_num, EType data, const EventList *index);
+  YType findY(size_t thread_num, const EventList *index, uint64_t generation);
+  EType findE(size_t thread_num, const EventList *index, uint64_t generation);
+  void insertY(size_t thread_num, YType data, const EventList *index, uint64_t generation);
+  void insertE(size_t thread_num, EType data, const EventList *index, uint64_t generation);
 
-  void deleteIndex(const EventList *index);
+  /// A generation that has never been handed out before
+  static uint64_t nextGeneration();
+
+  Statistics statistics() const;
+  void resetStatistics();
 
   /** Return how many entries in the Y MRU list are used.
    * Only used in tests. It only returns the 0-th MRU list size.
@@ -88,15 +114,25 @@ public:
   size_t MRUSize() const;
 
 protected:
-  /// The most-recently-used list of dataY histograms
-  mutable std::vector<std::unique_ptr<mru_listY>> m_bufferedDataY;
-
-  /// The most-recently-used list of dataE histograms
-  mutable std::vector<std::unique_ptr<mru_listE>> m_bufferedDataE;
-
-  /// Mutex when adding entries in the MRU list
-  mutable Poco::RWLock m_changeMruListsMutexE;
-  mutable Poco::RWLock m_changeMruListsMutexY;
+  /// The MRU lists used by one thread, padded to keep the counters of
+  /// different threads on separate cache lines
+  struct alignas(64) Shard {
+    Shard();
+    /// The most-recently-used list of dataY histograms
+    mru_listY bufferedDataY;
+    /// The most-recently-used list of dataE histograms
+    mru_listE bufferedDataE;
+    std::atomic<uint64_t> hits{0};
+    std::atomic<uint64_t> misses{0};
+  };
+
+  /// Threads beyond this many share shards
+  static constexpr size_t MAX_SHARDS = 256;
+
+  Shard &shard(size_t thread_num) const;
+
+  /// Shards are created on first use and live as long as the MRU
+  mutable std::array<std::atomic<Shard *>, MAX_SHARDS> m_shards;
 };
 
 } // namespace DataObjects
@@ -169,6 +169,8 @@ public:
   void integrateSphere(Mantid::API::CoordTransform &radiusTransform, const coord_t radiusSquared, signal_t &signal,
                        signal_t &errorSquared, const coord_t innerRadiusSquared = 0.0,
                        const bool useOnePercentBackgroundCorrection = true) const override;
+  void integrateSpheres(const std::vector<MDIntegrationSphere> &spheres, const std::vector<size_t> &active,
+                        signal_t *signal, signal_t *errorSquared) const override;
   void centroidSphere(Mantid::API::CoordTransform &radiusTransform, const coord_t radiusSquared, coord_t *centroid,
                       signal_t &signal) const override;
   void integrateCylinder(Mantid::API::CoordTransform &radiusTransform, const coord_t radius, const coord_t length,
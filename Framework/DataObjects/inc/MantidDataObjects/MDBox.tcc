@@ -609,6 +609,60 @@ TMDE(void MDBox)::integrateSphere(Mantid::API::CoordTransform &radiusTransform,
   }
 }
 
+/** Integrate the signal within many spheres at once, giving the same result for
+ * each as integrateSphere() with a CoordTransformDistance using every
+ * dimension.
+ *
+ * @param spheres :: all the spheres
+ * @param active :: indices of the spheres to integrate here
+ * @param signal :: array of the integrated signal of each sphere, added to
+ * @param errorSquared :: array of the integrated error squared of each sphere,
+ *added to
+ */
+TMDE(void MDBox)::integrateSpheres(const std::vector<MDIntegrationSphere> &spheres, const std::vector<size_t> &active,
+                                   signal_t *signal, signal_t *errorSquared) const {
+  // If the box is cached to disk, you need to retrieve it
+  const std::vector<MDE> &events = this->getConstEvents();
+  using valAndErrorPair = std::pair<signal_t, signal_t>;
+  std::vector<valAndErrorPair> vals;
+  for (const size_t index : active) {
+    const MDIntegrationSphere &sphere = spheres[index];
+    const coord_t *center = sphere.center.data();
+    vals.clear();
+    for (const auto &it : events) {
+      coord_t distanceSquared = 0;
+      for (size_t d = 0; d < nd; ++d) {
+        const coord_t dist = it.getCenter(d) - center[d];
+        distanceSquared += dist * dist;
+      }
+      if (distanceSquared < sphere.radiusSquared) {
+        if (sphere.innerRadiusSquared == 0.0) {
+          signal[index] += static_cast<signal_t>(it.getSignal());
+          errorSquared[index] += static_cast<signal_t>(it.getErrorSquared());
+        } else if (distanceSquared > sphere.innerRadiusSquared) {
+          vals.emplace_back(static_cast<signal_t>(it.getSignal()), static_cast<signal_t>(it.getErrorSquared()));
+        }
+      }
+    }
+    if (vals.empty())
+      continue;
+    // Sort based on signal values and remove top 1% of background, as in
+    // integrateSphere()
+    std::sort(vals.begin(), vals.end(),
+              [](const valAndErrorPair &a, const valAndErrorPair &b) { return a.first < b.first; });
+    const size_t endIndex = sphere.useOnePercentBackgroundCorrection
+                                ? static_cast<size_t>(0.99 * static_cast<double>(vals.size()))
+                                : vals.size();
+    for (size_t k = 0; k < endIndex; k++) {
+      signal[index] += vals[k].first;
+      errorSquared[index] += vals[k].second;
+    }
+  }
+  if (m_Saveable) {
+    m_Saveable->setBusy(false);
+  }
+}
+
 /** Integrate the signal within a sphere; for example, to perform single-crystal
  * peak integration.
  * The CoordTransform object could be used for more complex shapes, e.g.
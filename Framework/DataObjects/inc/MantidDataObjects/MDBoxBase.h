@@ -11,6 +11,7 @@
 #include "MantidAPI/IMDNode.h"
 #include "MantidAPI/IMDWorkspace.h"
 #include "MantidDataObjects/MDBin.h"
+#include "MantidDataObjects/MDIntegrationSphere.h"
 #include "MantidDataObjects/MDLeanEvent.h"
 #include "MantidGeometry/MDGeometry/MDDimensionExtents.h"
 #include "MantidGeometry/MDGeometry/MDImplicitFunction.h"
@@ -127,6 +128,17 @@ public:
                        signal_t &errorSquared, const coord_t innerRadiusSquared = 0.0,
                        const bool useOnePercentBackgroundCorrection = true) const override = 0;
 
+  /** Integrate many spheres (peaks) in one pass over the boxes
+   * @param spheres :: all the spheres
+   * @param active :: indices of the spheres that may overlap this box, in
+   *order of their first coordinate
+   * @param signal :: array of the integrated signal of each sphere, added to
+   * @param errorSquared :: array of the integrated error squared of each
+   *sphere, added to
+   */
+  virtual void integrateSpheres(const std::vector<MDIntegrationSphere> &spheres, const std::vector<size_t> &active,
+                                signal_t *signal, signal_t *errorSquared) const = 0;
+
   /** Find the centroid around a sphere */
   void centroidSphere(Mantid::API::CoordTransform &radiusTransform, const coord_t radiusSquared, coord_t *centroid,
                       signal_t &signal) const override = 0;
@@ -12,8 +12,11 @@
 #include "MantidDataObjects/MDLeanEvent.h"
 #include "MantidDataObjects/SkippingPolicy.h"
 #include "MantidGeometry/MDGeometry/MDImplicitFunction.h"
+#include "MantidKernel/DiskPrefetcher.h"
 #include "MantidKernel/System.h"
 
+#include <memory>
+
 namespace Mantid {
 namespace DataObjects {
 // Forward declaration.
@@ -84,6 +87,8 @@ public:
   /// Getter for the position of the iterator.
   size_t getPosition() const { return m_pos; }
 
+  void prefetchEvents();
+
   std::vector<size_t> findNeighbourIndexes() const override;
 
   std::vector<size_t> findNeighbourIndexesFaceTouching() const override;
@@ -101,6 +106,8 @@ private:
 
   void releaseEvents() const;
 
+  void advancePrefetcher();
+
   /// Current position in the vector of boxes
   size_t m_pos;
 
@@ -121,6 +128,12 @@ private:
 
   // Skipping policy, controlls recursive calls to next().
   SkippingPolicy_scptr m_skippingPolicy;
+
+  /// Loads file-backed boxes ahead of the iterator, if enabled
+  std::unique_ptr<Kernel::DiskPrefetcher> m_prefetcher;
+
+  /// For each position, the number of boxes before it given to m_prefetcher
+  std::vector<size_t> m_prefetchIndex;
 };
 
 } // namespace DataObjects
@@ -9,6 +9,8 @@
 #include "MantidGeometry/MDGeometry/MDImplicitFunction.h"
 #include "MantidKernel/System.h"
 
+#include <algorithm>
+
 namespace Mantid {
 namespace DataObjects {
 
@@ -144,6 +146,7 @@ TMDE(void MDBoxIterator)::jumpTo(size_t index) {
   if (m_pos < m_max) {
     m_current = dynamic_cast<MDBoxBase<MDE, nd> *>(m_boxes[m_pos]);
   }
+  advancePrefetcher();
 }
 
 //----------------------------------------------------------------------------------------------
@@ -172,6 +175,7 @@ TMDE(bool MDBoxIterator)::next() {
 TMDE(inline bool MDBoxIterator)::next(size_t skip) {
   releaseEvents();
   m_pos += skip;
+  advancePrefetcher();
   if (m_pos < m_max) {
     // Move up.
     m_current = dynamic_cast<MDBoxBase<MDE, nd> *>(m_boxes[m_pos]);
@@ -181,6 +185,45 @@ TMDE(inline bool MDBoxIterator)::next(size_t skip) {
     return false;
 }
 
+//----------------------------------------------------------------------------------------------
+/** Start loading the events of file-backed boxes on a background thread,
+ * in the order this iterator visits them, so that they are in memory by the
+ * time they are used. Boxes are loaded ahead of the iterator up to the size of
+ * the DiskBuffer's write buffer, which limits the events held in memory.
+ *
+ * Only worth calling when the events of most boxes will be used.
+ * Does nothing if the workspace is not file-backed.
+ */
+TMDE(void MDBoxIterator)::prefetchEvents() {
+  if (m_prefetcher || m_boxes.empty())
+    return;
+  const auto bc = m_boxes.front()->getBoxController();
+  if (!bc->isFileBacked())
+    return;
+
+  std::vector<Kernel::ISaveable *> toLoad;
+  m_prefetchIndex.resize(m_max + 1);
+  for (size_t i = 0; i < m_max; ++i) {
+    m_prefetchIndex[i] = toLoad.size();
+    Kernel::ISaveable *saveable = m_boxes[i]->getISaveable();
+    if (saveable && saveable->wasSaved())
+      toLoad.emplace_back(saveable);
+  }
+  m_prefetchIndex[m_max] = toLoad.size();
+  if (toLoad.empty())
+    return;
+
+  m_prefetcher = std::make_unique<Kernel::DiskPrefetcher>(std::move(toLoad), *bc->getFileIO(),
+                                                             bc->getFileIO()->getWriteBufferSize());
+  advancePrefetcher();
+}
+
+/// Tell the prefetcher, if any, where the iterator has got to
+TMDE(void MDBoxIterator)::advancePrefetcher() {
+  if (m_prefetcher)
+    m_prefetcher->advanceTo(m_prefetchIndex[std::min(m_pos, m_max)]);
+}
+
 //----------------------------------------------------------------------------------------------
 /** If needed, retrieve the events vector from the box.
  * Does nothing if the events are already obtained.
@@ -9,6 +9,8 @@
 #include "MantidAPI/IMDNode.h"
 #include "MantidKernel/ISaveable.h"
 
+#include <mutex>
+
 namespace Mantid {
 namespace DataObjects {
 
@@ -29,7 +31,7 @@ public:
   void save() const override;
 
   /// Load the data which are not in memory yet and merge them with the data in
-  /// memory;
+  /// memory. Safe to call from several threads at once.
   void load() override;
   /// Method to flush the data to disk and ensure it is written.
   void flushData() const override;
@@ -46,6 +48,8 @@ public:
 
 private:
   API::IMDNode *const m_MDNode;
+  /// Stops a prefetching thread and the user of the box loading it twice
+  std::mutex m_loadMutex;
 };
 } // namespace DataObjects
 } // namespace Mantid
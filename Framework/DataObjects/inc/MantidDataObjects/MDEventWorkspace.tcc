@@ -176,6 +176,7 @@ TMDE(void MDEventWorkspace)::setMinRecursionDepth(size_t minDepth) {
     throw std::runtime_error(mess.str());
   }
 
+  this->markModified();
   for (size_t depth = 1; depth < minDepth; depth++) {
     // Get all the MDGridBoxes in the workspace
     std::vector<API::IMDNode *> boxes;
@@ -534,7 +535,10 @@ TMDE(size_t MDEventWorkspace)::getMemorySize() const {
  *
  * @param event :: event to add.
  */
-TMDE(size_t MDEventWorkspace)::addEvent(const MDE &event) { return data->addEvent(event); }
+TMDE(size_t MDEventWorkspace)::addEvent(const MDE &event) {
+  this->markModified();
+  return data->addEvent(event);
+}
 
 //-----------------------------------------------------------------------------------------------
 /** Add a vector of MDEvents to the workspace.
@@ -543,13 +547,17 @@ TMDE(size_t MDEventWorkspace)::addEvent(const MDE &event) { return data->addEven
  *the
  *        MDBox'es contained within.
  */
-TMDE(size_t MDEventWorkspace)::addEvents(const std::vector<MDE> &events) { return data->addEvents(events); }
+TMDE(size_t MDEventWorkspace)::addEvents(const std::vector<MDE> &events) {
+  this->markModified();
+  return data->addEvents(events);
+}
 
 //-----------------------------------------------------------------------------------------------
 /** Split the contained MDBox into a MDGridBox or MDSplitBox, if it is not
  * that already.
  */
 TMDE(void MDEventWorkspace)::splitBox() {
+  this->markModified();
   // Want MDGridBox
   MDGridBox<MDE, nd> *gridBox = dynamic_cast<MDGridBox<MDE, nd> *>(data.get());
   if (!gridBox) {
@@ -572,7 +580,10 @@ TMDE(void MDEventWorkspace)::splitBox() {
  * @param ts :: optional ThreadScheduler * that will be used to parallelize
  *        recursive splitting. Set to NULL to do it serially.
  */
-TMDE(void MDEventWorkspace)::splitAllIfNeeded(Kernel::ThreadScheduler *ts) { data->splitAllIfNeeded(ts); }
+TMDE(void MDEventWorkspace)::splitAllIfNeeded(Kernel::ThreadScheduler *ts) {
+  this->markModified();
+  data->splitAllIfNeeded(ts);
+}
 
 //-----------------------------------------------------------------------------------------------
 /** Goes through the MDBoxes that were tracked by the BoxController
@@ -607,6 +618,7 @@ TMDE(void MDEventWorkspace)::splitTrackedBoxes(Kernel::ThreadScheduler *ts) {
  * NOTE: This is performed in parallel using a threadpool.
  *  */
 TMDE(void MDEventWorkspace)::refreshCache() {
+  this->markModified();
   // Function is overloaded and recursive; will check all sub-boxes
   data->refreshCache();
   // TODO ThreadPool
@@ -797,6 +809,7 @@ TMDE(void MDEventWorkspace)::setMDMasking(std::unique_ptr<Mantid::Geometry::MDIm
       box->clearFileBacked(false);
       box->mask();
     }
+    this->markModified();
   }
 }
 
@@ -810,6 +823,7 @@ TMDE(void MDEventWorkspace)::clearMDMasking() {
   for (const auto box : allBoxes) {
     box->unmask();
   }
+  this->markModified();
 }
 
 /**
@@ -154,6 +154,13 @@ public:
                        signal_t &errorSquared, const coord_t innerRadiusSquared = 0.0,
                        const bool useOnePercentBackgroundCorrection = true) const override;
 
+  void integrateSpheres(const std::vector<MDIntegrationSphere> &spheres, const std::vector<size_t> &active,
+                        signal_t *signal, signal_t *errorSquared) const override;
+
+  std::vector<std::vector<size_t>> selectSpheres(const std::vector<MDIntegrationSphere> &spheres,
+                                                 const std::vector<size_t> &active, signal_t *signal,
+                                                 signal_t *errorSquared) const;
+
   void centroidSphere(Mantid::API::CoordTransform &radiusTransform, const coord_t radiusSquared, coord_t *centroid,
                       signal_t &signal) const override;
 
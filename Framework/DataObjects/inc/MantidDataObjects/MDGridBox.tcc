@@ -17,6 +17,7 @@
 #include "MantidKernel/Timer.h"
 #include "MantidKernel/Utils.h"
 #include "MantidKernel/WarningSuppressions.h"
+#include <algorithm>
 #include <boost/math/special_functions/round.hpp>
 #include <boost/optional.hpp>
 #include <ostream>
@@ -104,6 +105,17 @@ TMDE(MDGridBox)::MDGridBox(MDBox<MDE, nd> *box)
   // Prepare to distribute the events that were in the box before, this will
   // load missing events from HDD in file based ws if there are some.
   const std::vector<MDE> &events = box->getConstEvents();
+  // Count the events going to each child first, so that their event vectors
+  // are allocated once at their final size instead of growing event by event
+  std::vector<uint64_t> numChildEvents(numBoxes, 0);
+  for (const auto &evnt : events) {
+    const size_t cindex = std::min(calculateChildIndex(evnt), numBoxes - 1);
+    ++numChildEvents[cindex];
+  }
+  for (size_t i = 0; i < numBoxes; ++i) {
+    if (numChildEvents[i] > 0)
+      m_Children[i]->reserveMemoryForLoad(numChildEvents[i]);
+  }
   // just add event to the existing internal box
   for (const auto &evnt : events)
     addEvent(evnt);
@@ -1264,6 +1276,125 @@ TMDE(void MDGridBox)::integrateSphere(API::CoordTransform &radiusTransform, cons
   } // (for each box)
 }
 
+//-----------------------------------------------------------------------------------------------
+/** Integrate the signal within many spheres at once, giving the same result for
+ * each as integrateSphere() with a CoordTransformDistance using every
+ * dimension. The boxes are visited once for all the spheres.
+ *
+ * @param spheres :: all the spheres
+ * @param active :: indices of the spheres that may overlap this box, in order
+ *of their first coordinate
+ * @param signal :: array of the integrated signal of each sphere, added to
+ * @param errorSquared :: array of the integrated error squared of each sphere,
+ *added to
+ */
+TMDE(void MDGridBox)::integrateSpheres(const std::vector<MDIntegrationSphere> &spheres,
+                                       const std::vector<size_t> &active, signal_t *signal,
+                                       signal_t *errorSquared) const {
+  const auto childSpheres = selectSpheres(spheres, active, signal, errorSquared);
+  for (size_t bIndex = 0; bIndex < numBoxes; ++bIndex) {
+    if (!childSpheres[bIndex].empty())
+      m_Children[bIndex]->integrateSpheres(spheres, childSpheres[bIndex], signal, errorSquared);
+  }
+}
+
+//-----------------------------------------------------------------------------------------------
+/** The first step of integrateSpheres(): add the totals of the child boxes
+ * lying inside a sphere to its integral, and find the spheres to integrate
+ * further in each of the other child boxes. A child box is classified for a
+ * sphere exactly as in integrateSphere(). Only the spheres whose centres lie
+ * close enough to a child box along the first dimension are looked at.
+ *
+ * @param spheres :: all the spheres
+ * @param active :: indices of the spheres that may overlap this box, in order
+ *of their first coordinate
+ * @param signal :: array of the integrated signal of each sphere, added to
+ * @param errorSquared :: array of the integrated error squared of each sphere,
+ *added to
+ * @return for each child box, the indices of the spheres to integrate in it,
+ *in the same order as active
+ */
+TMDE(std::vector<std::vector<size_t>> MDGridBox)::selectSpheres(const std::vector<MDIntegrationSphere> &spheres,
+                                                                const std::vector<size_t> &active, signal_t *signal,
+                                                                signal_t *errorSquared) const {
+  std::vector<std::vector<size_t>> childSpheres(numBoxes);
+  if (active.empty())
+    return childSpheres;
+
+  constexpr size_t maxVertices = size_t(1) << nd;
+  coord_t boxSize[nd];
+  coord_t minBoxVal[nd];
+  for (size_t d = 0; d < nd; ++d) {
+    boxSize[d] = static_cast<coord_t>(m_SubBoxSize[d]);
+    minBoxVal[d] = static_cast<coord_t>(this->extents[d].getMin());
+  }
+  const double boxRadius = std::sqrt(diagonalSquared);
+  // A sphere can only reach a box if its centre is within the largest radius
+  // (plus the box radius) of the box along the first dimension
+  double maxRadius = 0.0;
+  for (const size_t index : active)
+    maxRadius = std::max(maxRadius, static_cast<double>(std::sqrt(spheres[index].radiusSquared)));
+  const auto firstCoordinateLess = [&spheres](const size_t index, const double value) {
+    return spheres[index].center[0] < value;
+  };
+
+  size_t boxIndex[nd];
+  coord_t vertexCoord[maxVertices][nd];
+  coord_t boxCenter[nd];
+  for (size_t bIndex = 0; bIndex < numBoxes; ++bIndex) {
+    // Vertices of the child box, computed as in integrateSphere()
+    for (size_t d = 0; d < nd; ++d)
+      boxIndex[d] = (bIndex / splitCumul[d]) % split[d];
+    for (size_t vertex = 0; vertex < maxVertices; ++vertex) {
+      for (size_t d = 0; d < nd; ++d)
+        vertexCoord[vertex][d] = static_cast<coord_t>(boxIndex[d] + ((vertex >> d) & 1)) * boxSize[d] + minBoxVal[d];
+    }
+    const API::IMDNode *box = m_Children[bIndex];
+    box->getCenter(boxCenter);
+    const double low = static_cast<double>(vertexCoord[0][0]) - maxRadius - boxRadius;
+    const double high = static_cast<double>(vertexCoord[maxVertices - 1][0]) + maxRadius + boxRadius;
+
+    auto &selected = childSpheres[bIndex];
+    for (auto it = std::lower_bound(active.cbegin(), active.cend(), low, firstCoordinateLess);
+         it != active.cend() && spheres[*it].center[0] <= high; ++it) {
+      const MDIntegrationSphere &sphere = spheres[*it];
+      const coord_t *peakCenter = sphere.center.data();
+      size_t verticesContained = 0;
+      for (size_t vertex = 0; vertex < maxVertices; ++vertex) {
+        coord_t distanceSquared = 0;
+        for (size_t d = 0; d < nd; ++d) {
+          const coord_t dist = vertexCoord[vertex][d] - peakCenter[d];
+          distanceSquared += dist * dist;
+        }
+        if (distanceSquared < sphere.radiusSquared && distanceSquared > sphere.innerRadiusSquared)
+          ++verticesContained;
+      }
+
+      if (verticesContained >= maxVertices) {
+        // The box is completely enveloped by the sphere
+        signal[*it] += box->getSignal();
+        errorSquared[*it] += box->getErrorSquared();
+        continue;
+      }
+      if (verticesContained == 0) {
+        // Skip the boxes isolated from the sphere or in its hole
+        double distPeakCenterToBoxCenter = 0.0;
+        for (size_t d = 0; d < nd; ++d)
+          distPeakCenterToBoxCenter += (boxCenter[d] - peakCenter[d]) * (boxCenter[d] - peakCenter[d]);
+        distPeakCenterToBoxCenter = std::sqrt(distPeakCenterToBoxCenter);
+        const double peakRadius = std::sqrt(sphere.radiusSquared);
+        const double peakInnerRadius = std::sqrt(sphere.innerRadiusSquared);
+        if (distPeakCenterToBoxCenter - peakRadius > boxRadius)
+          continue;
+        if (peakInnerRadius > 0 && distPeakCenterToBoxCenter + boxRadius < peakInnerRadius)
+          continue;
+      }
+      selected.emplace_back(*it);
+    }
+  }
+  return childSpheres;
+}
+
 //-----------------------------------------------------------------------------------------------
 /** Find the centroid of all events contained within by doing a weighted average
  * of their coordinates.
@@ -0,0 +1,96 @@
+// Mantid Repository : https://github.com/mantidproject/mantid
+//
+// Copyright &copy; 2022 ISIS Rutherford Appleton Laboratory UKRI,
+//   NScD Oak Ridge National Laboratory, European Spallation Source,
+//   Institut Laue - Langevin & CSNS, Institute of High Energy Physics, CAS
+// SPDX - License - Identifier: GPL - 3.0 +
+#pragma once
+
+#include "MantidDataObjects/DllConfig.h"
+#include "MantidGeometry/MDGeometry/MDTypes.h"
+
+#include <vector>
+
+namespace Mantid {
+namespace DataObjects {
+
+// Forward declaration
+class MDHistoWorkspace;
+
+/** An arithmetic expression on MDHistoWorkspaces and scalars that is evaluated
+  in a single pass over the output, e.g.
+
+    (MDHistoExpression(data) / norm - MDHistoExpression(bkgd) / bkgdNorm).evaluateInto(*out);
+
+  Chaining the MDHistoWorkspace operators instead makes one pass over every
+  array per operation and needs a cloned workspace for each intermediate
+  result. Here the bins are taken in blocks small enough to stay in cache, the
+  whole expression is worked out for one block at a time and the blocks are
+  shared between threads.
+
+  Signals, errors and event counts follow exactly the rules of the
+  corresponding MDHistoWorkspace methods (add, subtract, multiply, divide, log,
+  log10, exp and power). Masks are not looked at or changed.
+
+  The expression keeps pointers to the workspaces in it, which must outlive it.
+  The output may be one of the inputs.
+*/
+class MANTID_DATAOBJECTS_DLL MDHistoExpression {
+public:
+  MDHistoExpression(const MDHistoWorkspace &workspace);
+  MDHistoExpression(const signal_t signal, const signal_t error = 0.);
+
+  friend MDHistoExpression operator+(MDHistoExpression lhs, const MDHistoExpression &rhs) {
+    return lhs.combine(Operation::Add, rhs);
+  }
+  friend MDHistoExpression operator-(MDHistoExpression lhs, const MDHistoExpression &rhs) {
+    return lhs.combine(Operation::Subtract, rhs);
+  }
+  friend MDHistoExpression operator*(MDHistoExpression lhs, const MDHistoExpression &rhs) {
+    return lhs.combine(Operation::Multiply, rhs);
+  }
+  friend MDHistoExpression operator/(MDHistoExpression lhs, const MDHistoExpression &rhs) {
+    return lhs.combine(Operation::Divide, rhs);
+  }
+
+  MDHistoExpression log(const double filler = 0.0) const;
+  MDHistoExpression log10(const double filler = 0.0) const;
+  MDHistoExpression exp() const;
+  MDHistoExpression power(const double exponent) const;
+
+  /// @return true if no workspace appears in the expression
+  bool isScalar() const { return m_isScalar; }
+
+  void evaluateInto(MDHistoWorkspace &out) const;
+
+  /// Number of bins worked out together
+  static constexpr size_t BLOCK_SIZE = 1024;
+
+private:
+  enum class Operation { Workspace, Scalar, Add, Subtract, Multiply, Divide, Log, Log10, Exp, Power };
+
+  /// One step of the expression in reverse Polish order
+  struct Step {
+    Operation operation;
+    /// Operand of Workspace
+    const MDHistoWorkspace *workspace;
+    /// Signal of Scalar, filler of Log and Log10 or exponent of Power
+    signal_t value;
+    /// Error squared of Scalar
+    signal_t errorSquared;
+    /// Set for a binary operation whose left operand is a scalar
+    bool lhsIsScalar;
+  };
+
+  MDHistoExpression &combine(const Operation operation, const MDHistoExpression &rhs);
+  MDHistoExpression apply(const Operation operation, const double parameter) const;
+  void evaluateBlock(const size_t begin, const size_t size, signal_t *registers) const;
+
+  std::vector<Step> m_steps;
+  /// Number of intermediate results held at once while evaluating
+  size_t m_depth;
+  bool m_isScalar;
+};
+
+} // namespace DataObjects
+} // namespace Mantid
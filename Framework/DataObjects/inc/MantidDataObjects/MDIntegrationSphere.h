@@ -0,0 +1,33 @@
+// Mantid Repository : https://github.com/mantidproject/mantid
+//
+// Copyright &copy; 2022 ISIS Rutherford Appleton Laboratory UKRI,
+//   NScD Oak Ridge National Laboratory, European Spallation Source,
+//   Institut Laue - Langevin & CSNS, Institute of High Energy Physics, CAS
+// SPDX - License - Identifier: GPL - 3.0 +
+#pragma once
+
+#include "MantidGeometry/MDGeometry/MDTypes.h"
+
+#include <vector>
+
+namespace Mantid {
+namespace DataObjects {
+
+/** A sphere, or spherical shell, integrated together with many others by
+ * MDBoxBase::integrateSpheres(). The fields have the meaning of the arguments
+ * of MDBoxBase::integrateSphere() with a CoordTransformDistance using every
+ * dimension.
+ */
+struct MDIntegrationSphere {
+  /// Centre, with one coordinate for each dimension of the workspace
+  std::vector<coord_t> center;
+  /// Events closer to the centre than this (squared) are integrated
+  coord_t radiusSquared;
+  /// Events no further from the centre than this (squared) are left out
+  coord_t innerRadiusSquared;
+  /// Leave out the top 1% of the signals in a shell
+  bool useOnePercentBackgroundCorrection;
+};
+
+} // namespace DataObjects
+} // namespace Mantid
@@ -33,8 +33,8 @@ std::string BoxControllerNeXusIO::g_DBDataName("free_space_blocks");
 */
 BoxControllerNeXusIO::BoxControllerNeXusIO(API::BoxController *const bc)
     : m_File(nullptr), m_ReadOnly(true), m_dataChunk(DATA_CHUNK), m_bc(bc), m_BlockStart(2, 0), m_BlockSize(2, 0),
-      m_CoordSize(sizeof(coord_t)), m_EventType(FatEvent), m_EventsVersion("1.0"),
-      m_EventDataVersion(EventDataVersion::EDVGoniometer), m_ReadConversion(noConversion) {
+      m_CoordSize(sizeof(coord_t)), m_EventType(FatEvent), m_EventsVersion("1.0"), m_ColumnsVersion("2.0"),
+      m_compressColumns(false), m_EventDataVersion(EventDataVersion::EDVGoniometer), m_ReadConversion(noConversion) {
   m_BlockSize[1] = 5 + m_bc->getNDims();
 
   std::copy(std::cbegin(EventHeaders), std::cend(EventHeaders), std::back_inserter(m_EventsTypeHeaders));
@@ -172,7 +172,7 @@ void BoxControllerNeXusIO::CreateEventGroup() {
 
   try {
     m_File->makeGroup(g_EventGroupName, "NXdata", true);
-    m_File->putAttr("version", m_EventsVersion);
+    m_File->putAttr("version", m_compressColumns ? m_ColumnsVersion : m_EventsVersion);
   } catch (...) {
     throw Kernel::Exception::FileError("Can not create new NXdata group: " + g_EventGroupName, m_fileName);
   }
@@ -186,7 +186,11 @@ void BoxControllerNeXusIO::OpenAndCheckEventGroup() {
   std::string fileGroupVersion;
   m_File->getAttr("version", fileGroupVersion);
 
-  if (fileGroupVersion != m_EventsVersion)
+  if (fileGroupVersion == m_EventsVersion)
+    m_compressColumns = false;
+  else if (fileGroupVersion == m_ColumnsVersion)
+    m_compressColumns = true;
+  else
     throw Kernel::Exception::FileError("Trying to open existing data grop to write new event data but the "
                                        "group with differetn version: " +
                                            fileGroupVersion + " already exists ",
@@ -196,12 +200,20 @@ void BoxControllerNeXusIO::OpenAndCheckEventGroup() {
 void BoxControllerNeXusIO::prepareNxSToWrite_CurVersion() {
 
   // Are data already there?
-  std::string EventData("event_data");
+  std::string EventData = m_compressColumns ? columnNames().front() : "event_data";
   std::map<std::string, std::string> groupEntries;
   m_File->getEntries(groupEntries);
   if (groupEntries.find(EventData) != groupEntries.end()) // yes, open it
   {
     prepareNxSdata_CurVersion();
+  } else if (m_compressColumns) // no, create a column for each event field
+  {
+    std::vector<int64_t> dims(1, NX_UNLIMITED);
+    std::vector<int64_t> chunk(1, static_cast<int64_t>(m_dataChunk));
+    for (const auto &name : columnNames())
+      m_File->makeCompData(name, m_CoordSize == 4 ? ::NeXus::FLOAT32 : ::NeXus::FLOAT64, dims, ::NeXus::LZW, chunk);
+    m_File->putAttr("description", m_EventsTypeHeaders[m_EventType]);
+    this->setFileLength(0);
   } else // no, create it
   {
     // Prepare the event data array for writing operations:
@@ -227,8 +239,8 @@ void BoxControllerNeXusIO::prepareNxSToWrite_CurVersion() {
 /** Open the NXS data blocks for loading/saving.
  * The data should have been created before.     */
 void BoxControllerNeXusIO::prepareNxSdata_CurVersion() {
-  // Open the data
-  m_File->openData("event_data");
+  // Open the data. Columns are only opened while they are read or written.
+  m_File->openData(m_compressColumns ? columnNames().front() : "event_data");
   // There are rummors that this is faster. Not sure if it is important
   //      int type = ::NeXus::FLOAT32;
   //      int rank = 0;
@@ -252,8 +264,14 @@ void BoxControllerNeXusIO::prepareNxSdata_CurVersion() {
     throw Kernel::Exception::FileError("Unknown events data format ", m_fileName);
   }
 
-  auto ndim2 = static_cast<size_t>(info.dims[1]); // number of columns
-  setEventDataVersion(ndim2 - m_bc->getNDims());
+  if (m_compressColumns) {
+    // Columns are only written in the current version for the event type
+    m_File->closeData();
+    setEventDataVersion(m_EventType == LeanEvent ? EventDataVersion::EDVLean : EventDataVersion::EDVGoniometer);
+  } else {
+    auto ndim2 = static_cast<size_t>(info.dims[1]); // number of columns
+    setEventDataVersion(ndim2 - m_bc->getNDims());
+  }
 
   // HACK -- there is no difference between empty event dataset and the dataset
   // with 1 event.
@@ -263,6 +281,20 @@ void BoxControllerNeXusIO::prepareNxSdata_CurVersion() {
   uint64_t nFilePoints = info.dims[0];
   this->setFileLength(nFilePoints);
 }
+/**@return the names of the datasets holding each event field when the events
+ * are stored in columns, in the order of the fields in a data block */
+std::vector<std::string> BoxControllerNeXusIO::columnNames() const {
+  std::vector<std::string> names{"signal", "error_squared"};
+  if (m_EventType == FatEvent) {
+    names.emplace_back("exp_info_index");
+    names.emplace_back("goniometer_index");
+    names.emplace_back("detector_id");
+  }
+  for (size_t d = 0; d < m_bc->getNDims(); ++d)
+    names.emplace_back("center_" + std::to_string(d));
+  return names;
+}
+
 /** Load free space blocks from the data file or create the NeXus place to
  * read/write them*/
 void BoxControllerNeXusIO::getDiskBufferFileData() {
@@ -307,6 +339,26 @@ void BoxControllerNeXusIO::saveGenericBlock(const std::vector<Type> &DataBlock,
   start[0] = int64_t(blockPosition);
   dims[0] = int64_t(DataBlock.size() / this->getNDataColums());
 
+  if (m_compressColumns) {
+    if (dims[0] == 0)
+      return;
+    // Write each field of the events to its own column
+    const auto nColumns = static_cast<size_t>(dims[1]);
+    std::vector<int64_t> columnStart(1, start[0]), columnSize(1, dims[0]);
+    std::vector<Type> column(static_cast<size_t>(dims[0]));
+    const auto names = columnNames();
+    for (size_t c = 0; c < nColumns; ++c) {
+      for (size_t i = 0; i < column.size(); ++i)
+        column[i] = DataBlock[i * nColumns + c];
+      m_File->openData(names[c]);
+      m_File->putSlab<Type>(column, columnStart, columnSize);
+      m_File->closeData();
+    }
+    if (blockPosition + dims[0] > this->getFileLength())
+      this->setFileLength(blockPosition + dims[0]);
+    return;
+  }
+
   // ugly cast but why would putSlab change the data?. This is NeXus bug which
   // makes putSlab method non-constant
   auto &mData = const_cast<std::vector<Type> &>(DataBlock);
@@ -489,6 +541,23 @@ void BoxControllerNeXusIO::loadGenericBlock(std::vector<Type> &Block, const uint
   std::lock_guard<std::mutex> _lock(m_fileMutex);
 
   Block.resize(size[0] * size[1]);
+  if (m_compressColumns) {
+    // Read each field of the events from its own column
+    if (nPoints == 0)
+      return;
+    const auto nColumns = static_cast<size_t>(size[1]);
+    std::vector<int64_t> columnStart(1, start[0]), columnSize(1, size[0]);
+    std::vector<Type> column(nPoints);
+    const auto names = columnNames();
+    for (size_t c = 0; c < nColumns; ++c) {
+      m_File->openData(names[c]);
+      m_File->getSlab(&column[0], columnStart, columnSize);
+      m_File->closeData();
+      for (size_t i = 0; i < nPoints; ++i)
+        Block[i * nColumns + c] = column[i];
+    }
+    return;
+  }
   m_File->getSlab(&Block[0], start, size);
 
   adjustEventDataBlock(Block, "READ"); // insert goniometer info if necessary
@@ -563,8 +632,9 @@ void BoxControllerNeXusIO::closeFile() {
     // lock file
     std::lock_guard<std::mutex> _lock(m_fileMutex);
 
-    m_File->closeData(); // close events data
-    if (!m_ReadOnly)     // write free space groups from the disk buffer
+    if (!m_compressColumns)
+      m_File->closeData(); // close events data
+    if (!m_ReadOnly)       // write free space groups from the disk buffer
     {
       std::vector<uint64_t> freeSpaceBlocks;
       this->getFreeSpaceVector(freeSpaceBlocks);
@@ -18,7 +18,9 @@
 // qualifier applied to function type has no meaning; ignored
 #pragma warning(disable : 4180)
 #endif
+#include "tbb/parallel_for.h"
 #include "tbb/parallel_sort.h"
+#include "tbb/task_arena.h"
 #ifdef _MSC_VER
 #pragma warning(default : 4180)
 #endif
@@ -26,6 +28,7 @@
 #include <algorithm>
 #include <cfloat>
 #include <cmath>
+#include <cstring>
 #include <functional>
 #include <limits>
 #include <stdexcept>
@@ -83,6 +86,335 @@ public:
     return (tAtSample1 < tAtSample2);
   }
 };
+
+/// Number of bits of the sort key handled by each radix sort pass
+constexpr unsigned RADIX_BITS = 11;
+/// Number of buckets in each radix sort pass
+constexpr size_t RADIX_SIZE = size_t{1} << RADIX_BITS;
+/// Number of radix sort passes for a 64 bit key
+constexpr size_t RADIX_PASSES = (64 + RADIX_BITS - 1) / RADIX_BITS;
+/// Below this number of events a comparison sort is used instead
+constexpr size_t RADIX_SORT_MIN_EVENTS = 4096;
+/// Minimum number of events handled by each thread in a radix sort
+constexpr size_t RADIX_SORT_EVENTS_PER_THREAD = 65536;
+/// Largest scratch buffer of a radix sort, which needs a second copy of the
+/// events; larger lists are sorted in place instead
+constexpr size_t RADIX_SORT_MAX_SCRATCH_BYTES = 128 * 1024 * 1024;
+
+/// @return an unsigned key that sorts in the same order as the time-of-flight
+inline uint64_t tofKey(const double tof) {
+  // Adding zero turns -0 into +0, which compare equal
+  const double value = tof + 0.;
+  uint64_t bits;
+  std::memcpy(&bits, &value, sizeof(bits));
+  // Negative numbers sort backwards, so flip all their bits. For positive
+  // numbers only the sign bit is flipped to put them after the negative ones.
+  constexpr uint64_t signBit = uint64_t{1} << 63;
+  return (bits & signBit) ? ~bits : bits | signBit;
+}
+
+/// @return an unsigned key that sorts in the same order as the pulse time
+inline uint64_t pulseTimeKey(const DateAndTime &pulseTime) {
+  return static_cast<uint64_t>(pulseTime.totalNanoseconds()) ^ (uint64_t{1} << 63);
+}
+
+/// The digit counts of a radix sort
+struct RadixSortCounts {
+  /// Count of each digit of each pass in each chunk
+  std::vector<size_t> counts;
+  /// Count of each digit of each pass over all the chunks
+  std::vector<size_t> totals;
+  /// Where each chunk writes the events with each digit
+  std::vector<size_t> offsets;
+};
+
+/// @return the spare radix sort counts of this thread, kept so that repeated
+/// sorts do not allocate them
+RadixSortCounts &spareRadixSortCounts() {
+  static thread_local RadixSortCounts spare;
+  return spare;
+}
+
+/// @return true if a list of events of type T is radix sorted: it is large
+/// enough to gain from it and small enough for its scratch copy
+template <class T> bool useRadixSort(const std::vector<T> &events) {
+  return events.size() >= RADIX_SORT_MIN_EVENTS && events.size() * sizeof(T) <= RADIX_SORT_MAX_SCRATCH_BYTES;
+}
+
+/**
+ * Stable least-significant-digit radix sort of events on a 64 bit key.
+ * The events are split into chunks which are counted and scattered in
+ * parallel in each pass. Passes in which all events share the same digit
+ * are skipped, so keys that only span a small range take fewer passes.
+ * @param events :: the events to sort
+ * @param key :: function returning the unsigned sort key of an event
+ */
+template <class T, class KeyFunction> void radixSort(std::vector<T> &events, const KeyFunction &key) {
+  const size_t numEvents = events.size();
+  const auto maxThreads = static_cast<size_t>(std::max(tbb::this_task_arena::max_concurrency(), 1));
+  const size_t numChunks = std::max(size_t{1}, std::min(maxThreads, numEvents / RADIX_SORT_EVENTS_PER_THREAD));
+  const size_t chunkSize = (numEvents + numChunks - 1) / numChunks;
+  const auto chunkBegin = [chunkSize](const size_t chunk) { return chunk * chunkSize; };
+  const auto chunkEnd = [chunkSize, numEvents](const size_t chunk) {
+    return std::min(numEvents, (chunk + 1) * chunkSize);
+  };
+
+  // Take the spare counts rather than using them in place: while this thread
+  // waits in a parallel_for below TBB may run another sort on it, e.g. from the
+  // outer loop of EventWorkspace::sortAll, which must not share them.
+  RadixSortCounts tables(std::move(spareRadixSortCounts()));
+  auto &counts = tables.counts;
+  auto &totals = tables.totals;
+  auto &offsets = tables.offsets;
+
+  // Count the digits of every pass in one read of the events. These totals do
+  // not depend on the order of the events so are valid for all passes.
+  counts.assign(numChunks * RADIX_PASSES * RADIX_SIZE, 0);
+  tbb::parallel_for(size_t{0}, numChunks, [&](const size_t chunk) {
+    auto *chunkCounts = counts.data() + chunk * RADIX_PASSES * RADIX_SIZE;
+    for (size_t i = chunkBegin(chunk); i < chunkEnd(chunk); ++i) {
+      const uint64_t k = key(events[i]);
+      for (size_t pass = 0; pass < RADIX_PASSES; ++pass)
+        ++chunkCounts[pass * RADIX_SIZE + ((k >> (pass * RADIX_BITS)) & (RADIX_SIZE - 1))];
+    }
+  });
+  totals.assign(RADIX_PASSES * RADIX_SIZE, 0);
+  for (size_t chunk = 0; chunk < numChunks; ++chunk) {
+    const auto *chunkCounts = counts.data() + chunk * RADIX_PASSES * RADIX_SIZE;
+    std::transform(totals.cbegin(), totals.cend(), chunkCounts, totals.begin(), std::plus<size_t>());
+  }
+
+  // The scratch copy is freed at the end, not kept for the next sort
+  std::vector<T> scratch(numEvents);
+  offsets.resize(numChunks * RADIX_SIZE);
+  bool sortedIntoScratch = false;
+  for (size_t pass = 0; pass < RADIX_PASSES; ++pass) {
+    const auto *passTotals = totals.data() + pass * RADIX_SIZE;
+    if (std::find(passTotals, passTotals + RADIX_SIZE, numEvents) != passTotals + RADIX_SIZE)
+      continue; // all events have the same digit
+    const auto shift = static_cast<unsigned>(pass * RADIX_BITS);
+    const std::vector<T> &source = sortedIntoScratch ? scratch : events;
+    std::vector<T> &destination = sortedIntoScratch ? events : scratch;
+
+    // The events have moved since the first count, so count again per chunk
+    if (numChunks > 1) {
+      tbb::parallel_for(size_t{0}, numChunks, [&](const size_t chunk) {
+        auto *chunkCounts = counts.data() + chunk * RADIX_SIZE;
+        std::fill(chunkCounts, chunkCounts + RADIX_SIZE, 0);
+        for (size_t i = chunkBegin(chunk); i < chunkEnd(chunk); ++i)
+          ++chunkCounts[(key(source[i]) >> shift) & (RADIX_SIZE - 1)];
+      });
+    } else {
+      std::copy(passTotals, passTotals + RADIX_SIZE, counts.begin());
+    }
+    // Where each chunk writes the events with each digit
+    size_t offset = 0;
+    for (size_t digit = 0; digit < RADIX_SIZE; ++digit) {
+      for (size_t chunk = 0; chunk < numChunks; ++chunk) {
+        offsets[chunk * RADIX_SIZE + digit] = offset;
+        offset += counts[chunk * RADIX_SIZE + digit];
+      }
+    }
+    tbb::parallel_for(size_t{0}, numChunks, [&](const size_t chunk) {
+      auto *chunkOffsets = offsets.data() + chunk * RADIX_SIZE;
+      for (size_t i = chunkBegin(chunk); i < chunkEnd(chunk); ++i)
+        destination[chunkOffsets[(key(source[i]) >> shift) & (RADIX_SIZE - 1)]++] = source[i];
+    });
+    sortedIntoScratch = !sortedIntoScratch;
+  }
+
+  if (sortedIntoScratch)
+    events.swap(scratch);
+  spareRadixSortCounts() = std::move(tables);
+}
+
+/// Sort events by time-of-flight, using a radix sort for large lists
+template <class T> void sortEventsByTof(std::vector<T> &events) {
+  if (!useRadixSort(events))
+    tbb::parallel_sort(events.begin(), events.end());
+  else
+    radixSort(events, [](const T &event) { return tofKey(event.tof()); });
+}
+
+/**
+ * Sort events by pulse time, using a radix sort for large lists
+ * @param events :: the events to sort
+ * @param comparator :: comparison used for small lists
+ * @param withTof :: if true, sort events with the same pulse time by
+ * time-of-flight
+ */
+template <class T, class Comparator>
+void sortEventsByPulseTime(std::vector<T> &events, const Comparator &comparator, const bool withTof) {
+  if (!useRadixSort(events)) {
+    tbb::parallel_sort(events.begin(), events.end(), comparator);
+    return;
+  }
+  // The radix sort is stable, so sorting by the least significant key first
+  // gives the combined order
+  if (withTof)
+    radixSort(events, [](const T &event) { return tofKey(event.tof()); });
+  radixSort(events, [](const T &event) { return pulseTimeKey(event.pulseTime()); });
+}
+
+/**
+ * Find the first event with a pulse time not before the given time. The
+ * events must be sorted by pulse time. The search gallops forward from the
+ * start of the range before bisecting, so walking a sorted splitter through a
+ * list costs a number of comparisons logarithmic in the distance skipped
+ * rather than one per event.
+ * @param first :: start of the range to search
+ * @param last :: end of the range to search
+ * @param time :: the pulse time to seek
+ * @return iterator to the first event with pulse time >= time, or last
+ */
+template <class Iter> Iter seekPulseTime(Iter first, Iter last, const DateAndTime &time) {
+  const auto before = [&time](const auto &event) { return event.pulseTime() < time; };
+  if (first == last || !before(*first))
+    return first;
+  typename std::iterator_traits<Iter>::difference_type step = 1;
+  while (step < last - first && before(first[step])) {
+    first += step;
+    step *= 2;
+  }
+  const Iter bound = step < last - first ? first + step + 1 : last;
+  return std::partition_point(first + 1, bound, before);
+}
+
+/**
+ * Append a contiguous range of events to an output list holding events of
+ * the same type.
+ * @param output :: the list to append to
+ * @param first :: start of the range to copy
+ * @param last :: end of the range to copy
+ */
+template <class T, class Iter> void appendEvents(EventList *output, Iter first, Iter last) {
+  if (first == last)
+    return;
+  std::vector<T> *outputEvents;
+  getEventsFrom(*output, outputEvents);
+  outputEvents->insert(outputEvents->end(), first, last);
+  output->setSortOrder(UNSORTED);
+}
+
+/**
+ * Finds the bin of a value directly from linear or logarithmic bin edges,
+ * without searching through them. The arithmetic only gives a first guess of
+ * the bin, which is then checked against the actual bin edges, so rounding
+ * errors and a final bin of a different width (as made by Rebin) do not
+ * matter. As each value is binned independently, the events do not need to be
+ * sorted.
+ */
+class RegularBinFinder {
+public:
+  /// Relative tolerance on the bin widths to accept the edges as regular
+  static constexpr double TOLERANCE = 1e-6;
+
+  explicit RegularBinFinder(const MantidVec &X) : m_x(X), m_numBins(X.size() > 1 ? X.size() - 1 : 0) {
+    if (m_numBins == 0)
+      return;
+    m_xMin = X.front();
+    m_xMax = X.back();
+    // The last bin edge is not checked as it may have been clipped
+    const size_t numChecked = m_numBins > 1 ? m_numBins - 1 : m_numBins;
+    if (isLinear(numChecked)) {
+      m_scale = 1. / (X[1] - X[0]);
+    } else if (isLogarithmic(numChecked)) {
+      m_logarithmic = true;
+      m_scale = 1. / std::log(X[1] / X[0]);
+    }
+    m_valid = m_scale > 0. && std::isfinite(m_scale) && std::isfinite(m_xMin);
+  }
+
+  /// @return true if the bin edges are linear or logarithmic
+  explicit operator bool() const { return m_valid; }
+
+  /// @return true if the value is within the range of the bin edges
+  inline bool inRange(const double x) const { return x >= m_xMin && x < m_xMax; }
+
+  /**
+   * @param x :: value within the range of the bin edges
+   * @return the index of the bin the value falls into
+   */
+  inline size_t bin(const double x) const {
+    double guess = m_logarithmic ? std::log(x / m_xMin) * m_scale : (x - m_xMin) * m_scale;
+    guess = std::min(std::max(guess, 0.), static_cast<double>(m_numBins - 1));
+    auto index = static_cast<size_t>(guess);
+    while (x < m_x[index])
+      --index;
+    while (x >= m_x[index + 1])
+      ++index;
+    return index;
+  }
+
+private:
+  bool isLinear(const size_t numChecked) const {
+    const double width = m_x[1] - m_x[0];
+    if (!(width > 0.))
+      return false;
+    for (size_t i = 1; i < numChecked; ++i) {
+      if (!(std::abs(m_x[i + 1] - m_x[i] - width) <= TOLERANCE * width))
+        return false;
+    }
+    return true;
+  }
+
+  bool isLogarithmic(const size_t numChecked) const {
+    if (!(m_x[0] > 0.) || !(m_x[1] > m_x[0]))
+      return false;
+    const double ratio = m_x[1] / m_x[0];
+    for (size_t i = 1; i < numChecked; ++i) {
+      const double expected = m_x[i] * ratio;
+      if (!(std::abs(m_x[i + 1] - expected) <= TOLERANCE * (expected - m_x[i])))
+        return false;
+    }
+    return true;
+  }
+
+  const MantidVec &m_x;
+  const size_t m_numBins;
+  double m_xMin{0.};
+  double m_xMax{0.};
+  double m_scale{0.};
+  bool m_logarithmic{false};
+  bool m_valid{false};
+};
+
+/**
+ * Fill the counts histogram of unweighted events using bin edges that a
+ * RegularBinFinder can handle.
+ * @param events :: the events to histogram, in any order
+ * @param binFinder :: finder for the bin edges
+ * @param Y :: the generated counts histogram, one entry per bin
+ */
+template <class T>
+void countsForRegularBins(const std::vector<T> &events, const RegularBinFinder &binFinder, MantidVec &Y) {
+  for (const auto &event : events) {
+    const double tof = event.tof();
+    if (binFinder.inRange(tof))
+      ++Y[binFinder.bin(tof)];
+  }
+}
+
+/**
+ * Fill the histogram of weighted events using bin edges that a
+ * RegularBinFinder can handle.
+ * @param events :: the events to histogram, in any order
+ * @param binFinder :: finder for the bin edges
+ * @param Y :: the generated weights histogram, one entry per bin
+ * @param E :: the generated squared errors histogram, one entry per bin
+ */
+template <class T>
+void weightsForRegularBins(const std::vector<T> &events, const RegularBinFinder &binFinder, MantidVec &Y,
+                           MantidVec &E) {
+  for (const auto &event : events) {
+    const double tof = event.tof();
+    if (binFinder.inRange(tof)) {
+      const size_t bin = binFinder.bin(tof);
+      Y[bin] += double(event.m_weight);
+      E[bin] += double(event.m_errorSquared); // square of error
+    }
+  }
+}
 } // namespace
 //==========================================================================
 /// --------------------- TofEvent Comparators
@@ -139,7 +471,7 @@ struct comparePulseTimeTOFDelta {
 // EventWorkspace is always histogram data and so is thus EventList
 EventList::EventList()
     : m_histogram(HistogramData::Histogram::XMode::BinEdges, HistogramData::Histogram::YMode::Counts), eventType(TOF),
-      order(UNSORTED), mru(nullptr) {}
+      order(UNSORTED), mru(nullptr), m_mruGeneration(EventWorkspaceMRU::nextGeneration()) {}
 
 /** Constructor with a MRU list
  * @param mru :: pointer to the MRU of the parent EventWorkspace
@@ -148,11 +480,13 @@ EventList::EventList()
 EventList::EventList(EventWorkspaceMRU *mru, specnum_t specNo)
     : IEventList(specNo),
       m_histogram(HistogramData::Histogram::XMode::BinEdges, HistogramData::Histogram::YMode::Counts), eventType(TOF),
-      order(UNSORTED), mru(mru) {}
+      order(UNSORTED), mru(mru), m_mruGeneration(EventWorkspaceMRU::nextGeneration()) {}
 
 /** Constructor copying from an existing event list
  * @param rhs :: EventList object to copy*/
-EventList::EventList(const EventList &rhs) : IEventList(rhs), m_histogram(rhs.m_histogram), mru{nullptr} {
+EventList::EventList(const EventList &rhs)
+    : IEventList(rhs), m_histogram(rhs.m_histogram), mru{nullptr},
+      m_mruGeneration(EventWorkspaceMRU::nextGeneration()) {
   // Note that operator= also assigns m_histogram, but the above use of the copy
   // constructor avoid a memory allocation and is thus faster.
   this->operator=(rhs);
@@ -162,7 +496,7 @@ EventList::EventList(const EventList &rhs) : IEventList(rhs), m_histogram(rhs.m_
  * @param events :: Vector of TofEvent's */
 EventList::EventList(const std::vector<TofEvent> &events)
     : m_histogram(HistogramData::Histogram::XMode::BinEdges, HistogramData::Histogram::YMode::Counts), eventType(TOF),
-      mru(nullptr) {
+      mru(nullptr), m_mruGeneration(EventWorkspaceMRU::nextGeneration()) {
   this->events.assign(events.begin(), events.end());
   this->eventType = TOF;
   this->order = UNSORTED;
@@ -171,7 +505,8 @@ EventList::EventList(const std::vector<TofEvent> &events)
 /** Constructor, taking a vector of events.
  * @param events :: Vector of WeightedEvent's */
 EventList::EventList(const std::vector<WeightedEvent> &events)
-    : m_histogram(HistogramData::Histogram::XMode::BinEdges, HistogramData::Histogram::YMode::Counts), mru(nullptr) {
+    : m_histogram(HistogramData::Histogram::XMode::BinEdges, HistogramData::Histogram::YMode::Counts), mru(nullptr),
+      m_mruGeneration(EventWorkspaceMRU::nextGeneration()) {
   this->weightedEvents.assign(events.begin(), events.end());
   this->eventType = WEIGHTED;
   this->order = UNSORTED;
@@ -180,7 +515,8 @@ EventList::EventList(const std::vector<WeightedEvent> &events)
 /** Constructor, taking a vector of events.
  * @param events :: Vector of WeightedEventNoTime's */
 EventList::EventList(const std::vector<WeightedEventNoTime> &events)
-    : m_histogram(HistogramData::Histogram::XMode::BinEdges, HistogramData::Histogram::YMode::Counts), mru(nullptr) {
+    : m_histogram(HistogramData::Histogram::XMode::BinEdges, HistogramData::Histogram::YMode::Counts), mru(nullptr),
+      m_mruGeneration(EventWorkspaceMRU::nextGeneration()) {
   this->weightedEventsNoTime.assign(events.begin(), events.end());
   this->eventType = WEIGHTED_NOTIME;
   this->order = UNSORTED;
@@ -311,6 +647,7 @@ EventList &EventList::operator=(const EventList &rhs) {
   // the EventWorkspace that posseses the EventList has already configured the mru
   IEventList::operator=(rhs);
   m_histogram = rhs.m_histogram;
+  invalidateMRU();
   events = rhs.events;
   weightedEvents = rhs.weightedEvents;
   weightedEventsNoTime = rhs.weightedEventsNoTime;
@@ -845,8 +1182,7 @@ const std::vector<WeightedEventNoTime> &EventList::getWeightedEventsNoTime() con
  * associated detector ID's.
  * */
 void EventList::clear(const bool removeDetIDs) {
-  if (mru)
-    mru->deleteIndex(this);
+  invalidateMRU();
   this->events.clear();
   std::vector<TofEvent>().swap(this->events); // STL Trick to release memory
   this->weightedEvents.clear();
@@ -885,6 +1221,11 @@ void EventList::clearData() { this->clear(false); }
  */
 void EventList::setMRU(EventWorkspaceMRU *newMRU) { mru = newMRU; }
 
+/** Give the list a new generation so that any histograms cached in the MRU
+ * lists of any thread are treated as out of date.
+ */
+void EventList::invalidateMRU() { m_mruGeneration = EventWorkspaceMRU::nextGeneration(); }
+
 /** Reserve a certain number of entries in event list of the specified eventType
  *
  * Calls std::vector<>::reserve() in order to pre-allocate the length of the
@@ -943,7 +1284,7 @@ void EventList::sort(const EventSortType order) const {
 void EventList::setSortOrder(const EventSortType order) const { this->order = order; }
 
 // --------------------------------------------------------------------------
-/** Sort events by TOF in one thread */
+/** Sort events by TOF. Large lists are radix sorted in parallel. */
 void EventList::sortTof() const {
   // nothing to do
   if (this->order == TOF_SORT)
@@ -957,13 +1298,13 @@ void EventList::sortTof() const {
 
   switch (eventType) {
   case TOF:
-    tbb::parallel_sort(events.begin(), events.end());
+    sortEventsByTof(events);
     break;
   case WEIGHTED:
-    tbb::parallel_sort(weightedEvents.begin(), weightedEvents.end());
+    sortEventsByTof(weightedEvents);
     break;
   case WEIGHTED_NOTIME:
-    tbb::parallel_sort(weightedEventsNoTime.begin(), weightedEventsNoTime.end());
+    sortEventsByTof(weightedEventsNoTime);
     break;
   }
   // Save the order to avoid unnecessary re-sorting.
@@ -1024,10 +1365,10 @@ void EventList::sortPulseTime() const {
   // Perform sort.
   switch (eventType) {
   case TOF:
-    tbb::parallel_sort(events.begin(), events.end(), compareEventPulseTime);
+    sortEventsByPulseTime(events, compareEventPulseTime, false);
     break;
   case WEIGHTED:
-    tbb::parallel_sort(weightedEvents.begin(), weightedEvents.end(), compareEventPulseTime);
+    sortEventsByPulseTime(weightedEvents, compareEventPulseTime, false);
     break;
   case WEIGHTED_NOTIME:
     // Do nothing; there is no time to sort
@@ -1053,10 +1394,10 @@ void EventList::sortPulseTimeTOF() const {
 
   switch (eventType) {
   case TOF:
-    tbb::parallel_sort(events.begin(), events.end(), compareEventPulseTimeTOF);
+    sortEventsByPulseTime(events, compareEventPulseTimeTOF, true);
     break;
   case WEIGHTED:
-    tbb::parallel_sort(weightedEvents.begin(), weightedEvents.end(), compareEventPulseTimeTOF);
+    sortEventsByPulseTime(weightedEvents, compareEventPulseTimeTOF, true);
     break;
   case WEIGHTED_NOTIME:
     // Do nothing; there is no time to sort
@@ -1208,16 +1549,14 @@ size_t EventList::histogram_size() const {
  */
 void EventList::setX(const Kernel::cow_ptr<HistogramData::HistogramX> &X) {
   m_histogram.setX(X);
-  if (mru)
-    mru->deleteIndex(this);
+  invalidateMRU();
 }
 
 /** Deprecated, use mutableX() instead. Returns a reference to the x data.
  *  @return a reference to the X (bin) vector.
  */
 MantidVec &EventList::dataX() {
-  if (mru)
-    mru->deleteIndex(this);
+  invalidateMRU();
   return m_histogram.dataX();
 }
 
@@ -1310,10 +1649,8 @@ Kernel::cow_ptr<HistogramData::HistogramY> EventList::sharedY() const {
   Kernel::cow_ptr<HistogramData::HistogramY> yData(nullptr);
 
   // Is the data in the mrulist?
-  if (mru) {
-    mru->ensureEnoughBuffersY(thread);
-    yData = mru->findY(thread, this);
-  }
+  if (mru)
+    yData = mru->findY(thread, this, m_mruGeneration);
 
   if (!yData) {
     MantidVec Y;
@@ -1325,10 +1662,9 @@ Kernel::cow_ptr<HistogramData::HistogramY> EventList::sharedY() const {
 
     // Lets save it in the MRU
     if (mru) {
-      mru->insertY(thread, yData, this);
+      mru->insertY(thread, yData, this, m_mruGeneration);
       auto eData = Kernel::make_cow<HistogramData::HistogramE>(std::move(E));
-      mru->ensureEnoughBuffersE(thread);
-      mru->insertE(thread, eData, this);
+      mru->insertE(thread, eData, this, m_mruGeneration);
     }
   }
   return yData;
@@ -1340,10 +1676,8 @@ Kernel::cow_ptr<HistogramData::HistogramE> EventList::sharedE() const {
   Kernel::cow_ptr<HistogramData::HistogramE> eData(nullptr);
 
   // Is the data in the mrulist?
-  if (mru) {
-    mru->ensureEnoughBuffersE(thread);
-    eData = mru->findE(thread, this);
-  }
+  if (mru)
+    eData = mru->findE(thread, this, m_mruGeneration);
 
   if (!eData) {
     // Now use that to get E -- Y values are generated from another function
@@ -1354,7 +1688,7 @@ Kernel::cow_ptr<HistogramData::HistogramE> EventList::sharedE() const {
 
     // Lets save it in the MRU
     if (mru)
-      mru->insertE(thread, eData, this);
+      mru->insertE(thread, eData, this, m_mruGeneration);
   }
   return eData;
 }
@@ -1395,6 +1729,82 @@ inline double calcNorm(const double errorSquared) {
   else
     return 1. / std::sqrt(errorSquared);
 }
+
+/// Sums the events that are compressed into a single event
+struct CompressedEventAccumulator {
+  /// TOF of the first event of the group, which the tolerance is measured from
+  double startTof{0.};
+  /// Sum of TOF weighted by the normalization, for the average TOF
+  double totalTof{0.};
+  double weight{0.};
+  double errorSquared{0.};
+  double normalization{0.};
+  int num{0};
+
+  template <class T> void start(const T &event) {
+    num = 1;
+    startTof = event.tof();
+    const double norm = calcNorm(event.errorSquared());
+    normalization = norm;
+    totalTof = event.tof() * norm;
+    weight = event.weight();
+    errorSquared = event.errorSquared();
+  }
+
+  template <class T> void add(const T &event) {
+    // Carry the error and weight
+    weight += event.weight();
+    errorSquared += event.errorSquared();
+    // Track the average tof
+    num++;
+    const double norm = calcNorm(event.errorSquared());
+    normalization += norm;
+    totalTof += event.tof() * norm;
+  }
+
+  /** Does an event at tof belong to this group?
+   * @param tof :: time-of-flight of the event
+   * @param tolerance :: linear width of a group, or if negative the width
+   * relative to the TOF of the first event of the group
+   */
+  bool accepts(const double tof, const double tolerance) const {
+    if (num == 0)
+      return false;
+    const double width = tolerance >= 0. ? tolerance : -tolerance * std::abs(startTof);
+    return (tof - startTof) <= width;
+  }
+
+  /// Create a new event with the average TOF and summed weights and squared errors.
+  void emit(std::vector<WeightedEventNoTime> &out) const {
+    if (num == 1) {
+      // last time-of-flight is the only one contributing
+      out.emplace_back(startTof, weight, errorSquared);
+    } else if (num > 1) {
+      out.emplace_back(totalTof / normalization, weight, errorSquared);
+    }
+  }
+};
+
+/** Add the events in [first, last) to the open group, emitting each group that
+ * is closed into out.
+ */
+template <class Iterator>
+void compressRange(Iterator first, Iterator last, const double tolerance, CompressedEventAccumulator &group,
+                   std::vector<WeightedEventNoTime> &out) {
+  for (auto it = first; it != last; ++it) {
+    if (group.accepts(it->tof(), tolerance)) {
+      group.add(*it);
+    } else {
+      // We exceeded the tolerance
+      group.emit(out);
+      // Start a new combined object
+      group.start(*it);
+    }
+  }
+}
+
+/// Below this many events per thread, compressing in parallel does not pay off
+constexpr size_t MIN_EVENTS_PER_COMPRESS_BLOCK = 100000;
 } // namespace
 
 // --------------------------------------------------------------------------
@@ -1403,7 +1813,7 @@ inline double calcNorm(const double errorSquared) {
  * @param events :: input event list.
  * @param out :: output WeightedEventNoTime vector.
  * @param tolerance :: how close do two event's TOF have to be to be considered
- *the same.
+ *the same. If negative, the tolerance is relative to the TOF (logarithmic).
  */
 
 template <class T>
@@ -1414,55 +1824,10 @@ inline void EventList::compressEventsHelper(const std::vector<T> &events, std::v
   // We will make a starting guess of 1/20th of the number of input events.
   out.reserve(events.size() / 20);
 
-  // The last TOF to which we are comparing.
-  double lastTof = std::numeric_limits<double>::lowest();
-  // For getting an accurate average TOF
-  double totalTof = 0;
-  int num = 0;
-  // Carrying weight, error, and normalization
-  double weight = 0;
-  double errorSquared = 0;
-  double normalization = 0.;
-
-  for (auto it = events.cbegin(); it != events.cend(); it++) {
-    if ((it->m_tof - lastTof) <= tolerance) {
-      // Carry the error and weight
-      weight += it->weight();
-      errorSquared += it->errorSquared();
-      // Track the average tof
-      num++;
-      const double norm = calcNorm(it->errorSquared());
-      normalization += norm;
-      totalTof += it->m_tof * norm;
-    } else {
-      // We exceeded the tolerance
-      // Create a new event with the average TOF and summed weights and
-      // squared errors.
-      if (num == 1) {
-        // last time-of-flight is the only one contributing
-        out.emplace_back(lastTof, weight, errorSquared);
-      } else if (num > 1) {
-        out.emplace_back(totalTof / normalization, weight, errorSquared);
-      }
-      // Start a new combined object
-      num = 1;
-      const double norm = calcNorm(it->errorSquared());
-      normalization = norm;
-      totalTof = it->m_tof * norm;
-      weight = it->weight();
-      errorSquared = it->errorSquared();
-      lastTof = it->m_tof;
-    }
-  }
-
-  // Put the last event in there too with the average TOF and summed weights and
-  // squared errors.
-  if (num == 1) {
-    // last time-of-flight is the only one contributing
-    out.emplace_back(lastTof, weight, errorSquared);
-  } else if (num > 1) {
-    out.emplace_back(totalTof / normalization, weight, errorSquared);
-  }
+  CompressedEventAccumulator group;
+  compressRange(events.cbegin(), events.cend(), tolerance, group, out);
+  // Put the last event in there too
+  group.emit(out);
 
   // If you have over-allocated by more than 5%, reduce the size.
   size_t excess_limit = out.size() / 20;
@@ -1475,91 +1840,92 @@ inline void EventList::compressEventsHelper(const std::vector<T> &events, std::v
 /** Compress the event list by grouping events with the same TOF.
  * Performs the compression in parallel.
  *
+ * The sorted events are split in one block per thread and each block is
+ * compressed as if a group started at its first event. Where a group really
+ * starts depends on all the events before it, so the blocks are then joined
+ * in order: the group left open by the previous blocks takes the events it
+ * accepts from the start of the block, and the block is compressed again
+ * from there until a group starts at the same event as one found by its
+ * thread. From that group on the output of the thread is used unchanged, so
+ * the result is the same as compressEventsHelper for any number of threads.
+ *
  * @param events :: input event list.
  * @param out :: output WeightedEventNoTime vector.
  * @param tolerance :: how close do two event's TOF have to be to be considered
- *the same.
+ *the same. If negative, the tolerance is relative to the TOF (logarithmic).
  */
 
 template <class T>
 void EventList::compressEventsParallelHelper(const std::vector<T> &events, std::vector<WeightedEventNoTime> &out,
                                              double tolerance) {
-  // Create a local output vector for each thread
-  int numThreads = PARALLEL_GET_MAX_THREADS;
+  const int numThreads = static_cast<int>(
+      std::min(static_cast<size_t>(PARALLEL_GET_MAX_THREADS), events.size() / MIN_EVENTS_PER_COMPRESS_BLOCK));
+  if (numThreads < 2) {
+    compressEventsHelper(events, out, tolerance);
+    return;
+  }
+
+  // Create a local output vector, the index of the first event of each of its
+  // groups and the group left open at the end for each thread
   std::vector<std::vector<WeightedEventNoTime>> outputs(numThreads);
+  std::vector<std::vector<size_t>> groupStarts(numThreads);
+  std::vector<CompressedEventAccumulator> lastGroups(numThreads);
   // This is how many events to process in each thread.
-  size_t numPerBlock = events.size() / numThreads;
+  const size_t numPerBlock = events.size() / numThreads;
+  const auto blockBegin = [numPerBlock](const int thread) { return static_cast<size_t>(thread) * numPerBlock; };
+  const auto blockEnd = [&events, numPerBlock, numThreads](const int thread) {
+    return (thread == numThreads - 1) ? events.size() : static_cast<size_t>(thread + 1) * numPerBlock;
+  };
 
   // Do each block in parallel
   PARALLEL_FOR_NO_WSP_CHECK()
   for (int thread = 0; thread < numThreads; thread++) {
-    // The local output vector
     std::vector<WeightedEventNoTime> &localOut = outputs[thread];
-    // Reserve a bit of space to avoid excess copying
-    localOut.clear();
-    localOut.reserve(numPerBlock / 20);
-
-    // The last TOF to which we are comparing.
-    double lastTof = std::numeric_limits<double>::lowest();
-    // For getting an accurate average TOF
-    double totalTof = 0;
-    int num = 0;
-    // Carrying weight, error, and normalization
-    double weight = 0;
-    double errorSquared = 0;
-    double normalization = 0.;
-
-    // Separate the
-    typename std::vector<T>::const_iterator it = events.begin() + thread * numPerBlock;
-    typename std::vector<T>::const_iterator it_end = events.begin() + (thread + 1) * numPerBlock; // cache for speed
-    if (thread == numThreads - 1)
-      it_end = events.end();
-    for (; it != it_end; ++it) {
-      if ((it->m_tof - lastTof) <= tolerance) {
-        // Carry the error and weight
-        weight += it->weight();
-        errorSquared += it->errorSquared();
-        // Track the average tof
-        num++;
-        const double norm = calcNorm(it->errorSquared());
-        normalization += norm;
-        totalTof += it->m_tof * norm;
+    std::vector<size_t> &starts = groupStarts[thread];
+    localOut.reserve((blockEnd(thread) - blockBegin(thread)) / 20);
+    auto &group = lastGroups[thread];
+    for (size_t i = blockBegin(thread); i < blockEnd(thread); ++i) {
+      if (group.accepts(events[i].tof(), tolerance)) {
+        group.add(events[i]);
       } else {
-        // We exceeded the tolerance
-        if (num > 0) {
-          // Create a new event with the average TOF and summed weights and
-          // squared errors.
-          localOut.emplace_back(totalTof / normalization, weight, errorSquared);
-        }
-        // Start a new combined object
-        num = 1;
-        const double norm = calcNorm(it->errorSquared());
-        normalization = norm;
-        totalTof = it->m_tof * norm;
-        weight = it->weight();
-        errorSquared = it->errorSquared();
-        lastTof = it->m_tof;
+        group.emit(localOut);
+        group.start(events[i]);
+        starts.emplace_back(i);
       }
     }
-
-    // Put the last event in there too.
-    if (num > 0) {
-      // Create a new event with the average TOF and summed weights and squared
-      // errors.
-      localOut.emplace_back(totalTof / normalization, weight, errorSquared);
-    }
   }
 
   // Clear the output. Reserve the required size
   out.clear();
-  size_t numEvents = 0;
-  for (int thread = 0; thread < numThreads; thread++)
-    numEvents += outputs[thread].size();
+  size_t numEvents = static_cast<size_t>(numThreads);
+  for (const auto &localOut : outputs)
+    numEvents += localOut.size();
   out.reserve(numEvents);
 
-  // Re-join all the outputs
-  for (int thread = 0; thread < numThreads; thread++)
-    out.insert(out.end(), outputs[thread].begin(), outputs[thread].end());
+  // Re-join all the outputs in order, continuing the open group into each block
+  CompressedEventAccumulator group;
+  for (int thread = 0; thread < numThreads; thread++) {
+    const auto &starts = groupStarts[thread];
+    for (size_t i = blockBegin(thread); i < blockEnd(thread); ++i) {
+      if (group.accepts(events[i].tof(), tolerance)) {
+        group.add(events[i]);
+        continue;
+      }
+      group.emit(out);
+      const auto start = std::lower_bound(starts.cbegin(), starts.cend(), i);
+      if (start != starts.cend() && *start == i) {
+        // In step with the thread: the rest of its groups are right
+        const auto &localOut = outputs[thread];
+        out.insert(out.end(), localOut.cbegin() + std::distance(starts.cbegin(), start), localOut.cend());
+        group = lastGroups[thread];
+        break;
+      }
+      group.start(events[i]);
+    }
+    std::vector<WeightedEventNoTime>().swap(outputs[thread]);
+    std::vector<size_t>().swap(groupStarts[thread]);
+  }
+  group.emit(out);
 }
 
 template <class T>
@@ -1669,49 +2035,46 @@ inline void EventList::compressFatEventsHelper(const std::vector<T> &events, std
  * The event list will be switched to WeightedEventNoTime.
  *
  * @param tolerance :: how close do two event's TOF have to be to be considered
- *the same.
+ *the same. If negative, |tolerance| is relative to the TOF of the first event
+ *of each group, i.e. the groups are logarithmic.
  * @param destination :: EventList that will receive the compressed events. Can
  *be == this.
+ * @param parallel :: split the compression of this list across threads. Only
+ *worth it for a list holding a large share of the events of a workspace.
  */
-void EventList::compressEvents(double tolerance, EventList *destination) {
+void EventList::compressEvents(double tolerance, EventList *destination, const bool parallel) {
   if (!this->empty()) {
     this->sortTof();
     switch (eventType) {
     case TOF:
-      //      if (parallel)
-      //        compressEventsParallelHelper(this->events,
-      //        destination->weightedEventsNoTime, tolerance);
-      //      else
-      compressEventsHelper(this->events, destination->weightedEventsNoTime, tolerance);
+      if (parallel)
+        compressEventsParallelHelper(this->events, destination->weightedEventsNoTime, tolerance);
+      else
+        compressEventsHelper(this->events, destination->weightedEventsNoTime, tolerance);
       break;
 
     case WEIGHTED:
-      //      if (parallel)
-      //        compressEventsParallelHelper(this->weightedEvents,
-      //        destination->weightedEventsNoTime, tolerance);
-      //      else
-      compressEventsHelper(this->weightedEvents, destination->weightedEventsNoTime, tolerance);
-
+      if (parallel)
+        compressEventsParallelHelper(this->weightedEvents, destination->weightedEventsNoTime, tolerance);
+      else
+        compressEventsHelper(this->weightedEvents, destination->weightedEventsNoTime, tolerance);
       break;
 
     case WEIGHTED_NOTIME:
       if (destination == this) {
         // Put results in a temp output
         std::vector<WeightedEventNoTime> out;
-        //        if (parallel)
-        //          compressEventsParallelHelper(this->weightedEventsNoTime,
-        //          out,
-        //          tolerance);
-        //        else
-        compressEventsHelper(this->weightedEventsNoTime, out, tolerance);
+        if (parallel)
+          compressEventsParallelHelper(this->weightedEventsNoTime, out, tolerance);
+        else
+          compressEventsHelper(this->weightedEventsNoTime, out, tolerance);
         // Put it back
         this->weightedEventsNoTime.swap(out);
       } else {
-        //        if (parallel)
-        //          compressEventsParallelHelper(this->weightedEventsNoTime,
-        //          destination->weightedEventsNoTime, tolerance);
-        //        else
-        compressEventsHelper(this->weightedEventsNoTime, destination->weightedEventsNoTime, tolerance);
+        if (parallel)
+          compressEventsParallelHelper(this->weightedEventsNoTime, destination->weightedEventsNoTime, tolerance);
+        else
+          compressEventsHelper(this->weightedEventsNoTime, destination->weightedEventsNoTime, tolerance);
       }
       break;
     }
@@ -1761,8 +2124,10 @@ void EventList::compressFatEvents(const double tolerance, const Mantid::Types::C
 // --------------------------------------------------------------------------
 /** Utility function:
  * Returns the iterator into events of the first TofEvent with
- * tof() > seek_tof
+ * tof() >= seek_tof
  * Will return events.end() if nothing is found!
+ * The events must be sorted by TOF. A binary search is used so the events
+ * below seek_tof are never read.
  *
  * @param events :: event vector in which to look.
  * @param seek_tof :: tof to find (typically the first bin X[0])
@@ -1770,7 +2135,7 @@ void EventList::compressFatEvents(const double tolerance, const Mantid::Types::C
  */
 template <class T>
 typename std::vector<T>::const_iterator static findFirstEvent(const std::vector<T> &events, T seek_tof) {
-  return std::find_if_not(events.cbegin(), events.cend(), [seek_tof](const T &x) { return x < seek_tof; });
+  return std::lower_bound(events.cbegin(), events.cend(), seek_tof);
 }
 
 // --------------------------------------------------------------------------
@@ -1778,6 +2143,7 @@ typename std::vector<T>::const_iterator static findFirstEvent(const std::vector<
  * Returns the iterator into events of the first TofEvent with
  * pulsetime() > seek_pulsetime
  * Will return events.end() if nothing is found!
+ * The events must be sorted by pulse time.
  *
  * @param events :: event vector in which to look.
  * @param seek_pulsetime :: pulse time to find (typically the first bin X[0])
@@ -1786,15 +2152,9 @@ typename std::vector<T>::const_iterator static findFirstEvent(const std::vector<
 template <class T>
 typename std::vector<T>::const_iterator EventList::findFirstPulseEvent(const std::vector<T> &events,
                                                                        const double seek_pulsetime) {
-  auto itev = events.begin();
-  auto itev_end = events.end(); // cache for speed
-
-  // if tof < X[0], that means that you need to skip some events
-  while ((itev != itev_end) && (static_cast<double>(itev->pulseTime().totalNanoseconds()) < seek_pulsetime))
-    itev++;
-  // Better fix would be to use a binary search instead of the linear one used
-  // here.
-  return itev;
+  return std::partition_point(events.begin(), events.end(), [seek_pulsetime](const T &event) {
+    return static_cast<double>(event.pulseTime().totalNanoseconds()) < seek_pulsetime;
+  });
 }
 
 // --------------------------------------------------------------------------
@@ -1802,6 +2162,7 @@ typename std::vector<T>::const_iterator EventList::findFirstPulseEvent(const std
  * Returns the iterator into events of the first TofEvent with
  * time at sample > seek_time
  * Will return events.end() if nothing is found!
+ * The events must be sorted by time at sample.
  *
  * @param events :: event vector in which to look.
  * @param seek_time :: seek time to find (typically the first bin X[0]). Seek
@@ -1814,30 +2175,40 @@ template <class T>
 typename std::vector<T>::const_iterator
 EventList::findFirstTimeAtSampleEvent(const std::vector<T> &events, const double seek_time, const double &tofFactor,
                                       const double &tofOffset) const {
-  auto itev = events.cbegin();
-  auto itev_end = events.cend(); // cache for speed
-
-  // if tof < X[0], that means that you need to skip some events
-  while ((itev != itev_end) &&
-         (static_cast<double>(calculateCorrectedFullTime(*itev, tofFactor, tofOffset)) < seek_time))
-    itev++;
-  // Better fix would be to use a binary search instead of the linear one used
-  // here.
-  return itev;
+  return std::partition_point(events.cbegin(), events.cend(), [&](const T &event) {
+    return static_cast<double>(calculateCorrectedFullTime(event, tofFactor, tofOffset)) < seek_time;
+  });
 }
 
 // --------------------------------------------------------------------------
 /** Utility function:
  * Returns the iterator into events of the first TofEvent with
- * tof() > seek_tof
+ * tof() >= seek_tof
  * Will return events.end() if nothing is found!
+ * The events must be sorted by TOF. A binary search is used so the events
+ * below seek_tof are never read.
  *
  * @param events :: event vector in which to look.
  * @param seek_tof :: tof to find (typically the first bin X[0])
  * @return iterator where the first event matching it is.
  */
 template <class T> typename std::vector<T>::iterator static findFirstEvent(std::vector<T> &events, T seek_tof) {
-  return std::find_if_not(events.begin(), events.end(), [seek_tof](const T &x) { return x < seek_tof; });
+  return std::lower_bound(events.begin(), events.end(), seek_tof);
+}
+
+// --------------------------------------------------------------------------
+/** Utility function:
+ * Returns the iterator into events of the first TofEvent with
+ * tof() >= seek_tof, searching from first onwards.
+ * The events must be sorted by TOF.
+ *
+ * @param first :: where to start the search
+ * @param last :: end of the event range
+ * @param seek_tof :: tof to find (typically the last bin edge X.back())
+ * @return iterator past the last event below seek_tof.
+ */
+template <class Iter, class T> static Iter findEndEvent(Iter first, Iter last, T seek_tof) {
+  return std::lower_bound(first, last, seek_tof);
 }
 
 // --------------------------------------------------------------------------
@@ -1884,7 +2255,8 @@ void EventList::histogramForWeightsHelper(const std::vector<T> &events, const Ma
   if (!events.empty()) {
     // Iterate through all events (sorted by tof)
     auto itev = findFirstEvent(events, T(X[0]));
-    auto itev_end = events.cend();
+    // Events at or above the last bin boundary are never read
+    auto itev_end = findEndEvent(itev, events.cend(), T(X[x_size - 1]));
     // The above can still take you to end() if no events above X[0], so check
     // again.
     if (itev == itev_end)
@@ -2008,8 +2380,33 @@ void EventList::generateHistogramTimeAtSample(const MantidVec &X, MantidVec &Y,
  *        events; you can just ignore the returned E vector.
  */
 void EventList::generateHistogram(const MantidVec &X, MantidVec &Y, MantidVec &E, bool skipError) const {
-  // All types of weights need to be sorted by TOF
+  // Linear and logarithmic bins are found arithmetically, for which the
+  // events do not need to be sorted
+  const RegularBinFinder binFinder(X);
+  if (binFinder) {
+    const size_t numBins = X.size() - 1;
+    Y.assign(numBins, 0.0);
+    switch (eventType) {
+    case TOF:
+      countsForRegularBins(this->events, binFinder, Y);
+      if (!skipError)
+        this->generateErrorsHistogram(Y, E);
+      return;
+    case WEIGHTED:
+      E.assign(numBins, 0.0);
+      weightsForRegularBins(this->weightedEvents, binFinder, Y, E);
+      break;
+    case WEIGHTED_NOTIME:
+      E.assign(numBins, 0.0);
+      weightsForRegularBins(this->weightedEventsNoTime, binFinder, Y, E);
+      break;
+    }
+    // Now do the sqrt of all errors
+    std::transform(E.begin(), E.end(), E.begin(), static_cast<double (*)(double)>(sqrt));
+    return;
+  }
 
+  // Otherwise all types of weights need to be sorted by TOF
   this->sortTof();
 
   switch (eventType) {
@@ -2233,8 +2630,10 @@ void EventList::generateCountsHistogram(const MantidVec &X, MantidVec &Y) const
     // Iterate through all events (sorted by tof) placing them in the correct
     // bin.
     auto itev = findFirstEvent(this->events, TofEvent(X[0]));
+    // Events at or above the last bin boundary are never read
+    const auto itev_end = findEndEvent(itev, this->events.end(), TofEvent(X[x_size - 1]));
     // Go through all the events,
-    for (auto itx = X.cbegin(); itev != events.end(); ++itev) {
+    for (auto itx = X.cbegin(); itev != itev_end; ++itev) {
       double tof = itev->tof();
       itx = std::find_if(itx, X.cend(), [tof](const double x) { return tof < x; });
       if (itx == X.cend()) {
@@ -3649,7 +4048,7 @@ void EventList::divide(const double value, const double error) {
 // ----------- SPLITTING AND FILTERING ---------------------------------------
 // ==============================================================================================
 /** Filter a vector of events into another based on pulse time.
- * TODO: Make this more efficient using STL-fu.
+ * The events must be sorted by pulse time.
  * @param events :: input events
  * @param start :: start time (absolute)
  * @param stop :: end time (absolute)
@@ -3658,17 +4057,10 @@ void EventList::divide(const double value, const double error) {
 template <class T>
 void EventList::filterByPulseTimeHelper(std::vector<T> &events, DateAndTime start, DateAndTime stop,
                                         std::vector<T> &output) {
-  auto itev = events.begin();
-  auto itev_end = events.end();
-  // Find the first event with m_pulsetime >= start
-  while ((itev != itev_end) && (itev->m_pulsetime < start))
-    itev++;
-
-  while ((itev != itev_end) && (itev->m_pulsetime < stop)) {
-    // Add the copy to the output
-    output.emplace_back(*itev);
-    ++itev;
-  }
+  // The events are sorted by pulse time so the kept ones are contiguous
+  const auto first = seekPulseTime(events.cbegin(), events.cend(), start);
+  const auto last = seekPulseTime(first, events.cend(), stop);
+  output.assign(first, last);
 }
 
 /** Filter a vector of events into another based on time at sample.
@@ -3779,12 +4171,6 @@ void EventList::filterByTimeAtSample(Types::Core::DateAndTime start, Types::Core
  */
 template <class T>
 void EventList::filterInPlaceHelper(Kernel::TimeSplitterType &splitter, typename std::vector<T> &events) {
-  // Iterate through the splitter at the same time
-  auto itspl = splitter.begin();
-  auto itspl_end = splitter.end();
-  DateAndTime start, stop;
-
-  // Iterate for the input
   auto itev = events.begin();
   auto itev_end = events.end();
 
@@ -3792,51 +4178,23 @@ void EventList::filterInPlaceHelper(Kernel::TimeSplitterType &splitter, typename
   // are dropped.
   auto itOut = events.begin();
 
-  // This is the time of the first section. Anything before is thrown out.
-  while (itspl != itspl_end) {
-    // Get the splitting interval times and destination
-    start = itspl->start();
-    stop = itspl->stop();
-    const int index = itspl->index();
-
-    // Skip the events before the start of the time
-    while ((itev != itev_end) && (itev->m_pulsetime < start))
-      itev++;
+  // Anything before the first interval is thrown out
+  for (const auto &interval : splitter) {
+    // The events are sorted by pulse time so those in the interval are contiguous
+    itev = seekPulseTime(itev, itev_end, interval.start());
+    const auto intervalEnd = seekPulseTime(itev, itev_end, interval.stop());
 
     // Are we aligned in the input vs output?
-    bool copyingInPlace = (itOut == itev);
-    if (copyingInPlace) {
-      while ((itev != itev_end) && (itev->m_pulsetime < stop))
-        ++itev;
-      // Make sure the iterators still match
-      itOut = itev;
-    } else {
-      // Go through all the events that are in the interval (if any)
-      while ((itev != itev_end) && (itev->m_pulsetime < stop)) {
-        if (index >= 0) {
-          // Copy the input Event to the output iterator position.
-          // Strictly speaking, this is not necessary if itOut == itev; but the
-          // extra check would likely
-          //  slow down the filtering in the 99% of cases where itOut != itev.
-          *itOut = *itev;
-          // And go up a spot in the output iterator.
-          ++itOut;
-        }
-        ++itev;
-      }
-    }
-
-    // Go to the next interval
-    ++itspl;
-    // But if we reached the end, then we are done.
-    if (itspl == itspl_end)
-      break;
+    if (itOut == itev)
+      itOut = intervalEnd;
+    else if (interval.index() >= 0)
+      itOut = std::copy(itev, intervalEnd, itOut);
+    itev = intervalEnd;
 
     // No need to keep looping through the filter if we are out of events
     if (itev == itev_end)
       break;
-
-  } // Looping through entries in the splitter vector
+  }
 
   // Ok, now resize the event list to reflect the fact that it (probably) shrank
   events.resize((itOut - events.begin()));
@@ -3885,49 +4243,24 @@ void EventList::splitByTimeHelper(Kernel::TimeSplitterType &splitter, std::vecto
                                   typename std::vector<T> &events) const {
   size_t numOutputs = outputs.size();
 
-  // Iterate through the splitter at the same time
-  auto itspl = splitter.begin();
-  auto itspl_end = splitter.end();
-  DateAndTime start, stop;
-
-  // Iterate through all events (sorted by tof)
-  auto itev = events.begin();
-  auto itev_end = events.end();
-
-  // This is the time of the first section. Anything before is thrown out.
-  while (itspl != itspl_end) {
-    // Get the splitting interval times and destination
-    start = itspl->start();
-    stop = itspl->stop();
-    const size_t index = itspl->index();
-
-    // Skip the events before the start of the time
-    while ((itev != itev_end) && (itev->m_pulsetime < start))
-      itev++;
-
-    // Go through all the events that are in the interval (if any)
-    while ((itev != itev_end) && (itev->m_pulsetime < stop)) {
-      // Copy the event into another
-      const T eventCopy(*itev);
-      if (index < numOutputs) {
-        EventList *myOutput = outputs[index];
-        // Add the copy to the output
-        myOutput->addEventQuickly(eventCopy);
-      }
-      ++itev;
-    }
-
-    // Go to the next interval
-    ++itspl;
-    // But if we reached the end, then we are done.
-    if (itspl == itspl_end)
-      break;
+  // Iterate through all events (sorted by pulse time)
+  auto itev = events.cbegin();
+  auto itev_end = events.cend();
+
+  // Anything before the first interval is thrown out
+  for (const auto &interval : splitter) {
+    // The events in the interval are contiguous, so copy them as a block
+    itev = seekPulseTime(itev, itev_end, interval.start());
+    const auto intervalEnd = seekPulseTime(itev, itev_end, interval.stop());
+    const auto index = static_cast<size_t>(interval.index());
+    if (index < numOutputs)
+      appendEvents<T>(outputs[index], itev, intervalEnd);
+    itev = intervalEnd;
 
     // No need to keep looping through the filter if we are out of events
     if (itev == itev_end)
       break;
   }
-  // Done!
 }
 
 //------------------------------------------------------------------------------------------------
@@ -4359,59 +4692,26 @@ std::string EventList::splitByFullTimeMatrixSplitter(const std::vector<int64_t>
 template <class T>
 void EventList::splitByPulseTimeHelper(Kernel::TimeSplitterType &splitter, std::map<int, EventList *> outputs,
                                        typename std::vector<T> &events) const {
-  // Prepare to TimeSplitter Iterate through the splitter at the same time
-  auto itspl = splitter.begin();
-  auto itspl_end = splitter.end();
-  Types::Core::DateAndTime start, stop;
-
-  // Prepare to Events Iterate through all events (sorted by tof)
-  auto itev = events.begin();
-  auto itev_end = events.end();
+  // Prepare to Events Iterate through all events (sorted by pulse time)
+  auto itev = events.cbegin();
+  auto itev_end = events.cend();
 
   // Iterate (loop) on all splitters
-  while (itspl != itspl_end) {
-    // Get the splitting interval times and destination group
-    start = itspl->start().totalNanoseconds();
-    stop = itspl->stop().totalNanoseconds();
-    const int index = itspl->index();
-
-    // Skip the events before the start of the time and put to 'unfiltered'
-    // EventList
-    EventList *myOutput = outputs[-1];
-    while (itev != itev_end) {
-      if (itev->m_pulsetime < start) {
-        // Record to index = -1 space
-        const T eventCopy(*itev);
-        myOutput->addEventQuickly(eventCopy);
-        ++itev;
-      } else {
-        // Event within a splitter interval
-        break;
-      }
-    }
-
-    // Go through all the events that are in the interval (if any)
-    while (itev != itev_end) {
+  for (const auto &interval : splitter) {
+    // Put the events before the start of the interval to the 'unfiltered'
+    // EventList (index = -1)
+    const auto intervalStart = seekPulseTime(itev, itev_end, interval.start());
+    appendEvents<T>(outputs[-1], itev, intervalStart);
 
-      if (itev->m_pulsetime < stop) {
-        outputs[index]->addEventQuickly(*itev);
-        ++itev;
-      } else {
-        // Out of interval
-        break;
-      }
-    }
-
-    // Go to the next interval
-    ++itspl;
-    // But if we reached the end, then we are done.
-    if (itspl == itspl_end)
-      break;
+    // Copy all the events that are in the interval (if any)
+    const auto intervalEnd = seekPulseTime(intervalStart, itev_end, interval.stop());
+    appendEvents<T>(outputs[interval.index()], intervalStart, intervalEnd);
+    itev = intervalEnd;
 
     // No need to keep looping through the filter if we are out of events
     if (itev == itev_end)
       break;
-  } // END-WHILE Splitter
+  } // END-FOR Splitter
 }
 
 //----------------------------------------------------------------------------------------------
@@ -4510,48 +4810,31 @@ void EventList::splitByPulseTimeWithMatrixHelper(const std::vector<int64_t> &vec
     throw std::runtime_error("Splitter time vector size and splitter target "
                              "vector size are not correct.");
 
-  // Prepare to Events Iterate through all events (sorted by tof)
-  auto itev = events.begin();
-  auto itev_end = events.end();
+  // Prepare to Events Iterate through all events (sorted by pulse time)
+  auto itev = events.cbegin();
+  auto itev_end = events.cend();
 
   // Iterate (loop) on all splitters
   for (size_t i_target = 0; i_target < vec_split_target.size(); ++i_target) {
     // Get the splitting interval times and destination group
-    int64_t start = vec_split_times[i_target];
-    int64_t stop = vec_split_times[i_target + 1];
+    const DateAndTime start(vec_split_times[i_target]);
+    const DateAndTime stop(vec_split_times[i_target + 1]);
     const int index = vec_split_target[i_target];
 
-    // Skip the events before the start of the time and put to 'unfiltered'
-    // EventList
-    EventList *myOutput = outputs[-1];
-    while (itev != itev_end) {
-      if (itev->m_pulsetime < start) {
-        // Record to index = -1 space
-        const T eventCopy(*itev);
-        myOutput->addEventQuickly(eventCopy);
-        ++itev;
-      } else {
-        // Event within a splitter interval
-        break;
-      }
-    }
-
-    // Go through all the events that are in the interval (if any)
-    while (itev != itev_end) {
+    // Put the events before the start of the interval to the 'unfiltered'
+    // EventList (index = -1)
+    const auto intervalStart = seekPulseTime(itev, itev_end, start);
+    appendEvents<T>(outputs[-1], itev, intervalStart);
 
-      if (itev->m_pulsetime < stop) {
-        outputs[index]->addEventQuickly(*itev);
-        ++itev;
-      } else {
-        // Out of interval
-        break;
-      }
-    }
+    // Copy all the events that are in the interval (if any)
+    const auto intervalEnd = seekPulseTime(intervalStart, itev_end, stop);
+    appendEvents<T>(outputs[index], intervalStart, intervalEnd);
+    itev = intervalEnd;
 
     // No need to keep looping through the filter if we are out of events
     if (itev == itev_end)
       break;
-  } // END-WHILE Splitter
+  } // END-FOR Splitter
 }
 
 //--------------------------------------------------------------------------
@@ -4616,6 +4899,57 @@ void EventList::convertUnitsViaTofHelper(typename std::vector<T> &events, Mantid
   }
 }
 
+//--------------------------------------------------------------------------
+/** Helper function for the conversion via TOF when both units give
+ *  TOFCoefficients, for the given powers of the two conversions. With the
+ *  virtual calls replaced by a few flops per event the loop can be
+ *  vectorized.
+ *
+ * @param events the list of events
+ * @param from the coefficients of the unit to convert from
+ * @param to the coefficients of the unit to convert to
+ */
+template <int FromPower, int ToPower, class T>
+void EventList::convertUnitsViaTofHelper(typename std::vector<T> &events, const Kernel::TOFCoefficients &from,
+                                         const Kernel::TOFCoefficients &to) {
+  for (auto &event : events) {
+    double tof;
+    if constexpr (FromPower == 1)
+      tof = from.toFactor * event.m_tof + from.toOffset;
+    else
+      tof = from.toFactor / event.m_tof + from.toOffset;
+    const double base = tof - to.fromOffset;
+    if constexpr (ToPower == 1)
+      event.m_tof = to.fromFactor * base;
+    else
+      event.m_tof = to.fromFactor / (base == 0. ? DBL_MIN : base);
+  }
+}
+
+//--------------------------------------------------------------------------
+/** Helper function for the conversion via TOF when both units give
+ *  TOFCoefficients. This picks the loop for the powers of the conversions.
+ *
+ * @param events the list of events
+ * @param from the coefficients of the unit to convert from
+ * @param to the coefficients of the unit to convert to
+ */
+template <class T>
+void EventList::convertUnitsViaTofHelper(typename std::vector<T> &events, const Kernel::TOFCoefficients &from,
+                                         const Kernel::TOFCoefficients &to) {
+  if (from.power == 1) {
+    if (to.power == 1)
+      convertUnitsViaTofHelper<1, 1>(events, from, to);
+    else
+      convertUnitsViaTofHelper<1, -1>(events, from, to);
+  } else {
+    if (to.power == 1)
+      convertUnitsViaTofHelper<-1, 1>(events, from, to);
+    else
+      convertUnitsViaTofHelper<-1, -1>(events, from, to);
+  }
+}
+
 //--------------------------------------------------------------------------
 /** Converts the X units in each event by going through TOF.
  * Note: if the unit conversion reverses the order, use "reverse()" to flip it
@@ -4633,6 +4967,25 @@ void EventList::convertUnitsViaTof(Mantid::Kernel::Unit *fromUnit, Mantid::Kerne
   if (!toUnit->isInitialized())
     throw std::runtime_error("EventList::convertUnitsViaTof(): toUnit is not initialized!");
 
+  // Units that are power laws of TOF, with coefficients fixed by the detector
+  // they were initialized for, are converted without calling the units for
+  // every event
+  Kernel::TOFCoefficients from{}, to{};
+  if (fromUnit->tofCoefficients(from) && toUnit->tofCoefficients(to)) {
+    switch (eventType) {
+    case TOF:
+      convertUnitsViaTofHelper(this->events, from, to);
+      break;
+    case WEIGHTED:
+      convertUnitsViaTofHelper(this->weightedEvents, from, to);
+      break;
+    case WEIGHTED_NOTIME:
+      convertUnitsViaTofHelper(this->weightedEventsNoTime, from, to);
+      break;
+    }
+    return;
+  }
+
   switch (eventType) {
   case TOF:
     convertUnitsViaTofHelper(this->events, fromUnit, toUnit);
@@ -4682,8 +5035,7 @@ void EventList::convertUnitsQuickly(const double &factor, const double &power) {
 }
 
 HistogramData::Histogram &EventList::mutableHistogramRef() {
-  if (mru)
-    mru->deleteIndex(this);
+  invalidateMRU();
   return m_histogram;
 }
 
@@ -480,6 +480,12 @@ bool EventWorkspace::isHistogramData() const { return true; }
  */
 size_t EventWorkspace::MRUSize() const { return mru->MRUSize(); }
 
+/** Fraction of the Y and E histograms asked for that were found in the MRU
+ * lists rather than generated from the events.
+ * @return :: hit rate between 0 and 1, 0 if nothing was asked for yet
+ */
+double EventWorkspace::MRUHitRate() const { return mru->statistics().hitRate(); }
+
 /** Clears the MRU lists */
 void EventWorkspace::clearMRU() const { mru->clear(); }
 
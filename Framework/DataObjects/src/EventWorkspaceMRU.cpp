@@ -11,70 +11,51 @@
 
 namespace Mantid::DataObjects {
 
+namespace {
+/// Number of histograms each thread keeps
+constexpr size_t MRU_LIST_SIZE = 50;
+/// Source of EventList generations. Starts at 1 so 0 is never valid.
+std::atomic<uint64_t> g_generation{1};
+} // namespace
+
+EventWorkspaceMRU::Shard::Shard() : bufferedDataY(MRU_LIST_SIZE), bufferedDataE(MRU_LIST_SIZE) {}
+
+EventWorkspaceMRU::EventWorkspaceMRU() {
+  for (auto &shard : m_shards)
+    shard.store(nullptr, std::memory_order_relaxed);
+}
+
 EventWorkspaceMRU::~EventWorkspaceMRU() {
   // Make sure you free up the memory in the MRUs
-  {
-    Poco::ScopedWriteRWLock _lock(m_changeMruListsMutexY);
-    for (auto &data : m_bufferedDataY) {
-      if (data) {
-        data->clear();
-      }
-    }
-  }
-  Poco::ScopedWriteRWLock _lock2(m_changeMruListsMutexE);
-  for (auto &data : m_bufferedDataE) {
-    if (data) {
-      data->clear();
-    }
-  }
+  for (auto &shard : m_shards)
+    delete shard.load(std::memory_order_acquire);
 }
 
 //---------------------------------------------------------------------------
-/** This function makes sure that there are enough data
- * buffers (MRU's) for E for the number of threads requested.
- * @param thread_num :: thread number that wants a MRU buffer
- */
-void EventWorkspaceMRU::ensureEnoughBuffersE(size_t thread_num) const {
-  Poco::ScopedWriteRWLock _lock(m_changeMruListsMutexE);
-  if (m_bufferedDataE.size() <= thread_num) {
-    m_bufferedDataE.resize(thread_num + 1);
-    // Replaces empty data with an MRU list with this many entries.
-    std::transform(m_bufferedDataE.begin(), m_bufferedDataE.end(), m_bufferedDataE.begin(),
-                   [](auto &data) { return data ? std::move(data) : std::move(std::make_unique<mru_listE>(50)); });
-  }
-}
-//---------------------------------------------------------------------------
-/** This function makes sure that there are enough data
- * buffers (MRU's) for Y for the number of threads requested.
+/** Get the MRU lists of a thread, creating them the first time it asks. This
+ * does not lock: if two threads sharing a shard race to create it, one of them
+ * discards its copy.
  * @param thread_num :: thread number that wants a MRU buffer
+ * @return the shard of the thread
  */
-void EventWorkspaceMRU::ensureEnoughBuffersY(size_t thread_num) const {
-  Poco::ScopedWriteRWLock _lock(m_changeMruListsMutexY);
-  if (m_bufferedDataY.size() <= thread_num) {
-    m_bufferedDataY.resize(thread_num + 1);
-    // Replaces empty data with an MRU list with this many entries.
-    std::transform(m_bufferedDataY.begin(), m_bufferedDataY.end(), m_bufferedDataY.begin(),
-                   [](auto &data) { return data ? std::move(data) : std::move(std::make_unique<mru_listY>(50)); });
-  }
+EventWorkspaceMRU::Shard &EventWorkspaceMRU::shard(size_t thread_num) const {
+  auto &slot = m_shards[thread_num % MAX_SHARDS];
+  Shard *existing = slot.load(std::memory_order_acquire);
+  if (existing)
+    return *existing;
+  auto created = std::make_unique<Shard>();
+  if (slot.compare_exchange_strong(existing, created.get(), std::memory_order_acq_rel, std::memory_order_acquire))
+    return *created.release();
+  return *existing;
 }
 
 //---------------------------------------------------------------------------
 /// Clear all the data in the MRU buffers
 void EventWorkspaceMRU::clear() {
-  {
-    // Make sure you free up the memory in the MRUs
-    Poco::ScopedWriteRWLock _lock(m_changeMruListsMutexY);
-    for (auto &data : m_bufferedDataY) {
-      if (data) {
-        data->clear();
-      }
-    }
-  }
-
-  Poco::ScopedWriteRWLock _lock(m_changeMruListsMutexE);
-  for (auto &data : m_bufferedDataE) {
-    if (data) {
-      data->clear();
+  for (auto &slot : m_shards) {
+    if (auto *shard = slot.load(std::memory_order_acquire)) {
+      shard->bufferedDataY.clear();
+      shard->bufferedDataE.clear();
     }
   }
 }
@@ -84,27 +65,37 @@ void EventWorkspaceMRU::clear() {
  *
  * @param thread_num :: number of the thread in which this is run
  * @param index :: index of the data to return
- * @return pointer to the TypeWithMarker that has the data; NULL if not found.
+ * @param generation :: current generation of the EventList
+ * @return the data; NULL if not found or out of date.
  */
-Kernel::cow_ptr<HistogramData::HistogramY> EventWorkspaceMRU::findY(size_t thread_num, const EventList *index) {
-  Poco::ScopedReadRWLock _lock(m_changeMruListsMutexY);
-  auto result = m_bufferedDataY[thread_num]->find(reinterpret_cast<std::uintptr_t>(index));
-  if (result)
+Kernel::cow_ptr<HistogramData::HistogramY> EventWorkspaceMRU::findY(size_t thread_num, const EventList *index,
+                                                                    uint64_t generation) {
+  auto &threadShard = shard(thread_num);
+  auto result = threadShard.bufferedDataY.find(reinterpret_cast<std::uintptr_t>(index));
+  if (result && result->m_generation == generation) {
+    threadShard.hits.fetch_add(1, std::memory_order_relaxed);
     return result->m_data;
+  }
+  threadShard.misses.fetch_add(1, std::memory_order_relaxed);
   return YType(nullptr);
 }
 
-/** Find a Y histogram in the MRU
+/** Find a E histogram in the MRU
  *
  * @param thread_num :: number of the thread in which this is run
  * @param index :: index of the data to return
- * @return pointer to the TypeWithMarker that has the data; NULL if not found.
+ * @param generation :: current generation of the EventList
+ * @return the data; NULL if not found or out of date.
  */
-Kernel::cow_ptr<HistogramData::HistogramE> EventWorkspaceMRU::findE(size_t thread_num, const EventList *index) {
-  Poco::ScopedReadRWLock _lock(m_changeMruListsMutexE);
-  auto result = m_bufferedDataE[thread_num]->find(reinterpret_cast<std::uintptr_t>(index));
-  if (result)
+Kernel::cow_ptr<HistogramData::HistogramE> EventWorkspaceMRU::findE(size_t thread_num, const EventList *index,
+                                                                    uint64_t generation) {
+  auto &threadShard = shard(thread_num);
+  auto result = threadShard.bufferedDataE.find(reinterpret_cast<std::uintptr_t>(index));
+  if (result && result->m_generation == generation) {
+    threadShard.hits.fetch_add(1, std::memory_order_relaxed);
     return result->m_data;
+  }
+  threadShard.misses.fetch_add(1, std::memory_order_relaxed);
   return EType(nullptr);
 }
 
@@ -113,12 +104,16 @@ Kernel::cow_ptr<HistogramData::HistogramE> EventWorkspaceMRU::findE(size_t threa
  * @param thread_num :: thread being accessed
  * @param data :: the new data
  * @param index :: index of the data to insert
+ * @param generation :: generation of the EventList the data was made from
  */
-void EventWorkspaceMRU::insertY(size_t thread_num, YType data, const EventList *index) {
-  Poco::ScopedReadRWLock _lock(m_changeMruListsMutexY);
-  auto yWithMarker = std::make_shared<TypeWithMarker<YType>>(reinterpret_cast<std::uintptr_t>(index));
+void EventWorkspaceMRU::insertY(size_t thread_num, YType data, const EventList *index, uint64_t generation) {
+  auto &list = shard(thread_num).bufferedDataY;
+  const auto key = reinterpret_cast<std::uintptr_t>(index);
+  // An out of date entry would be moved to the front rather than replaced
+  list.deleteIndex(key);
+  auto yWithMarker = std::make_shared<YWithMarker>(key, generation);
   yWithMarker->m_data = std::move(data);
-  m_bufferedDataY[thread_num]->insert(yWithMarker);
+  list.insert(yWithMarker);
   // the memory is cleared automatically due to being a smart_ptr
 }
 
@@ -127,42 +122,45 @@ void EventWorkspaceMRU::insertY(size_t thread_num, YType data, const EventList *
  * @param thread_num :: thread being accessed
  * @param data :: the new data
  * @param index :: index of the data to insert
+ * @param generation :: generation of the EventList the data was made from
  */
-void EventWorkspaceMRU::insertE(size_t thread_num, EType data, const EventList *index) {
-  Poco::ScopedReadRWLock _lock(m_changeMruListsMutexE);
-  auto eWithMarker = std::make_shared<TypeWithMarker<EType>>(reinterpret_cast<std::uintptr_t>(index));
+void EventWorkspaceMRU::insertE(size_t thread_num, EType data, const EventList *index, uint64_t generation) {
+  auto &list = shard(thread_num).bufferedDataE;
+  const auto key = reinterpret_cast<std::uintptr_t>(index);
+  list.deleteIndex(key);
+  auto eWithMarker = std::make_shared<EWithMarker>(key, generation);
   eWithMarker->m_data = std::move(data);
-  m_bufferedDataE[thread_num]->insert(eWithMarker);
+  list.insert(eWithMarker);
   // And clear up the memory of the old one, if it is dropping out.
 }
 
-/** Delete any entries in the MRU at the given index
- *
- * @param index :: index to delete.
- */
-void EventWorkspaceMRU::deleteIndex(const EventList *index) {
-  {
-    Poco::ScopedReadRWLock _lock1(m_changeMruListsMutexE);
-    for (auto &data : m_bufferedDataE) {
-      if (data) {
-        data->deleteIndex(reinterpret_cast<std::uintptr_t>(index));
-      }
+uint64_t EventWorkspaceMRU::nextGeneration() { return g_generation.fetch_add(1, std::memory_order_relaxed); }
+
+/// @return the hits and misses of all threads since the last reset
+EventWorkspaceMRU::Statistics EventWorkspaceMRU::statistics() const {
+  Statistics stats;
+  for (const auto &slot : m_shards) {
+    if (const auto *shard = slot.load(std::memory_order_acquire)) {
+      stats.hits += shard->hits.load(std::memory_order_relaxed);
+      stats.misses += shard->misses.load(std::memory_order_relaxed);
     }
   }
-  Poco::ScopedReadRWLock _lock2(m_changeMruListsMutexY);
-  for (auto &data : m_bufferedDataY) {
-    if (data) {
-      data->deleteIndex(reinterpret_cast<std::uintptr_t>(index));
+  return stats;
+}
+
+/// Zero the hit and miss counts
+void EventWorkspaceMRU::resetStatistics() {
+  for (auto &slot : m_shards) {
+    if (auto *shard = slot.load(std::memory_order_acquire)) {
+      shard->hits.store(0, std::memory_order_relaxed);
+      shard->misses.store(0, std::memory_order_relaxed);
     }
   }
 }
 
 size_t EventWorkspaceMRU::MRUSize() const {
-  if (m_bufferedDataY.empty()) {
-    return 0;
-  } else {
-    return this->m_bufferedDataY.front()->size();
-  }
+  const auto *first = m_shards.front().load(std::memory_order_acquire);
+  return first ? first->bufferedDataY.size() : 0;
 }
 
 } // namespace Mantid::DataObjects
@@ -35,6 +35,7 @@ void MDBoxSaveable::save() const {
  * private function called from the DiskBuffer
  */
 void MDBoxSaveable::load() {
+  std::lock_guard<std::mutex> lock(m_loadMutex);
   // Is the data in memory right now (cached copy)?
   if (!m_isLoaded) {
     API::IBoxControllerIO *fileIO = m_MDNode->getBoxController()->getFileIO();
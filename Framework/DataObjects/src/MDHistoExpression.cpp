@@ -0,0 +1,240 @@
+// Mantid Repository : https://github.com/mantidproject/mantid
+//
+// Copyright &copy; 2022 ISIS Rutherford Appleton Laboratory UKRI,
+//   NScD Oak Ridge National Laboratory, European Spallation Source,
+//   Institut Laue - Langevin & CSNS, Institute of High Energy Physics, CAS
+// SPDX - License - Identifier: GPL - 3.0 +
+#include "MantidDataObjects/MDHistoExpression.h"
+#include "MantidDataObjects/MDHistoWorkspace.h"
+#include "MantidKernel/MultiThreaded.h"
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+namespace Mantid::DataObjects {
+
+namespace {
+/// The arrays of one intermediate result for a block of bins
+struct Register {
+  signal_t *signal;
+  signal_t *errorSquared;
+  signal_t *numEvents;
+};
+
+Register getRegister(signal_t *registers, const size_t index) {
+  signal_t *start = registers + 3 * index * MDHistoExpression::BLOCK_SIZE;
+  return {start, start + MDHistoExpression::BLOCK_SIZE, start + 2 * MDHistoExpression::BLOCK_SIZE};
+}
+} // namespace
+
+//----------------------------------------------------------------------------------------------
+/** Expression holding a single workspace
+ *
+ * @param workspace :: the workspace, which must outlive the expression
+ */
+MDHistoExpression::MDHistoExpression(const MDHistoWorkspace &workspace)
+    : m_steps{{Operation::Workspace, &workspace, 0., 0., false}}, m_depth(1), m_isScalar(false) {}
+
+//----------------------------------------------------------------------------------------------
+/** Expression holding a single scalar
+ *
+ * @param signal :: the value
+ * @param error :: its error (not squared)
+ */
+MDHistoExpression::MDHistoExpression(const signal_t signal, const signal_t error)
+    : m_steps{{Operation::Scalar, nullptr, signal, error * error, false}}, m_depth(1), m_isScalar(true) {}
+
+/// @return the natural logarithm of this expression, with bins <= 0 set to filler
+MDHistoExpression MDHistoExpression::log(const double filler) const { return apply(Operation::Log, filler); }
+
+/// @return the base-10 logarithm of this expression, with bins <= 0 set to filler
+MDHistoExpression MDHistoExpression::log10(const double filler) const { return apply(Operation::Log10, filler); }
+
+/// @return e to the power of this expression
+MDHistoExpression MDHistoExpression::exp() const { return apply(Operation::Exp, 0.); }
+
+/// @return this expression to the given power
+MDHistoExpression MDHistoExpression::power(const double exponent) const { return apply(Operation::Power, exponent); }
+
+/// Turn this expression into (this operation rhs)
+MDHistoExpression &MDHistoExpression::combine(const Operation operation, const MDHistoExpression &rhs) {
+  m_depth = std::max(m_depth, rhs.m_depth + 1);
+  const bool lhsIsScalar = m_isScalar;
+  m_isScalar = m_isScalar && rhs.m_isScalar;
+  m_steps.insert(m_steps.end(), rhs.m_steps.begin(), rhs.m_steps.end());
+  m_steps.push_back({operation, nullptr, 0., 0., lhsIsScalar});
+  return *this;
+}
+
+/// @return the expression (operation this), with the given filler or exponent
+MDHistoExpression MDHistoExpression::apply(const Operation operation, const double parameter) const {
+  MDHistoExpression result(*this);
+  result.m_steps.push_back({operation, nullptr, parameter, 0., false});
+  return result;
+}
+
+//----------------------------------------------------------------------------------------------
+/** Evaluate the expression and write signals, errors squared and event counts
+ * into a workspace. Its mask and everything else about it are left alone.
+ *
+ * @param out :: the workspace to fill, which may appear in the expression
+ * @throw std::invalid_argument if there is no workspace in the expression or
+ *the workspaces have different numbers of bins
+ */
+void MDHistoExpression::evaluateInto(MDHistoWorkspace &out) const {
+  if (m_isScalar)
+    throw std::invalid_argument("MDHistoExpression: the expression contains no workspace to take the size from.");
+  const size_t length = out.getNPoints();
+  for (const auto &step : m_steps) {
+    if (step.operation == Operation::Workspace && step.workspace->getNPoints() != length)
+      throw std::invalid_argument("MDHistoExpression: the workspaces do not have the same number of bins.");
+  }
+
+  signal_t *signals = out.mutableSignalArray();
+  signal_t *errorsSquared = out.mutableErrorSquaredArray();
+  signal_t *numEvents = out.mutableNumEventsArray();
+  const auto numBlocks = static_cast<int64_t>((length + BLOCK_SIZE - 1) / BLOCK_SIZE);
+
+  PRAGMA_OMP(parallel if (numBlocks > 1)) {
+    std::vector<signal_t> registers(3 * m_depth * BLOCK_SIZE);
+    PRAGMA_OMP(for schedule(static))
+    for (int64_t block = 0; block < numBlocks; ++block) {
+      const size_t begin = static_cast<size_t>(block) * BLOCK_SIZE;
+      const size_t size = std::min(BLOCK_SIZE, length - begin);
+      evaluateBlock(begin, size, registers.data());
+      // Every input block has been read, so this is safe when out is an input
+      const Register result = getRegister(registers.data(), 0);
+      std::copy_n(result.signal, size, signals + begin);
+      std::copy_n(result.errorSquared, size, errorsSquared + begin);
+      std::copy_n(result.numEvents, size, numEvents + begin);
+    }
+  }
+}
+
+//----------------------------------------------------------------------------------------------
+/** Evaluate the expression on one block of bins, leaving the result in the
+ * first register.
+ *
+ * @param begin :: index of the first bin
+ * @param size :: number of bins, at most BLOCK_SIZE
+ * @param registers :: scratch space for m_depth registers
+ */
+void MDHistoExpression::evaluateBlock(const size_t begin, const size_t size, signal_t *registers) const {
+  size_t top = 0;
+  for (const auto &step : m_steps) {
+    switch (step.operation) {
+    case Operation::Workspace: {
+      const Register a = getRegister(registers, top++);
+      std::copy_n(step.workspace->getSignalArray() + begin, size, a.signal);
+      std::copy_n(step.workspace->getErrorSquaredArray() + begin, size, a.errorSquared);
+      std::copy_n(step.workspace->getNumEventsArray() + begin, size, a.numEvents);
+      break;
+    }
+    case Operation::Scalar: {
+      const Register a = getRegister(registers, top++);
+      std::fill_n(a.signal, size, step.value);
+      std::fill_n(a.errorSquared, size, step.errorSquared);
+      std::fill_n(a.numEvents, size, 0.);
+      break;
+    }
+    case Operation::Add: {
+      const Register a = getRegister(registers, top - 2);
+      const Register b = getRegister(registers, --top);
+      for (size_t i = 0; i < size; ++i) {
+        a.signal[i] += b.signal[i];
+        a.errorSquared[i] += b.errorSquared[i];
+        a.numEvents[i] += b.numEvents[i];
+      }
+      break;
+    }
+    case Operation::Subtract: {
+      const Register a = getRegister(registers, top - 2);
+      const Register b = getRegister(registers, --top);
+      for (size_t i = 0; i < size; ++i) {
+        a.signal[i] -= b.signal[i];
+        a.errorSquared[i] += b.errorSquared[i];
+        a.numEvents[i] += b.numEvents[i];
+      }
+      break;
+    }
+    case Operation::Multiply: {
+      const Register a = getRegister(registers, top - 2);
+      const Register b = getRegister(registers, --top);
+      for (size_t i = 0; i < size; ++i) {
+        const signal_t da2 = a.errorSquared[i];
+        const signal_t db2 = b.errorSquared[i];
+        a.errorSquared[i] = da2 * b.signal[i] * b.signal[i] + db2 * a.signal[i] * a.signal[i];
+        a.signal[i] *= b.signal[i];
+      }
+      // The event counts are those of the workspace operand
+      if (step.lhsIsScalar)
+        std::copy_n(b.numEvents, size, a.numEvents);
+      break;
+    }
+    case Operation::Divide: {
+      const Register a = getRegister(registers, top - 2);
+      const Register b = getRegister(registers, --top);
+      for (size_t i = 0; i < size; ++i) {
+        const signal_t f = a.signal[i] / b.signal[i];
+        const signal_t b2 = b.signal[i] * b.signal[i];
+        a.errorSquared[i] = a.errorSquared[i] / b2 + b.errorSquared[i] * f * f / b2;
+        a.signal[i] = f;
+      }
+      if (step.lhsIsScalar)
+        std::copy_n(b.numEvents, size, a.numEvents);
+      break;
+    }
+    case Operation::Log: {
+      const Register a = getRegister(registers, top - 1);
+      for (size_t i = 0; i < size; ++i) {
+        const signal_t value = a.signal[i];
+        if (value <= 0) {
+          a.signal[i] = step.value;
+          a.errorSquared[i] = 0;
+        } else {
+          a.signal[i] = std::log(value);
+          a.errorSquared[i] = a.errorSquared[i] / (value * value);
+        }
+      }
+      break;
+    }
+    case Operation::Log10: {
+      const Register a = getRegister(registers, top - 1);
+      for (size_t i = 0; i < size; ++i) {
+        const signal_t value = a.signal[i];
+        if (value <= 0) {
+          a.signal[i] = step.value;
+          a.errorSquared[i] = 0;
+        } else {
+          a.signal[i] = std::log10(value);
+          a.errorSquared[i] = 0.1886117 * a.errorSquared[i] / (value * value); // 0.1886117  = ln(10)^-2
+        }
+      }
+      break;
+    }
+    case Operation::Exp: {
+      const Register a = getRegister(registers, top - 1);
+      for (size_t i = 0; i < size; ++i) {
+        const signal_t f = std::exp(a.signal[i]);
+        a.signal[i] = f;
+        a.errorSquared[i] = f * f * a.errorSquared[i];
+      }
+      break;
+    }
+    case Operation::Power: {
+      const Register a = getRegister(registers, top - 1);
+      const double exponent = step.value;
+      for (size_t i = 0; i < size; ++i) {
+        const signal_t value = a.signal[i];
+        const signal_t f = std::pow(value, exponent);
+        a.signal[i] = f;
+        a.errorSquared[i] = f * f * exponent * exponent * a.errorSquared[i] / (value * value);
+      }
+      break;
+    }
+    }
+  }
+}
+
+} // namespace Mantid::DataObjects
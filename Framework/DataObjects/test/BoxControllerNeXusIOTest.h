@@ -205,12 +205,13 @@ public:
     }
   };
 
-  template <typename FROM, typename TO> void WriteReadRead() {
+  template <typename FROM, typename TO> void WriteReadRead(const bool compressColumns = false) {
     using Mantid::DataObjects::BoxControllerNeXusIO;
 
     BoxControllerNeXusIO *pSaver(nullptr);
     TS_ASSERT_THROWS_NOTHING(pSaver = createTestBoxController());
     pSaver->setDataType(sizeof(FROM), "MDEvent");
+    pSaver->setCompressedColumns(compressColumns);
     std::string FullPathFile;
 
     TS_ASSERT_THROWS_NOTHING(pSaver->openFile(this->xxfFileName, "w"));
@@ -230,9 +231,12 @@ public:
 
     IF<FROM, TO>::compareReadTheSame(pSaver, toWrite, nEvents, nColumns);
 
-    // open and read what was written,
+    // open and read what was written, finding the layout from the file
+    delete pSaver;
+    pSaver = createTestBoxController();
     pSaver->setDataType(sizeof(TO), "MDEvent");
     TS_ASSERT_THROWS_NOTHING(pSaver->openFile(FullPathFile, "r"));
+    TS_ASSERT_EQUALS(pSaver->compressedColumns(), compressColumns);
     std::vector<TO> toRead2;
     TS_ASSERT_THROWS_NOTHING(pSaver->loadBlock(toRead2, 100 + (nEvents - 1), 1));
     for (size_t i = 0; i < nColumns; i++) {
@@ -250,6 +254,11 @@ public:
 
   void test_WriteFloatReadDouble() { this->WriteReadRead<float, double>(); }
 
+  void test_WriteReadCompressedColumns() {
+    this->WriteReadRead<float, float>(true);
+    this->WriteReadRead<double, float>(true);
+  }
+
   void test_dataEventCount() {
     using Mantid::DataObjects::BoxControllerNeXusIO;
     using EDV = BoxControllerNeXusIO::EventDataVersion;
@@ -11,6 +11,7 @@
 #include "MantidDataObjects/EventWorkspace.h"
 #include "MantidDataObjects/Histogram1D.h"
 #include "MantidKernel/CPUTimer.h"
+#include "MantidKernel/MultiThreaded.h"
 #include "MantidKernel/Timer.h"
 #include "MantidKernel/Unit.h"
 
@@ -1163,6 +1164,68 @@ public:
     }
   }
 
+  void test_histogram_with_bins_inside_event_range() {
+    // Only the events between the first and last bin boundary are counted
+    MantidVec shared_x;
+    for (double tof = BIN_DELTA * 10; tof <= BIN_DELTA * 20; tof += BIN_DELTA)
+      shared_x.emplace_back(tof);
+    for (auto weighted : {false, true}) {
+      if (weighted)
+        this->fake_uniform_data_weights();
+      else
+        this->fake_uniform_data();
+      el.setX(make_cow<HistogramX>(shared_x));
+      const EventList el3(el);
+      MantidVec X = el3.readX();
+      boost::scoped_ptr<MantidVec> Y(el3.makeDataY());
+      TS_ASSERT_EQUALS(Y->size(), 10);
+      for (std::size_t i = 0; i < Y->size(); i++) {
+        TS_ASSERT_EQUALS((*Y)[i], weighted ? 4.0 : 2.0);
+      }
+    }
+  }
+
+  void test_histogram_linear_and_log_bins_unsorted_events() {
+    // Linear and logarithmic bins are found without sorting the events
+    MantidVec linearX, logX;
+    for (double tof = 50.; tof < 9000.; tof += 123.)
+      linearX.emplace_back(tof);
+    for (double tof = 50.; tof < 9000.; tof *= 1.1)
+      logX.emplace_back(tof);
+    // Rebin clips the final bin
+    logX.emplace_back(9000.);
+
+    srand(1234);
+    for (auto weighted : {false, true}) {
+      el = EventList();
+      for (int i = 0; i < 5000; i++)
+        el += TofEvent(static_cast<double>(rand() % 10000) + 0.5 * (i % 2), 0);
+      // Events exactly on bin edges
+      el += TofEvent(linearX[3], 0);
+      el += TofEvent(logX[7], 0);
+      if (weighted)
+        el *= 2.0;
+
+      for (const auto &X : {linearX, logX}) {
+        MantidVec Y, E;
+        el.generateHistogram(X, Y, E);
+        TS_ASSERT_EQUALS(el.getSortType(), UNSORTED);
+
+        std::vector<double> tofs = el.getTofs();
+        MantidVec expected(X.size() - 1, 0.);
+        for (const auto tof : tofs) {
+          if (tof >= X.front() && tof < X.back())
+            expected[std::upper_bound(X.cbegin(), X.cend(), tof) - X.cbegin() - 1] += weighted ? 2. : 1.;
+        }
+        TS_ASSERT_EQUALS(Y.size(), expected.size());
+        for (size_t i = 0; i < Y.size(); ++i) {
+          TS_ASSERT_DELTA(Y[i], expected[i], 1e-10);
+          TS_ASSERT_DELTA(E[i], weighted ? 2. * std::sqrt(expected[i] / 2.) : std::sqrt(expected[i]), 1e-10);
+        }
+      }
+    }
+  }
+
   void test_random_histogram() {
     this->fake_data();
     this->test_setX();
@@ -1459,6 +1522,26 @@ public:
     }
   }
 
+  void test_convertUnitsViaTof_with_coefficients_matches_units() {
+    // Both units have TOFCoefficients, so the events are converted without
+    // calling the units per event
+    Mantid::Kernel::Units::dSpacing fromUnit;
+    Mantid::Kernel::Units::Momentum toUnit;
+    fromUnit.initialize(10., 0, {{UnitParams::difc, 3000.}, {UnitParams::tzero, 2.}});
+    toUnit.initialize(10., 0, {{UnitParams::l2, 2.}});
+    for (int this_type = 0; this_type < 3; this_type++) {
+      this->fake_uniform_data();
+      el.switchTo(static_cast<EventType>(this_type));
+      EventList input(el);
+      this->el.convertUnitsViaTof(&fromUnit, &toUnit);
+      TS_ASSERT_EQUALS(input.getNumberEvents(), el.getNumberEvents());
+      for (size_t i = 0; i < el.getNumberEvents(); ++i) {
+        const double expected = toUnit.singleFromTOF(fromUnit.singleToTOF(input.getEvent(i).tof()));
+        TSM_ASSERT_DELTA(this_type, el.getEvent(i).tof(), expected, 1e-12 * std::abs(expected));
+      }
+    }
+  }
+
   void test_addPulseTime_allTypes() {
     // Go through each possible EventType as the input
     for (int this_type = 0; this_type < 3; this_type++) {
@@ -1622,6 +1705,49 @@ public:
     }
   }
 
+  void test_sort_large_lists() {
+    // Lists this large are radix sorted
+    for (int this_type = 0; this_type < 3; this_type++) {
+      EventType curType = static_cast<EventType>(this_type);
+      srand(1234);
+      el = EventList();
+      for (int i = 0; i < 100000; i++) {
+        // Include negative and repeated times-of-flight, and pulse times
+        // before the epoch
+        const double tof = static_cast<double>(rand() % 20000 - 1000) / 3.;
+        el += TofEvent(tof, DateAndTime(static_cast<int64_t>(rand() % 600 - 100) * 16666667));
+      }
+      el.switchTo(curType);
+      double sumTof = 0;
+      for (size_t i = 0; i < el.getNumberEvents(); i++)
+        sumTof += el.getEvent(i).tof();
+
+      el.sortTof();
+      TS_ASSERT_EQUALS(el.getNumberEvents(), 100000);
+      for (size_t i = 1; i < el.getNumberEvents(); i++)
+        TSM_ASSERT_LESS_THAN_EQUALS(this_type, el.getEvent(i - 1).tof(), el.getEvent(i).tof());
+      double sortedSumTof = 0;
+      for (size_t i = 0; i < el.getNumberEvents(); i++)
+        sortedSumTof += el.getEvent(i).tof();
+      TS_ASSERT_DELTA(sortedSumTof, sumTof, 1e-6 * std::abs(sumTof));
+
+      if (curType == WEIGHTED_NOTIME)
+        continue;
+
+      el.sortPulseTime();
+      for (size_t i = 1; i < el.getNumberEvents(); i++)
+        TSM_ASSERT_LESS_THAN_EQUALS(this_type, el.getEvent(i - 1).pulseTime(), el.getEvent(i).pulseTime());
+
+      el.sortTof();
+      el.sortPulseTimeTOF();
+      for (size_t i = 1; i < el.getNumberEvents(); i++) {
+        TSM_ASSERT_LESS_THAN_EQUALS(this_type, el.getEvent(i - 1).pulseTime(), el.getEvent(i).pulseTime());
+        if (el.getEvent(i - 1).pulseTime() == el.getEvent(i).pulseTime())
+          TSM_ASSERT_LESS_THAN_EQUALS(this_type, el.getEvent(i - 1).tof(), el.getEvent(i).tof());
+      }
+    }
+  }
+
   //-----------------------------------------------------------------------------------------------
   void test_filterByPulseTime() {
     // Go through each possible EventType (except the no-time one) as the input
@@ -1943,6 +2069,45 @@ public:
     delete outputs.front();
   }
 
+  //-----------------------------------------------------------------------------------------------
+  void test_splitByTime_many_slices_matches_scan() {
+    // Several events per pulse, with gaps, out of order
+    EventList input;
+    for (int i = 0; i < 5000; ++i)
+      input += TofEvent(double(i % 7), DateAndTime(int64_t((i * 7919) % 4999 / 3 * 3)));
+
+    const size_t numSlices = 300;
+    std::vector<EventList *> outputs;
+    TimeSplitterType split;
+    for (size_t i = 0; i < numSlices; ++i) {
+      outputs.emplace_back(new EventList());
+      split.emplace_back(SplittingInterval(int64_t(i * 17), int64_t(i * 17 + 11), int(i)));
+    }
+
+    input.splitByTime(split, outputs);
+
+    for (size_t i = 0; i < numSlices; ++i) {
+      size_t expected = 0;
+      for (const auto &event : input.getEvents())
+        if (event.pulseTime() >= split[i].start() && event.pulseTime() < split[i].stop())
+          ++expected;
+      TS_ASSERT_EQUALS(outputs[i]->getNumberEvents(), expected);
+      const auto &events = outputs[i]->getEvents();
+      TS_ASSERT(std::all_of(events.cbegin(), events.cend(), [&](const TofEvent &event) {
+        return event.pulseTime() >= split[i].start() && event.pulseTime() < split[i].stop();
+      }));
+      delete outputs[i];
+    }
+
+    // Filtering in place keeps the union of the slices
+    size_t expectedTotal = 0;
+    for (const auto &event : input.getEvents())
+      if (event.pulseTime().totalNanoseconds() % 17 < 11 && event.pulseTime().totalNanoseconds() < 17 * 300)
+        ++expectedTotal;
+    input.filterInPlace(split);
+    TS_ASSERT_EQUALS(input.getNumberEvents(), expectedTotal);
+  }
+
   //-----------------------------------------------------------------------------------------------
   void do_testSplit_FilterInPlace(bool weighted) {
     this->fake_uniform_time_data();
@@ -2189,6 +2354,52 @@ public:
     TS_ASSERT_DIFFERS(uniformOut, varyingOut);
   }
 
+  void test_compressEvents_logarithmic() {
+    el = EventList();
+    for (const double tof : {1.0, 1.05, 1.2, 100., 104., 111.})
+      el.addEventQuickly(TofEvent(tof, 0));
+
+    EventList el_out;
+    // Negative tolerance is relative to the TOF, here 10%
+    TS_ASSERT_THROWS_NOTHING(el.compressEvents(-0.1, &el_out));
+    TS_ASSERT_EQUALS(el_out.getNumberEvents(), 4);
+    if (el_out.getNumberEvents() == 4) {
+      TS_ASSERT_DELTA(el_out.getEvent(0).tof(), 1.025, 1e-5);
+      TS_ASSERT_DELTA(el_out.getEvent(0).weight(), 2., 1e-5);
+      TS_ASSERT_DELTA(el_out.getEvent(1).tof(), 1.2, 1e-5);
+      TS_ASSERT_DELTA(el_out.getEvent(2).tof(), 102., 1e-5);
+      TS_ASSERT_DELTA(el_out.getEvent(2).weight(), 2., 1e-5);
+      TS_ASSERT_DELTA(el_out.getEvent(3).tof(), 111., 1e-5);
+    }
+  }
+
+  void test_compressEvents_parallel_matches_serial() {
+    el = EventList();
+    // Irregular spacing so that groups straddle the blocks of the threads
+    for (int i = 0; i < 500000; i++)
+      el.addEventQuickly(TofEvent(static_cast<double>(i) * 0.01 + 0.004 * std::sin(static_cast<double>(i)), 0));
+
+    EventList serial;
+    el.compressEvents(1.0, &serial);
+    EventList serialLog;
+    el.compressEvents(-0.001, &serialLog);
+
+    const int maxThreads = PARALLEL_GET_MAX_THREADS;
+    for (const int numThreads : {2, 3, 4, 7}) {
+      PARALLEL_SET_NUM_THREADS(numThreads);
+      EventList parallel;
+      el.compressEvents(1.0, &parallel, true);
+      TS_ASSERT_EQUALS(parallel.getEventType(), WEIGHTED_NOTIME);
+      TS_ASSERT(parallel.isSortedByTof());
+      TS_ASSERT_EQUALS(parallel, serial);
+
+      EventList parallelLog;
+      el.compressEvents(-0.001, &parallelLog, true);
+      TS_ASSERT_EQUALS(parallelLog, serialLog);
+    }
+    PARALLEL_SET_NUM_THREADS(maxThreads);
+  }
+
   void test_getEventsFrom() {
     std::vector<TofEvent> *rel;
     TS_ASSERT_THROWS_NOTHING(getEventsFrom(el, rel));
@@ -10,6 +10,7 @@
 #include "MantidKernel/Timer.h"
 #include <cxxtest/TestSuite.h>
 
+#include "MantidDataObjects/EventList.h"
 #include "MantidDataObjects/EventWorkspaceMRU.h"
 
 using namespace Mantid::DataObjects;
@@ -21,4 +22,68 @@ public:
     TS_ASSERT_THROWS_NOTHING(mru.MRUSize());
     TS_ASSERT_EQUALS(mru.MRUSize(), 0);
   }
+
+  void test_find_returns_inserted_data_of_same_generation() {
+    EventWorkspaceMRU mru;
+    EventList list;
+    const auto generation = EventWorkspaceMRU::nextGeneration();
+    auto y = Mantid::Kernel::make_cow<Mantid::HistogramData::HistogramY>(3, 2.0);
+    mru.insertY(0, y, &list, generation);
+    TS_ASSERT_EQUALS(mru.MRUSize(), 1);
+
+    auto found = mru.findY(0, &list, generation);
+    TS_ASSERT(found);
+    TS_ASSERT_EQUALS(found->rawData(), y->rawData());
+    // Other threads have their own lists
+    TS_ASSERT(!mru.findY(1, &list, generation));
+  }
+
+  void test_new_generation_is_a_miss_and_replaces_entry() {
+    EventWorkspaceMRU mru;
+    EventList list;
+    const auto oldGeneration = EventWorkspaceMRU::nextGeneration();
+    mru.insertE(0, Mantid::Kernel::make_cow<Mantid::HistogramData::HistogramE>(3, 1.0), &list, oldGeneration);
+
+    const auto newGeneration = EventWorkspaceMRU::nextGeneration();
+    TS_ASSERT_DIFFERS(oldGeneration, newGeneration);
+    TS_ASSERT(!mru.findE(0, &list, newGeneration));
+
+    mru.insertE(0, Mantid::Kernel::make_cow<Mantid::HistogramData::HistogramE>(3, 4.0), &list, newGeneration);
+    auto found = mru.findE(0, &list, newGeneration);
+    TS_ASSERT(found);
+    TS_ASSERT_EQUALS((*found)[0], 4.0);
+    TS_ASSERT(!mru.findE(0, &list, oldGeneration));
+  }
+
+  void test_statistics() {
+    EventWorkspaceMRU mru;
+    EventList list;
+    const auto generation = EventWorkspaceMRU::nextGeneration();
+    TS_ASSERT_EQUALS(mru.statistics().hitRate(), 0.);
+
+    TS_ASSERT(!mru.findY(0, &list, generation));
+    mru.insertY(0, Mantid::Kernel::make_cow<Mantid::HistogramData::HistogramY>(3, 2.0), &list, generation);
+    TS_ASSERT(mru.findY(0, &list, generation));
+    TS_ASSERT(mru.findY(0, &list, generation));
+    TS_ASSERT(mru.findY(0, &list, generation));
+
+    const auto stats = mru.statistics();
+    TS_ASSERT_EQUALS(stats.hits, 3);
+    TS_ASSERT_EQUALS(stats.misses, 1);
+    TS_ASSERT_DELTA(stats.hitRate(), 0.75, 1e-12);
+
+    mru.resetStatistics();
+    TS_ASSERT_EQUALS(mru.statistics().hits, 0);
+    TS_ASSERT_EQUALS(mru.statistics().misses, 0);
+  }
+
+  void test_clear() {
+    EventWorkspaceMRU mru;
+    EventList list;
+    const auto generation = EventWorkspaceMRU::nextGeneration();
+    mru.insertY(0, Mantid::Kernel::make_cow<Mantid::HistogramData::HistogramY>(3, 2.0), &list, generation);
+    mru.clear();
+    TS_ASSERT_EQUALS(mru.MRUSize(), 0);
+    TS_ASSERT(!mru.findY(0, &list, generation));
+  }
 };
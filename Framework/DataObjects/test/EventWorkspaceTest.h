@@ -407,6 +407,21 @@ public:
     TS_ASSERT_EQUALS(ew2->MRUSize(), 0);
   }
 
+  void test_histogram_cache_hit_rate() {
+    EventWorkspace_const_sptr ew2 = ew;
+    TS_ASSERT_EQUALS(ew2->MRUHitRate(), 0.);
+
+    // First read generates, the next three are cached
+    for (int i = 0; i < 4; i++)
+      ew2->y(1);
+    TS_ASSERT_DELTA(ew2->MRUHitRate(), 0.75, 1e-12);
+
+    // Changing the binning invalidates the cached histogram
+    ew->setSharedX(1, ew->sharedX(0));
+    ew2->y(1);
+    TS_ASSERT_DELTA(ew2->MRUHitRate(), 0.6, 1e-12);
+  }
+
   void test_histogram_cache_dataE() {
     // Try caching and most-recently-used MRU list.
     EventWorkspace_const_sptr ew2 = ew;
@@ -639,6 +654,37 @@ public:
     }
   }
 
+  /** Test sortAll() on many lists large enough that each is radix sorted in
+   * parallel, while sortAll runs over the lists in parallel too.
+   */
+  void test_sortAll_many_large_lists() {
+    constexpr size_t numSpectra = 24;
+    constexpr size_t numEvents = 150000;
+    auto test_in = std::make_shared<EventWorkspace>();
+    test_in->initialize(numSpectra, 2, 1);
+    std::vector<std::vector<TofEvent>> expected(numSpectra);
+    uint64_t seed = 12345;
+    for (size_t wi = 0; wi < numSpectra; wi++) {
+      auto &el = test_in->getSpectrum(wi);
+      for (size_t i = 0; i < numEvents; i++) {
+        seed = seed * 6364136223846793005ULL + 1442695040888963407ULL;
+        const TofEvent event(static_cast<double>(seed >> 44), static_cast<int64_t>((seed >> 20) & 0xFFFF));
+        el.addEventQuickly(event);
+        expected[wi].emplace_back(event);
+      }
+      std::sort(expected[wi].begin(), expected[wi].end(), [](const TofEvent &e1, const TofEvent &e2) {
+        return e1.pulseTime() < e2.pulseTime() || (e1.pulseTime() == e2.pulseTime() && e1.tof() < e2.tof());
+      });
+    }
+
+    test_in->sortAll(PULSETIMETOF_SORT, nullptr);
+
+    for (size_t wi = 0; wi < numSpectra; wi++) {
+      TSM_ASSERT("Spectrum " + std::to_string(wi) + " was not sorted correctly",
+                 test_in->getSpectrum(wi).getEvents() == expected[wi]);
+    }
+  }
+
   /** Nov 29 2010, ticket #1974
    * SegFault on data access through MRU list.
    * Test that parallelization is thread-safe
@@ -114,6 +114,8 @@ public:
   void integrateSphere(Mantid::API::CoordTransform & /*radiusTransform*/, const coord_t /*radiusSquared*/,
                        signal_t & /*signal*/, signal_t & /*errorSquared*/, const coord_t /*innerRadiusSquared*/,
                        const bool /*useOnePercentBackgroundCorrection*/) const override{};
+  void integrateSpheres(const std::vector<MDIntegrationSphere> & /*spheres*/, const std::vector<size_t> & /*active*/,
+                        signal_t * /*signal*/, signal_t * /*errorSquared*/) const override{};
   void centroidSphere(Mantid::API::CoordTransform & /*radiusTransform*/, const coord_t /*radiusSquared*/, coord_t *,
                       signal_t &) const override{};
   void integrateCylinder(Mantid::API::CoordTransform & /*radiusTransform*/, const coord_t /*radius*/,
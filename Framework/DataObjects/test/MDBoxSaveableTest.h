@@ -211,6 +211,23 @@ public:
     TS_ASSERT_DELTA(events[2].getSignal(), 2 + base, 1e-5);
     TS_ASSERT_DELTA(events[9].getErrorSquared(), (base + 9) * (base + 9), 1e-5);
   }
+
+  //-----------------------------------------------------------------------------------------
+  /** Loading the same box on several threads at once loads its events once */
+  void test_concurrent_loads() {
+    MDBox<MDLeanEvent<3>, 3> c(sc.get());
+    auto loader = std::shared_ptr<API::IBoxControllerIO>(new MantidTestHelpers::BoxControllerDummyIO(sc.get()));
+    loader->setDataType(c.getCoordType(), c.getEventType());
+    sc->setFileBacked(loader, "existingDummy");
+    c.setFileBacked(3, 10, true);
+
+    PARALLEL_FOR_NO_WSP_CHECK()
+    for (int i = 0; i < 8; ++i)
+      c.getISaveable()->load();
+
+    TS_ASSERT_EQUALS(c.getDataInMemorySize(), 10);
+  }
+
   /** Test splitting of a MDBox into a MDGridBox when the
    * original box is backed by a file. */
   void test_fileBackEnd_construction() {
@@ -216,6 +216,25 @@ public:
     delete g;
   }
 
+  //-------------------------------------------------------------------------------------
+  void test_MDGridBox_constructor_from_MDBox_reserves_exact_event_storage() {
+    MDBox<MDLeanEvent<1>, 1> *b = MDEventsTestHelper::makeMDBox1();
+    b->addEvents(MDEventsTestHelper::makeMDEvents1(10));
+    BoxController *const bc = b->getBoxController();
+
+    auto g = new MDGridBox<MDLeanEvent<1>, 1>(b);
+    // Each child has room for exactly its events
+    for (auto child : g->getBoxes()) {
+      auto box = dynamic_cast<MDBox<MDLeanEvent<1>, 1> *>(child);
+      TS_ASSERT_EQUALS(box->getConstEvents().capacity(), 1);
+      box->releaseEvents();
+    }
+
+    delete g;
+    delete b;
+    delete bc;
+  }
+
   //-------------------------------------------------------------------------------------
   void test_MDGridBox_copy_constructor() {
     MDBox<MDLeanEvent<1>, 1> *b = MDEventsTestHelper::makeMDBox1(10);
@@ -0,0 +1,166 @@
+// Mantid Repository : https://github.com/mantidproject/mantid
+//
+// Copyright &copy; 2022 ISIS Rutherford Appleton Laboratory UKRI,
+//   NScD Oak Ridge National Laboratory, European Spallation Source,
+//   Institut Laue - Langevin & CSNS, Institute of High Energy Physics, CAS
+// SPDX - License - Identifier: GPL - 3.0 +
+#pragma once
+
+#include "MantidDataObjects/MDHistoExpression.h"
+#include "MantidDataObjects/MDHistoWorkspace.h"
+#include "MantidFrameworkTestHelpers/MDEventsTestHelper.h"
+
+#include <cxxtest/TestSuite.h>
+
+#include <random>
+
+using namespace Mantid;
+using namespace Mantid::DataObjects;
+
+class MDHistoExpressionTest : public CxxTest::TestSuite {
+public:
+  // This pair of boilerplate methods prevent the suite being created statically
+  // This means the constructor isn't called when running other tests
+  static MDHistoExpressionTest *createSuite() { return new MDHistoExpressionTest(); }
+  static void destroySuite(MDHistoExpressionTest *suite) { delete suite; }
+
+  void setUp() override {
+    // 2500 bins: two full blocks and a partial one
+    m_a = makeRandomWorkspace(1);
+    m_b = makeRandomWorkspace(2);
+    m_c = makeRandomWorkspace(3);
+    m_out = MDEventsTestHelper::makeFakeMDHistoWorkspace(0., 2, 50);
+  }
+
+  void test_binary_operations_match_the_workspace_methods() {
+    auto expected = m_a->clone();
+    expected->add(*m_b);
+    (MDHistoExpression(*m_a) + *m_b).evaluateInto(*m_out);
+    assertSame(*expected, *m_out);
+
+    expected = m_a->clone();
+    expected->subtract(*m_b);
+    (MDHistoExpression(*m_a) - *m_b).evaluateInto(*m_out);
+    assertSame(*expected, *m_out);
+
+    expected = m_a->clone();
+    expected->multiply(*m_b);
+    (MDHistoExpression(*m_a) * *m_b).evaluateInto(*m_out);
+    assertSame(*expected, *m_out);
+
+    expected = m_a->clone();
+    expected->divide(*m_b);
+    (MDHistoExpression(*m_a) / *m_b).evaluateInto(*m_out);
+    assertSame(*expected, *m_out);
+  }
+
+  void test_scalar_operands() {
+    auto expected = m_a->clone();
+    expected->subtract(1.5, 0.5);
+    (MDHistoExpression(*m_a) - MDHistoExpression(1.5, 0.5)).evaluateInto(*m_out);
+    assertSame(*expected, *m_out);
+
+    expected = m_a->clone();
+    expected->divide(3.0, 0.25);
+    (MDHistoExpression(*m_a) / MDHistoExpression(3.0, 0.25)).evaluateInto(*m_out);
+    assertSame(*expected, *m_out);
+
+    // A scalar on the left takes the event counts from the workspace
+    expected = m_a->clone();
+    expected->multiply(2.0, 0.1);
+    (MDHistoExpression(2.0, 0.1) * *m_a).evaluateInto(*m_out);
+    assertSame(*expected, *m_out);
+  }
+
+  void test_unary_operations_match_the_workspace_methods() {
+    // Some bins <= 0 to use the filler
+    auto shifted = m_a->clone();
+    shifted->subtract(1.0, 0.);
+
+    auto expected = shifted->clone();
+    expected->log(-1.);
+    MDHistoExpression(*shifted).log(-1.).evaluateInto(*m_out);
+    assertSame(*expected, *m_out);
+
+    expected = shifted->clone();
+    expected->log10(-2.);
+    MDHistoExpression(*shifted).log10(-2.).evaluateInto(*m_out);
+    assertSame(*expected, *m_out);
+
+    expected = m_a->clone();
+    expected->exp();
+    MDHistoExpression(*m_a).exp().evaluateInto(*m_out);
+    assertSame(*expected, *m_out);
+
+    expected = m_a->clone();
+    expected->power(2.5);
+    MDHistoExpression(*m_a).power(2.5).evaluateInto(*m_out);
+    assertSame(*expected, *m_out);
+  }
+
+  void test_chained_expression_matches_the_workspace_methods() {
+    // (a - b) / c * 2 - b / c
+    auto expected = m_a->clone();
+    expected->subtract(*m_b);
+    expected->divide(*m_c);
+    expected->multiply(2.0, 0.);
+    auto bc = m_b->clone();
+    bc->divide(*m_c);
+    expected->subtract(*bc);
+
+    const auto expression = (MDHistoExpression(*m_a) - *m_b) / *m_c * 2.0 - MDHistoExpression(*m_b) / *m_c;
+    expression.evaluateInto(*m_out);
+    assertSame(*expected, *m_out);
+  }
+
+  void test_output_can_be_an_input() {
+    auto expected = m_a->clone();
+    expected->subtract(*m_b);
+    expected->divide(*m_a);
+    ((MDHistoExpression(*m_a) - *m_b) / *m_a).evaluateInto(*m_a);
+    assertSame(*expected, *m_a);
+  }
+
+  void test_mask_is_left_alone() {
+    m_out->setMDMaskAt(7, true);
+    (MDHistoExpression(*m_a) + *m_b).evaluateInto(*m_out);
+    TS_ASSERT(m_out->getIsMaskedAt(7));
+    TS_ASSERT(!m_out->getIsMaskedAt(8));
+  }
+
+  void test_different_sizes_throw() {
+    auto small = MDEventsTestHelper::makeFakeMDHistoWorkspace(1., 2, 10);
+    TS_ASSERT_THROWS((MDHistoExpression(*m_a) + *small).evaluateInto(*m_out), const std::invalid_argument &);
+    TS_ASSERT_THROWS(MDHistoExpression(*m_a).evaluateInto(*small), const std::invalid_argument &);
+  }
+
+  void test_scalar_expression_throws() {
+    const auto expression = MDHistoExpression(1.) + 2.;
+    TS_ASSERT(expression.isScalar());
+    TS_ASSERT_THROWS(expression.evaluateInto(*m_out), const std::invalid_argument &);
+  }
+
+private:
+  static MDHistoWorkspace_sptr makeRandomWorkspace(const unsigned int seed) {
+    auto ws = MDEventsTestHelper::makeFakeMDHistoWorkspace(0., 2, 50);
+    std::mt19937 generator(seed);
+    std::uniform_real_distribution<double> values(0.5, 3.0);
+    for (size_t i = 0; i < ws->getNPoints(); ++i) {
+      ws->setSignalAt(i, values(generator));
+      ws->setErrorSquaredAt(i, values(generator));
+      ws->setNumEventsAt(i, values(generator));
+    }
+    return ws;
+  }
+
+  static void assertSame(const MDHistoWorkspace &expected, const MDHistoWorkspace &actual) {
+    for (size_t i = 0; i < expected.getNPoints(); ++i) {
+      TS_ASSERT_DELTA(actual.getSignalAt(i), expected.getSignalAt(i), 1e-10);
+      TS_ASSERT_DELTA(actual.getErrorAt(i) * actual.getErrorAt(i), expected.getErrorAt(i) * expected.getErrorAt(i),
+                      1e-10);
+      TS_ASSERT_DELTA(actual.getNumEventsAt(i), expected.getNumEventsAt(i), 1e-10);
+    }
+  }
+
+  MDHistoWorkspace_sptr m_a, m_b, m_c, m_out;
+};
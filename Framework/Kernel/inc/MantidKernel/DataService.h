@@ -18,7 +18,12 @@
 #include "MantidKernel/Logger.h"
 #include <Poco/Notification.h>
 #include <Poco/NotificationCenter.h>
+#include <array>
+#include <cctype>
+#include <cstdint>
 #include <mutex>
+#include <shared_mutex>
+#include <unordered_map>
 
 #ifdef _WIN32
 #define strcasecmp _stricmp
@@ -44,6 +49,26 @@ struct CaseInsensitiveCmp {
   }
 };
 
+// Case-insensitive equality functor for std::unordered_map
+struct CaseInsensitiveEqual {
+  bool operator()(const std::string &lhs, const std::string &rhs) const {
+    return lhs.size() == rhs.size() && strcasecmp(lhs.c_str(), rhs.c_str()) == 0;
+  }
+};
+
+// Case-insensitive hash functor for std::unordered_map: FNV-1a of the
+// lower-case characters, without making a lower-case copy
+struct CaseInsensitiveHash {
+  size_t operator()(const std::string &name) const {
+    uint64_t hash = 14695981039346656037ull;
+    for (const char c : name) {
+      hash ^= static_cast<uint64_t>(std::tolower(static_cast<unsigned char>(c)));
+      hash *= 1099511628211ull;
+    }
+    return static_cast<size_t>(hash);
+  }
+};
+
 /** DataService stores instances of a given type.
     This is a templated class, designed to be implemented as a
     singleton. For simplicity and naming conventions, specialized classes must
@@ -58,11 +83,15 @@ struct CaseInsensitiveCmp {
 template <typename T> class DLLExport DataService {
 private:
   /// Typedef for the map holding the names of and pointers to the data objects
-  using svcmap = std::map<std::string, std::shared_ptr<T>, CaseInsensitiveCmp>;
+  using svcmap = std::unordered_map<std::string, std::shared_ptr<T>, CaseInsensitiveHash, CaseInsensitiveEqual>;
   /// Iterator for the data store map
   using svc_it = typename svcmap::iterator;
   /// Const iterator for the data store map
   using svc_constit = typename svcmap::const_iterator;
+  /// Number of shards, as a power of two
+  static constexpr size_t SHARD_BITS = 4;
+  /// Number of shards the objects are spread over
+  static constexpr size_t NUM_SHARDS = size_t(1) << SHARD_BITS;
 
 public:
   /// Class for named object notifications
@@ -194,12 +223,13 @@ public:
     bool success = false;
     {
       // Make DataService access thread-safe
-      std::lock_guard<std::recursive_mutex> lock(m_mutex);
+      Shard &shard = m_shards[shardIndex(name)];
+      std::unique_lock<std::shared_mutex> lock(shard.mutex);
       // At the moment, you can't overwrite an object (i.e. pass in a name
       // that's already in the map with a pointer to a different object).
       // Also, there's nothing to stop the same object from being added
       // more than once with different names.
-      success = datamap.insert(std::make_pair(name, Tobject)).second;
+      success = shard.datamap.emplace(name, Tobject).second;
     }
     if (!success) {
       std::string error = " add : Unable to insert Data Object : '" + name + "'";
@@ -221,28 +251,35 @@ public:
    */
   virtual void addOrReplace(const std::string &name, const std::shared_ptr<T> &Tobject) {
     checkForNullPointer(Tobject);
+    checkForEmptyName(name);
 
-    // Make DataService access thread-safe
-    std::unique_lock<std::recursive_mutex> lock(m_mutex);
-
-    // find if the Tobject already exists
-    auto it = datamap.find(name);
-    if (it != datamap.end()) {
-      lock.unlock();
-      g_log.debug("Data Object '" + name + "' replaced in data service.\n");
-
-      notificationCenter.postNotification(new BeforeReplaceNotification(name, it->second, Tobject));
-
-      lock.lock();
-      it->second = Tobject;
-      lock.unlock();
+    // Add the object if the name is free, else find the one it replaces. Both
+    // under one lock so that two threads adding the same name cannot both add.
+    Shard &shard = m_shards[shardIndex(name)];
+    std::shared_ptr<T> oldObject;
+    {
+      std::unique_lock<std::shared_mutex> lock(shard.mutex);
+      auto it = shard.datamap.find(name);
+      if (it == shard.datamap.end())
+        shard.datamap.emplace(name, Tobject);
+      else
+        oldObject = it->second;
+    }
+    if (!oldObject) {
+      g_log.debug() << "Add Data Object " << name << " successful\n";
+      notificationCenter.postNotification(new AddNotification(name, Tobject));
+      return;
+    }
 
-      notificationCenter.postNotification(new AfterReplaceNotification(name, Tobject));
-    } else {
-      // Avoid double-locking
-      lock.unlock();
-      DataService::add(name, Tobject);
+    g_log.debug("Data Object '" + name + "' replaced in data service.\n");
+    notificationCenter.postNotification(new BeforeReplaceNotification(name, oldObject, Tobject));
+    {
+      std::unique_lock<std::shared_mutex> lock(shard.mutex);
+      // Keeps the name already stored if it differs only in case
+      shard.datamap[name] = Tobject;
     }
+    oldObject.reset();
+    notificationCenter.postNotification(new AfterReplaceNotification(name, Tobject));
   }
 
   //--------------------------------------------------------------------------
@@ -250,10 +287,11 @@ public:
    * @param name :: name of the object */
   void remove(const std::string &name) {
     // Make DataService access thread-safe
-    std::unique_lock<std::recursive_mutex> lock(m_mutex);
+    Shard &shard = m_shards[shardIndex(name)];
+    std::unique_lock<std::shared_mutex> lock(shard.mutex);
 
-    auto it = datamap.find(name);
-    if (it == datamap.end()) {
+    auto it = shard.datamap.find(name);
+    if (it == shard.datamap.end()) {
       lock.unlock();
       g_log.debug(" remove '" + name + "' cannot be found");
       return;
@@ -262,7 +300,7 @@ public:
     // before unlocking the mutex and is held in a local stack variable.
     // This protects it from being modified by another thread.
     auto data = std::move(it->second);
-    datamap.erase(it);
+    shard.datamap.erase(it);
 
     // Do NOT use "it" iterator after this point. Other threads may modify the
     // map
@@ -286,44 +324,45 @@ public:
       return;
     }
 
-    // Make DataService access thread-safe
-    std::unique_lock<std::recursive_mutex> lock(m_mutex);
+    Shard &oldShard = m_shards[shardIndex(oldName)];
+    Shard &newShard = m_shards[shardIndex(newName)];
+    // Only the case changes if the names are equal ignoring it
+    const bool sameEntry = CaseInsensitiveEqual()(oldName, newName);
 
-    auto existingNameIter = datamap.find(oldName);
-    if (existingNameIter == datamap.end()) {
-      lock.unlock();
-      g_log.warning(" rename '" + oldName + "' cannot be found");
-      return;
+    // If we are overriding send a notification for observers
+    std::shared_ptr<T> existingNameObject, targetNameObject;
+    {
+      // Make DataService access thread-safe
+      auto locks = lockShards(oldShard, newShard);
+      auto existingNameIter = oldShard.datamap.find(oldName);
+      if (existingNameIter == oldShard.datamap.end()) {
+        g_log.warning(" rename '" + oldName + "' cannot be found");
+        return;
+      }
+      auto targetNameIter = newShard.datamap.find(newName);
+      if (sameEntry || targetNameIter == newShard.datamap.end()) {
+        moveObject(oldShard, existingNameIter, newShard, newName);
+      } else {
+        existingNameObject = existingNameIter->second;
+        targetNameObject = targetNameIter->second;
+      }
     }
 
-    auto existingNameObject = std::move(existingNameIter->second);
-    auto targetNameIter = datamap.find(newName);
-
-    // If we are overriding send a notification for observers
-    if (targetNameIter != datamap.end()) {
-      auto targetNameObject = targetNameIter->second;
+    if (targetNameObject) {
       // As we are renaming the existing name turns into the new name
-      lock.unlock();
       notificationCenter.postNotification(new BeforeReplaceNotification(newName, targetNameObject, existingNameObject));
-      lock.lock();
-    }
-
-    datamap.erase(existingNameIter);
-
-    if (targetNameIter != datamap.end()) {
-      targetNameIter->second = std::move(existingNameObject);
-      lock.unlock();
-      notificationCenter.postNotification(new AfterReplaceNotification(newName, targetNameIter->second));
-    } else {
-      if (!(datamap.emplace(newName, std::move(existingNameObject)).second)) {
-        // should never happen
-        lock.unlock();
-        std::string error = " add : Unable to insert Data Object : '" + newName + "'";
-        g_log.error(error);
-        throw std::runtime_error(error);
-      } else {
-        lock.unlock();
+      targetNameObject.reset();
+      {
+        auto locks = lockShards(oldShard, newShard);
+        // The observers may have removed the object meanwhile
+        auto existingNameIter = oldShard.datamap.find(oldName);
+        if (existingNameIter == oldShard.datamap.end()) {
+          g_log.warning(" rename '" + oldName + "' cannot be found");
+          return;
+        }
+        moveObject(oldShard, existingNameIter, newShard, newName);
       }
+      notificationCenter.postNotification(new AfterReplaceNotification(newName, existingNameObject));
     }
     g_log.debug("Data Object '" + oldName + "' renamed to '" + newName + "'");
     notificationCenter.postNotification(new RenameNotification(oldName, newName));
@@ -334,8 +373,9 @@ public:
   void clear() {
     {
       // Make DataService access thread-safe
-      std::lock_guard<std::recursive_mutex> lock(m_mutex);
-      datamap.clear();
+      auto locks = lockAllShards<std::unique_lock<std::shared_mutex>>();
+      for (auto &shard : m_shards)
+        shard.datamap.clear();
     }
     notificationCenter.postNotification(new ClearNotification());
     g_log.debug() << typeid(this).name() << " cleared.\n";
@@ -349,10 +389,11 @@ public:
    * @param name :: name of the object */
   std::shared_ptr<T> retrieve(const std::string &name) const {
     // Make DataService access thread-safe
-    std::lock_guard<std::recursive_mutex> _lock(m_mutex);
+    const Shard &shard = m_shards[shardIndex(name)];
+    std::shared_lock<std::shared_mutex> _lock(shard.mutex);
 
-    auto it = datamap.find(name);
-    if (it != datamap.end()) {
+    auto it = shard.datamap.find(name);
+    if (it != shard.datamap.end()) {
       return it->second;
     } else {
       throw Kernel::Exception::NotFoundError("Unable to find Data Object type with name '" + name + "': data service ",
@@ -369,27 +410,32 @@ public:
   /// Check to see if a data object exists in the store
   bool doesExist(const std::string &name) const {
     // Make DataService access thread-safe
-    std::lock_guard<std::recursive_mutex> _lock(m_mutex);
-    auto it = datamap.find(name);
-    return it != datamap.end();
+    const Shard &shard = m_shards[shardIndex(name)];
+    std::shared_lock<std::shared_mutex> _lock(shard.mutex);
+    return shard.datamap.find(name) != shard.datamap.end();
   }
 
   /// Return the number of objects stored by the data service
   size_t size() const {
-    std::lock_guard<std::recursive_mutex> _lock(m_mutex);
+    const bool showingHidden = showingHiddenObjects();
+    auto locks = lockAllShards<std::shared_lock<std::shared_mutex>>();
 
-    if (showingHiddenObjects()) {
-      return datamap.size();
-    } else {
-      return std::count_if(datamap.cbegin(), datamap.cend(),
-                           [](const auto &it) { return !isHiddenDataServiceObject(it.first); });
+    size_t total = 0;
+    for (const auto &shard : m_shards) {
+      if (showingHidden) {
+        total += shard.datamap.size();
+      } else {
+        total += std::count_if(shard.datamap.cbegin(), shard.datamap.cend(),
+                               [](const auto &it) { return !isHiddenDataServiceObject(it.first); });
+      }
     }
+    return total;
   }
 
   /**
    * Returns a vector of strings containing all object names in the ADS
    * @param sortState Whether to sort the output before returning. Defaults
-   * to unsorted
+   * to unsorted, which lists the names in case-insensitive order
    * @param hiddenState Whether to include hidden objects, Defaults to
    * Auto which checks the current configuration to determine behavior.
    * @param contain Include only object names that contain this string.
@@ -410,33 +456,16 @@ public:
       }
     }
 
-    // Use the scoping of an if to handle our lock for duration
-    if (hiddenState == DataServiceHidden::Include) {
-      // Getting hidden items
-      std::lock_guard<std::recursive_mutex> _lock(m_mutex);
-      foundNames.reserve(datamap.size());
-      for (const auto &item : datamap) {
-        if (contain.empty()) {
-          foundNames.emplace_back(item.first);
-        } else if (item.first.find(contain) != std::string::npos) {
-          foundNames.emplace_back(item.first);
-        }
-      }
-      // Lock released at end of scope here
-    } else {
-      std::lock_guard<std::recursive_mutex> _lock(m_mutex);
-      foundNames.reserve(datamap.size());
-      for (const auto &item : datamap) {
-        if (!isHiddenDataServiceObject(item.first)) {
-          // This item is not hidden add it
-          if (contain.empty()) {
-            foundNames.emplace_back(item.first);
-          } else if (item.first.find(contain) != std::string::npos) {
-            foundNames.emplace_back(item.first);
-          }
-        }
+    {
+      // Use the scoping to handle our locks for duration
+      auto locks = lockAllShards<std::shared_lock<std::shared_mutex>>();
+      const auto items = sortedItems(hiddenState == DataServiceHidden::Include);
+      foundNames.reserve(items.size());
+      for (const auto *item : items) {
+        if (contain.empty() || item->first.find(contain) != std::string::npos)
+          foundNames.emplace_back(item->first);
       }
-      // Lock released at end of scope here
+      // Locks released at end of scope here
     }
 
     // Now sort if told to
@@ -447,21 +476,20 @@ public:
     return foundNames;
   }
 
-  /// Get a vector of the pointers to the data objects stored by the service
+  /// Get a vector of the pointers to the data objects stored by the service,
+  /// in case-insensitive order of their names
   std::vector<std::shared_ptr<T>> getObjects(DataServiceHidden includeHidden = DataServiceHidden::Auto) const {
-    std::lock_guard<std::recursive_mutex> _lock(m_mutex);
-
     const bool alwaysIncludeHidden = includeHidden == DataServiceHidden::Include;
     const bool usingAuto = includeHidden == DataServiceHidden::Auto && showingHiddenObjects();
 
     const bool showingHidden = alwaysIncludeHidden || usingAuto;
 
+    auto locks = lockAllShards<std::shared_lock<std::shared_mutex>>();
+    const auto items = sortedItems(showingHidden);
     std::vector<std::shared_ptr<T>> objects;
-    objects.reserve(datamap.size());
-    for (const auto &it : datamap) {
-      if (showingHidden || !isHiddenDataServiceObject(it.first)) {
-        objects.emplace_back(it.second);
-      }
+    objects.reserve(items.size());
+    for (const auto *item : items) {
+      objects.emplace_back(item->second);
     }
     return objects;
   }
@@ -493,6 +521,68 @@ protected:
   virtual ~DataService() = default;
 
 private:
+  /// A part of the objects, with its own lock
+  struct Shard {
+    /// Readers share the lock, writers hold it alone
+    mutable std::shared_mutex mutex;
+    /// Map of the objects in the shard
+    svcmap datamap;
+  };
+
+  /// @return the index of the shard holding the object with the given name
+  static size_t shardIndex(const std::string &name) {
+    // Take the top bits of a multiplicative hash, as the low bits pick the
+    // bucket within the shard
+    const auto hash = static_cast<uint64_t>(CaseInsensitiveHash()(name));
+    return static_cast<size_t>((hash * 0x9E3779B97F4A7C15ull) >> (64 - SHARD_BITS));
+  }
+
+  /// Lock all the shards, in order
+  template <typename LockType> std::array<LockType, NUM_SHARDS> lockAllShards() const {
+    std::array<LockType, NUM_SHARDS> locks;
+    for (size_t i = 0; i < NUM_SHARDS; ++i)
+      locks[i] = LockType(m_shards[i].mutex);
+    return locks;
+  }
+
+  /// Lock one or two shards to write, in order so that two threads cannot
+  /// deadlock
+  std::pair<std::unique_lock<std::shared_mutex>, std::unique_lock<std::shared_mutex>> lockShards(Shard &first,
+                                                                                                 Shard &second) {
+    if (&first == &second)
+      return {std::unique_lock<std::shared_mutex>(first.mutex), std::unique_lock<std::shared_mutex>()};
+    if (&second < &first)
+      return {std::unique_lock<std::shared_mutex>(second.mutex), std::unique_lock<std::shared_mutex>(first.mutex)};
+    return {std::unique_lock<std::shared_mutex>(first.mutex), std::unique_lock<std::shared_mutex>(second.mutex)};
+  }
+
+  /// Move an object to a new name, replacing any object there. Both shards
+  /// must be locked.
+  void moveObject(Shard &oldShard, svc_it existingNameIter, Shard &newShard, const std::string &newName) {
+    auto object = std::move(existingNameIter->second);
+    oldShard.datamap.erase(existingNameIter);
+    auto targetNameIter = newShard.datamap.find(newName);
+    if (targetNameIter != newShard.datamap.end())
+      targetNameIter->second = std::move(object);
+    else
+      newShard.datamap.emplace(newName, std::move(object));
+  }
+
+  /// The items of all the shards in case-insensitive order of their names.
+  /// All the shards must be locked.
+  std::vector<const typename svcmap::value_type *> sortedItems(const bool includeHidden) const {
+    std::vector<const typename svcmap::value_type *> items;
+    for (const auto &shard : m_shards) {
+      for (const auto &item : shard.datamap) {
+        if (includeHidden || !isHiddenDataServiceObject(item.first))
+          items.emplace_back(&item);
+      }
+    }
+    std::sort(items.begin(), items.end(),
+              [](const auto *lhs, const auto *rhs) { return CaseInsensitiveCmp()(lhs->first, rhs->first); });
+    return items;
+  }
+
   void checkForEmptyName(const std::string &name) {
     if (name.empty()) {
       const std::string error = "Add Data Object with empty name";
@@ -512,10 +602,9 @@ private:
   /// DataService name. This is set only at construction. DataService name
   /// should be provided when construction of derived classes
   const std::string svcName;
-  /// Map of objects in the data service
-  svcmap datamap;
-  /// Recursive mutex to avoid simultaneous access or notifications
-  mutable std::recursive_mutex m_mutex;
+  /// The objects in the data service, spread over shards by the hash of
+  /// their name so that threads using different objects rarely contend
+  std::array<Shard, NUM_SHARDS> m_shards;
   /// Logger for this DataService
   Logger g_log;
 }; // End Class Data service
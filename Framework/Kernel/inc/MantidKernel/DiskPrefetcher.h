@@ -0,0 +1,97 @@
+// Mantid Repository : https://github.com/mantidproject/mantid
+//
+// Copyright &copy; 2022 ISIS Rutherford Appleton Laboratory UKRI,
+//   NScD Oak Ridge National Laboratory, European Spallation Source,
+//   Institut Laue - Langevin & CSNS, Institute of High Energy Physics, CAS
+// SPDX - License - Identifier: GPL - 3.0 +
+#pragma once
+
+#include "MantidKernel/System.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace Mantid {
+namespace Kernel {
+
+// Forward declare
+class DiskBuffer;
+class ISaveable;
+
+/** Loads file-backed ISaveable objects on a background thread ahead of their
+  use, so that a caller visiting them in a known order finds them in memory
+  instead of waiting on the disk for each one.
+
+  The caller gives the order up front and reports the index of the next object
+  it is about to use with advanceTo(). The background thread loads the objects
+  from there on, in order, as long as the objects loaded ahead of the caller
+  hold no more than the given number of data points (see
+  ISaveable::getFileSize()). That limit is shared equally between all the
+  prefetchers of the same DiskBuffer, e.g. one per thread, so that together
+  they do not load more ahead than one would.
+
+  Objects loaded here enter the DiskBuffer once the caller has moved past
+  them, whether it used them or not, so the DiskBuffer can write them out and
+  free their memory as usual; before that they can not be dropped before they
+  have been used.
+
+  ISaveable::load() must cope with being called on another thread at the same
+  time as the caller calls it on the same object.
+*/
+class DLLExport DiskPrefetcher {
+public:
+  DiskPrefetcher(std::vector<ISaveable *> objects, DiskBuffer &buffer, const uint64_t maxDataAhead);
+  DiskPrefetcher(const DiskPrefetcher &) = delete;
+  DiskPrefetcher &operator=(const DiskPrefetcher &) = delete;
+  ~DiskPrefetcher();
+
+  void advanceTo(const size_t position);
+
+  /// @return the number of objects loaded by the background thread so far
+  size_t getNumLoaded() const { return m_numLoaded; }
+
+private:
+  void run();
+  bool canLoadNext() const;
+  void handOver(std::unique_lock<std::mutex> &lock);
+
+  /// The objects, in the order they will be used
+  const std::vector<ISaveable *> m_objects;
+  /// m_dataBefore[i] is the total size on file of the objects before object i
+  std::vector<uint64_t> m_dataBefore;
+  /// Takes the loaded objects once the caller has moved past them
+  DiskBuffer &m_buffer;
+  /// Most data points to load ahead of the caller, shared with the other prefetchers of m_buffer
+  const uint64_t m_maxDataAhead;
+  /// Number of prefetchers of m_buffer, including this one
+  std::shared_ptr<std::atomic<size_t>> m_numSharing;
+
+  /// Guards m_position, m_next, m_loaded, m_failed and m_stop
+  std::mutex m_mutex;
+  /// Wakes up the background thread
+  std::condition_variable m_wake;
+  /// Index of the next object the caller will use
+  size_t m_position;
+  /// Index of the next object to load
+  size_t m_next;
+  /// Indices of the objects loaded here and not yet given to m_buffer
+  std::deque<size_t> m_loaded;
+  /// Set if a load failed, after which nothing more is loaded
+  bool m_failed;
+  /// Set to end the background thread
+  bool m_stop;
+  /// Number of objects loaded by the background thread
+  std::atomic<size_t> m_numLoaded;
+
+  /// The background thread; started last
+  std::thread m_thread;
+};
+
+} // namespace Kernel
+} // namespace Mantid
@@ -0,0 +1,90 @@
+// Mantid Repository : https://github.com/mantidproject/mantid
+//
+// Copyright &copy; 2022 ISIS Rutherford Appleton Laboratory UKRI,
+//   NScD Oak Ridge National Laboratory, European Spallation Source,
+//   Institut Laue - Langevin & CSNS, Institute of High Energy Physics, CAS
+// SPDX - License - Identifier: GPL - 3.0 +
+#pragma once
+
+#include "MantidKernel/DllConfig.h"
+#include "MantidKernel/ThreadScheduler.h"
+
+#include <atomic>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <vector>
+
+namespace Mantid {
+namespace Kernel {
+
+/** ThreadSchedulerWorkStealing : a ThreadScheduler giving each worker thread
+ * its own queue of tasks, so that threads do not all contend for one lock.
+ *
+ * A task pushed from inside a running task goes to the queue of the thread
+ * running it, which takes its own tasks newest first: recursive work such as
+ * splitting MD boxes stays on the thread whose cache holds the data. A task
+ * pushed from any other thread goes to the queues in turn, unless given a
+ * worker to prefer. A thread whose queue is empty steals the oldest task of
+ * another queue, trying the neighbouring workers first.
+ *
+ * Tasks with a mutex are kept apart in one shared queue and, as with
+ * ThreadSchedulerMutexes, taken largest cost first and only started while
+ * another task holds their mutex if nothing else is left.
+ */
+class MANTID_KERNEL_DLL ThreadSchedulerWorkStealing : public ThreadScheduler {
+public:
+  ThreadSchedulerWorkStealing(size_t numQueues = 0);
+
+  ~ThreadSchedulerWorkStealing() override;
+
+  void push(std::shared_ptr<Task> newTask) override;
+  void push(std::shared_ptr<Task> newTask, size_t worker);
+  std::shared_ptr<Task> pop(size_t threadnum) override;
+  void finished(Task *task, size_t threadnum) override;
+  size_t size() override;
+  bool empty() override;
+  void clear() override;
+  double totalCost() override;
+
+  /// @return the number of queues, one for each worker thread
+  size_t numQueues() const { return m_queues.size(); }
+
+private:
+  /// The tasks of one worker thread
+  struct WorkerQueue {
+    /// Protects the tasks and their cost
+    std::mutex lock;
+    /// The tasks, oldest first
+    std::deque<std::shared_ptr<Task>> tasks;
+    /// Total cost of the tasks
+    double cost = 0.;
+  };
+
+  std::shared_ptr<Task> takeBack(WorkerQueue &queue);
+  std::shared_ptr<Task> takeFront(WorkerQueue &queue);
+  std::shared_ptr<Task> takeMutexed(const bool onlyFree);
+
+  /// Unique ID of the scheduler, to recognise its worker threads
+  const size_t m_id;
+  /// The queues of the worker threads
+  std::vector<std::unique_ptr<WorkerQueue>> m_queues;
+  /// Protects the tasks with a mutex, their cost and the busy mutexes
+  std::mutex m_mutexedLock;
+  /// Tasks with a mutex, oldest first
+  std::deque<std::shared_ptr<Task>> m_mutexedTasks;
+  /// Total cost of the tasks with a mutex
+  double m_mutexedCost;
+  /// Mutexes of the tasks started and not finished
+  std::multiset<std::shared_ptr<std::mutex>> m_busyMutexes;
+  /// Number of tasks in all the queues, including those with a mutex
+  std::atomic<size_t> m_numTasks;
+  /// Number of tasks with a mutex
+  std::atomic<size_t> m_numMutexedTasks;
+  /// Queue to give the next task pushed from outside of the workers
+  std::atomic<size_t> m_nextQueue;
+};
+
+} // namespace Kernel
+} // namespace Mantid
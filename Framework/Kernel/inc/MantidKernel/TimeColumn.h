@@ -0,0 +1,114 @@
+// Mantid Repository : https://github.com/mantidproject/mantid
+//
+// Copyright &copy; 2022 ISIS Rutherford Appleton Laboratory UKRI,
+//   NScD Oak Ridge National Laboratory, European Spallation Source,
+//   Institut Laue - Langevin & CSNS, Institute of High Energy Physics, CAS
+// SPDX - License - Identifier: GPL - 3.0 +
+#pragma once
+
+#include "MantidKernel/DllConfig.h"
+#include "MantidTypes/Core/DateAndTime.h"
+
+#include <cstdint>
+#include <vector>
+
+namespace Mantid {
+namespace Kernel {
+
+/** A column of absolute times, in nanoseconds, stored delta-encoded to take
+  less memory than a plain vector of DateAndTime while keeping constant-time
+  access to any entry.
+
+  The times are grouped in blocks of BLOCK_SIZE consecutive entries. The last,
+  incomplete block holds plain 64-bit times, so a short log takes exactly the
+  memory of plain times. A complete block stores the full time of its first
+  entry and the 32-bit offsets of its entries from it, counted in the
+  coarsest of seconds, milliseconds, microseconds or nanoseconds that all the
+  offsets are a whole number of. Fast logs with nanosecond offsets fit if the
+  block spans up to about two seconds, and slow logs recorded on whole
+  seconds fit whatever their interval. A block that does not fit stores its
+  times in full. Each complete block also takes 4 bytes of bookkeeping.
+
+  Times are added at the end. Changing a time so that its block no longer
+  fits moves the block to full storage and leaves its offsets unused. As with
+  std::vector, erasing from the middle costs time proportional to the number
+  of entries after the erased ones.
+*/
+class MANTID_KERNEL_DLL TimeColumn {
+public:
+  /// @return the number of times in the column
+  size_t size() const { return (m_blocks.size() << BLOCK_BITS) + m_tail.size(); }
+  /// @return true if there are no times in the column
+  bool empty() const { return m_blocks.empty() && m_tail.empty(); }
+
+  /// @return the i-th time in nanoseconds
+  int64_t nanoseconds(const size_t i) const {
+    const size_t blockIndex = i >> BLOCK_BITS;
+    if (blockIndex == m_blocks.size())
+      return m_tail[i & BLOCK_MASK];
+    const uint32_t block = m_blocks[blockIndex];
+    const size_t slot = block >> SLOT_SHIFT;
+    const size_t index = (slot << BLOCK_BITS) + (i & BLOCK_MASK);
+    if (block & WIDE_FLAG)
+      return m_wideTimes[index];
+    return m_starts[slot] + static_cast<int64_t>(m_offsets[index]) * UNITS[(block >> 1) & UNIT_MASK];
+  }
+  /// @return the i-th time
+  Types::Core::DateAndTime operator[](const size_t i) const { return Types::Core::DateAndTime(nanoseconds(i)); }
+  /// @return the first time
+  Types::Core::DateAndTime front() const { return (*this)[0]; }
+  /// @return the last time
+  Types::Core::DateAndTime back() const { return (*this)[size() - 1]; }
+
+  void push_back(const int64_t time);
+  /// Add a time at the end
+  void push_back(const Types::Core::DateAndTime &time) { push_back(time.totalNanoseconds()); }
+  void set(const size_t i, const int64_t time);
+  void append(const TimeColumn &other);
+  void erase(const size_t first, size_t last);
+  void permute(const std::vector<size_t> &order);
+  void reserve(const size_t size);
+  void clear();
+
+  bool isSorted() const;
+  std::vector<size_t> sortedOrder() const;
+  size_t lowerBound(const int64_t time, size_t first, size_t last) const;
+  size_t upperBound(const int64_t time, size_t first, size_t last) const;
+  std::vector<Types::Core::DateAndTime> toVector() const;
+  size_t getMemorySize() const;
+
+  /// Number of entries in a block, as a power of two
+  static constexpr size_t BLOCK_BITS = 6;
+  /// Number of entries in a block
+  static constexpr size_t BLOCK_SIZE = size_t(1) << BLOCK_BITS;
+
+private:
+  static constexpr size_t BLOCK_MASK = BLOCK_SIZE - 1;
+  /// The units of the offsets in nanoseconds, from the coarsest
+  static constexpr int64_t UNITS[] = {1000000000, 1000000, 1000, 1};
+  static constexpr uint32_t UNIT_MASK = 3;
+  /// Set in the bookkeeping of a block stored in full
+  static constexpr uint32_t WIDE_FLAG = 1;
+  /// The bookkeeping of a block is its slot, shifted by this, its unit and the wide flag
+  static constexpr uint32_t SLOT_SHIFT = 3;
+
+  static bool encodeOffsets(const int64_t *times, uint32_t &unit, int32_t *offsets);
+  static uint32_t makeBlock(const size_t slot, const uint32_t unit, const bool wide);
+  void addBlock(const int64_t *times);
+  void keepBlocks(const size_t numBlocks);
+
+  /// For each complete block, its slot in m_starts and m_offsets, or in
+  /// m_wideTimes if it is wide, the index of its unit and the wide flag
+  std::vector<uint32_t> m_blocks;
+  /// Time of the first entry of each narrow slot
+  std::vector<int64_t> m_starts;
+  /// Offsets of the entries of each narrow slot from its first entry
+  std::vector<int32_t> m_offsets;
+  /// Times of the entries of each wide slot
+  std::vector<int64_t> m_wideTimes;
+  /// Times of the last, incomplete block
+  std::vector<int64_t> m_tail;
+};
+
+} // namespace Kernel
+} // namespace Mantid
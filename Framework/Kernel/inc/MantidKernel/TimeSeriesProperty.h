@@ -14,7 +14,9 @@
 #include "MantidKernel/ITimeSeriesProperty.h"
 #include "MantidKernel/Property.h"
 #include "MantidKernel/Statistics.h"
+#include "MantidKernel/TimeColumn.h"
 #include <cstdint>
+#include <mutex>
 #include <utility>
 
 // Forward declare
@@ -286,7 +288,10 @@ public:
   /**Reserve memory for efficient adding values to existing property
    * makes sense only when you have reasonably precise estimate of the
    * total size you'll need easily available in advance.  */
-  void reserve(size_t size) { m_values.reserve(size); };
+  void reserve(size_t size) {
+    m_times.reserve(size);
+    m_values.reserve(size);
+  };
 
   /// If filtering by log, get the time intervals for splitting
   std::vector<Mantid::Kernel::SplittingInterval> getSplittingIntervals() const;
@@ -313,8 +318,43 @@ private:
   /// Time weighted mean and standard deviation
   std::pair<double, double> timeAverageValueAndStdDev() const;
 
-  /// Holds the time series data
-  mutable std::vector<TimeValueUnit<TYPE>> m_values;
+  /// Sort the entries by time, keeping the order of entries at equal times
+  void sortByTime() const;
+  /// Time integrals of the values and their squares over a filter
+  std::pair<double, double> integrateInFilter(const std::vector<SplittingInterval> &filter) const;
+
+  /// Holds the times of the time series data, delta-encoded
+  mutable TimeColumn m_times;
+  /// Holds the values of the time series data, in the same order as m_times
+  mutable std::vector<TYPE> m_values;
+  /// Time integrals, in seconds, of the values minus the first value and of
+  /// their squares from the first time to the first time of each block of
+  /// m_times. They cover the leading blocks of the sorted log, are filled by
+  /// integrateInFilter and are cleared by any change but an append. Copies
+  /// start empty.
+  struct BlockIntegrals {
+    BlockIntegrals() = default;
+    BlockIntegrals(const BlockIntegrals & /*other*/) {}
+    BlockIntegrals &operator=(const BlockIntegrals & /*other*/) {
+      clear();
+      return *this;
+    }
+    /// Forget all the integrals
+    void clear() {
+      std::lock_guard<std::mutex> lock(mutex);
+      blocks.clear();
+    }
+    /// Forget the integrals of the blocks starting at or after an entry
+    void truncate(const size_t numEntries) {
+      std::lock_guard<std::mutex> lock(mutex);
+      blocks.resize(std::min(blocks.size(), (numEntries + TimeColumn::BLOCK_SIZE - 1) / TimeColumn::BLOCK_SIZE));
+    }
+    /// Guards the integrals, which const methods fill
+    std::mutex mutex;
+    /// The integrals at the start of each block
+    std::vector<std::pair<double, double>> blocks;
+  };
+  mutable BlockIntegrals m_integrals;
 
   /// The number of values (or time intervals) in the time series. It can be
   /// different from m_propertySeries.size()
@@ -0,0 +1,129 @@
+// Mantid Repository : https://github.com/mantidproject/mantid
+//
+// Copyright &copy; 2022 ISIS Rutherford Appleton Laboratory UKRI,
+//   NScD Oak Ridge National Laboratory, European Spallation Source,
+//   Institut Laue - Langevin & CSNS, Institute of High Energy Physics, CAS
+// SPDX - License - Identifier: GPL - 3.0 +
+#pragma once
+
+#include "MantidKernel/DllConfig.h"
+#include "MantidKernel/SingletonHolder.h"
+
+#include <atomic>
+#include <chrono>
+#include <ctime>
+#include <iosfwd>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace Mantid {
+namespace Kernel {
+
+/** TraceRecorder : records timed spans of work, such as the execution of
+  algorithms, and writes them in the Chrome trace event format, which
+  chrome://tracing and Perfetto show as a timeline for each thread. Spans
+  opened inside another span on the same thread, such as child algorithms,
+  appear nested in it.
+
+  Each span records the change of the current and peak resident memory of the
+  process and the fraction of the available threads the process kept busy,
+  along with any counters added by the code running inside it.
+
+  Recording is off unless enabled. It is enabled at start-up if the
+  algorithms.trace.filename configuration key is set, and the trace is then
+  written to that file at exit.
+*/
+class MANTID_KERNEL_DLL TraceRecorderImpl {
+public:
+  /// A completed span
+  struct Event {
+    /// Name of the span
+    std::string name;
+    /// Category of the span, e.g. algorithm
+    std::string category;
+    /// Index of the thread the span ran on
+    size_t thread = 0;
+    /// Start of the span, in microseconds since the recorder was created
+    double start = 0.;
+    /// Duration of the span in microseconds
+    double duration = 0.;
+    /// Counters recorded in the span, in the order they were first added
+    std::vector<std::pair<std::string, double>> counters;
+  };
+
+  /// @return true if spans are being recorded
+  bool isEnabled() const { return m_enabled; }
+  void enable();
+  void disable();
+  void clear();
+  void addCounter(const std::string &name, const double value);
+  std::vector<Event> events() const;
+  void writeTrace(std::ostream &stream) const;
+  void saveTrace(const std::string &filename) const;
+
+private:
+  friend struct Mantid::Kernel::CreateUsingNew<TraceRecorderImpl>;
+  friend class TraceSpan;
+
+  TraceRecorderImpl();
+  ~TraceRecorderImpl();
+  TraceRecorderImpl(const TraceRecorderImpl &) = delete;
+  TraceRecorderImpl &operator=(const TraceRecorderImpl &) = delete;
+
+  void record(Event event);
+
+  /// True if spans are being recorded
+  std::atomic<bool> m_enabled;
+  /// Time the recorder was created, to which the events are relative
+  const std::chrono::steady_clock::time_point m_start;
+  /// Protects the events
+  mutable std::mutex m_mutex;
+  /// The completed spans
+  std::vector<Event> m_events;
+  /// File to write the trace to at exit, if any
+  std::string m_filename;
+};
+
+EXTERN_MANTID_KERNEL template class MANTID_KERNEL_DLL Mantid::Kernel::SingletonHolder<TraceRecorderImpl>;
+using TraceRecorder = Mantid::Kernel::SingletonHolder<TraceRecorderImpl>;
+
+/** TraceSpan : records the lifetime of the object as a span of the
+  TraceRecorder, if it is enabled when the span is created.
+
+  Wrapping a PARALLEL_FOR loop in a span gives the thread utilisation of that
+  loop. Counters such as the number of bytes read can be added to the span
+  directly or, from code that does not hold it, to the innermost span of the
+  current thread with TraceRecorder::Instance().addCounter().
+*/
+class MANTID_KERNEL_DLL TraceSpan {
+public:
+  TraceSpan(std::string name, std::string category);
+  ~TraceSpan();
+  TraceSpan(const TraceSpan &) = delete;
+  TraceSpan &operator=(const TraceSpan &) = delete;
+
+  /// @return true if the span is being recorded
+  bool isActive() const { return m_active; }
+  void addCounter(const std::string &name, const double value);
+
+private:
+  /// True if the span is being recorded
+  const bool m_active;
+  /// The span enclosing this one on the same thread, if any
+  TraceSpan *m_parent = nullptr;
+  /// The event filled in as the span runs
+  TraceRecorderImpl::Event m_event;
+  /// Wall-clock time at the start
+  std::chrono::steady_clock::time_point m_start;
+  /// CPU time of the process at the start
+  std::clock_t m_startCPU = 0;
+  /// Resident memory of the process at the start, in bytes
+  size_t m_startRSS = 0;
+  /// Peak resident memory of the process at the start, in bytes
+  size_t m_startPeakRSS = 0;
+};
+
+} // namespace Kernel
+} // namespace Mantid
@@ -29,6 +29,20 @@ enum class UnitParams { l2, twoTheta, efixed, delta, difa, difc, tzero };
 // where [] creates element with value 0 if param name not present
 using UnitParametersMap = std::unordered_map<UnitParams, double>;
 
+/** Coefficients of a unit conversion to and from TOF of the form
+ *    tof = toFactor * x^power + toOffset
+ *    x = fromFactor * (tof - fromOffset)^power
+ *  where power is 1 or -1. A zero base of a negative power is replaced by
+ *  DBL_MIN when converting from TOF.
+ */
+struct TOFCoefficients {
+  double toFactor;
+  double toOffset;
+  double fromFactor;
+  double fromOffset;
+  int power;
+};
+
 /** The base units (abstract) class. All concrete units should inherit from
     this class and provide implementations of the caption(), label(),
     toTOF() and fromTOF() methods. They also need to declare (but NOT define)
@@ -188,6 +202,14 @@ public:
    * reversible*/
   virtual std::pair<double, double> conversionRange() const;
 
+  /** Get the coefficients of the conversion of an initialized unit, for
+   * callers converting many values with the same parameters.
+   * @param coefficients :: set to the coefficients if they exist
+   * @return true if the conversion to and from TOF has the form of
+   * TOFCoefficients
+   */
+  virtual bool tofCoefficients(TOFCoefficients & /*coefficients*/) const { return false; }
+
 protected:
   // Add a 'quick conversion' for a unit pair
   void addConversion(std::string to, const double &factor, const double &power = 1.0) const;
@@ -290,6 +312,7 @@ public:
   void init() override;
   double singleToTOF(const double x) const override;
   double singleFromTOF(const double tof) const override;
+  bool tofCoefficients(TOFCoefficients &coefficients) const override;
   Unit *clone() const override;
   ///@return -DBL_MAX as ToF convertible to TOF for in any time range
   double conversionTOFMin() const override;
@@ -307,6 +330,7 @@ public:
 
   double singleToTOF(const double x) const override;
   double singleFromTOF(const double tof) const override;
+  bool tofCoefficients(TOFCoefficients &coefficients) const override;
   void init() override;
   Unit *clone() const override;
 
@@ -387,6 +411,7 @@ public:
   const UnitLabel label() const override;
   double singleToTOF(const double x) const override;
   double singleFromTOF(const double tof) const override;
+  bool tofCoefficients(TOFCoefficients &coefficients) const override;
   void init() override;
   Unit *clone() const override;
   double conversionTOFMin() const override;
@@ -442,6 +467,7 @@ public:
 
   double singleToTOF(const double x) const override;
   double singleFromTOF(const double tof) const override;
+  bool tofCoefficients(TOFCoefficients &coefficients) const override;
   void init() override;
   Unit *clone() const override;
   double conversionTOFMin() const override;
@@ -464,6 +490,7 @@ public:
 
   double singleToTOF(const double x) const override;
   double singleFromTOF(const double tof) const override;
+  bool tofCoefficients(TOFCoefficients &) const override { return false; }
   Unit *clone() const override;
   double conversionTOFMin() const override;
   double conversionTOFMax() const override;
@@ -543,6 +570,7 @@ public:
 
   double singleToTOF(const double ki) const override;
   double singleFromTOF(const double tof) const override;
+  bool tofCoefficients(TOFCoefficients &coefficients) const override;
   void init() override;
   Unit *clone() const override;
   double conversionTOFMin() const override;
@@ -571,6 +599,7 @@ public:
 
   double singleToTOF(const double x) const override;
   double singleFromTOF(const double tof) const override;
+  bool tofCoefficients(TOFCoefficients &) const override { return false; }
   void init() override;
   Unit *clone() const override;
   double conversionTOFMin() const override;
@@ -593,6 +622,7 @@ public:
 
   double singleToTOF(const double x) const override;
   double singleFromTOF(const double tof) const override;
+  bool tofCoefficients(TOFCoefficients &) const override { return false; }
   void init() override;
   Unit *clone() const override;
   double conversionTOFMin() const override;
@@ -49,26 +49,31 @@ void DiskBuffer::toWrite(ISaveable *item) {
     return;
   //    if (!m_useWriteBuffer) return;
 
-  if (item->getBufPostion()) // already in the buffer and probably have changed
-                             // its size in memory
+  bool bufferFull;
   {
-    // forget old memory size
-    std::unique_lock<std::mutex> uniqueLock(m_mutex);
-    m_writeBufferUsed -= item->getBufferSize();
-    // add new size
-    size_t newMemorySize = item->getDataMemorySize();
-    m_writeBufferUsed += newMemorySize;
-    uniqueLock.unlock();
-    item->setBufferSize(newMemorySize);
-  } else {
+    // The buffer position of the item is only changed under the lock, but
+    // several threads, e.g. a DiskPrefetcher and the user of the items, may
+    // hand over the same item at once
     std::lock_guard<std::mutex> lock(m_mutex);
-    m_toWriteBuffer.push_front(item);
-    m_writeBufferUsed += item->setBufferPosition(m_toWriteBuffer.begin());
-    m_nObjectsToWrite++;
+    if (item->getBufPostion()) // already in the buffer and probably have changed
+                               // its size in memory
+    {
+      // forget old memory size
+      m_writeBufferUsed -= item->getBufferSize();
+      // add new size
+      size_t newMemorySize = item->getDataMemorySize();
+      m_writeBufferUsed += newMemorySize;
+      item->setBufferSize(newMemorySize);
+    } else {
+      m_toWriteBuffer.push_front(item);
+      m_writeBufferUsed += item->setBufferPosition(m_toWriteBuffer.begin());
+      m_nObjectsToWrite++;
+    }
+    bufferFull = m_writeBufferUsed > m_writeBufferSize;
   }
 
   // Should we now write out the old data?
-  if (m_writeBufferUsed > m_writeBufferSize)
+  if (bufferFull)
     writeOldObjects();
 }
 
@@ -0,0 +1,138 @@
+// Mantid Repository : https://github.com/mantidproject/mantid
+//
+// Copyright &copy; 2022 ISIS Rutherford Appleton Laboratory UKRI,
+//   NScD Oak Ridge National Laboratory, European Spallation Source,
+//   Institut Laue - Langevin & CSNS, Institute of High Energy Physics, CAS
+// SPDX - License - Identifier: GPL - 3.0 +
+#include "MantidKernel/DiskPrefetcher.h"
+#include "MantidKernel/DiskBuffer.h"
+#include "MantidKernel/ISaveable.h"
+#include "MantidKernel/Logger.h"
+
+#include <algorithm>
+#include <unordered_map>
+
+namespace Mantid::Kernel {
+
+namespace {
+/// static logger
+Logger g_log("DiskPrefetcher");
+
+/// Guards g_numPrefetchers
+std::mutex g_numPrefetchersMutex;
+/// Number of prefetchers of each DiskBuffer that has any
+std::unordered_map<const DiskBuffer *, std::shared_ptr<std::atomic<size_t>>> g_numPrefetchers;
+
+/// Count a new prefetcher of the buffer. @return the count of its prefetchers
+std::shared_ptr<std::atomic<size_t>> addPrefetcher(const DiskBuffer &buffer) {
+  std::lock_guard<std::mutex> lock(g_numPrefetchersMutex);
+  auto &count = g_numPrefetchers[&buffer];
+  if (!count)
+    count = std::make_shared<std::atomic<size_t>>(0);
+  ++*count;
+  return count;
+}
+
+/// Stop counting a prefetcher of the buffer
+void removePrefetcher(const DiskBuffer &buffer) {
+  std::lock_guard<std::mutex> lock(g_numPrefetchersMutex);
+  const auto count = g_numPrefetchers.find(&buffer);
+  if (count != g_numPrefetchers.end() && --*count->second == 0)
+    g_numPrefetchers.erase(count);
+}
+} // namespace
+
+//----------------------------------------------------------------------------------------------
+/** Constructor. Starts loading from the first object.
+ *
+ * @param objects :: the objects in the order they will be used
+ * @param buffer :: the DiskBuffer managing the objects
+ * @param maxDataAhead :: most data points to hold in objects loaded ahead of
+ * the caller, divided between all the prefetchers of the buffer. The object the
+ * caller is about to use is always loaded.
+ */
+DiskPrefetcher::DiskPrefetcher(std::vector<ISaveable *> objects, DiskBuffer &buffer, const uint64_t maxDataAhead)
+    : m_objects(std::move(objects)), m_dataBefore(m_objects.size() + 1, 0), m_buffer(buffer),
+      m_maxDataAhead(maxDataAhead), m_numSharing(addPrefetcher(buffer)), m_position(0), m_next(0), m_failed(false),
+      m_stop(false), m_numLoaded(0) {
+  for (size_t i = 0; i < m_objects.size(); ++i)
+    m_dataBefore[i + 1] = m_dataBefore[i] + m_objects[i]->getFileSize();
+  m_thread = std::thread(&DiskPrefetcher::run, this);
+}
+
+//----------------------------------------------------------------------------------------------
+/** Destructor. Stops the background thread after any load in progress and
+ * gives the DiskBuffer the objects loaded but not reached by the caller.
+ */
+DiskPrefetcher::~DiskPrefetcher() {
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_stop = true;
+  }
+  m_wake.notify_one();
+  m_thread.join();
+  for (const auto index : m_loaded)
+    m_buffer.toWrite(m_objects[index]);
+  removePrefetcher(m_buffer);
+}
+
+//----------------------------------------------------------------------------------------------
+/** Tell the prefetcher which object the caller is about to use. Objects before
+ * it will not be loaded any more.
+ *
+ * @param position :: index of the next object the caller will use
+ */
+void DiskPrefetcher::advanceTo(const size_t position) {
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_position = position;
+  }
+  m_wake.notify_one();
+}
+
+/// @return true if the next object can be loaded without going over the limit. Call with m_mutex held.
+bool DiskPrefetcher::canLoadNext() const {
+  const uint64_t maxDataAhead = m_maxDataAhead / std::max(size_t{1}, m_numSharing->load());
+  return !m_failed && m_next < m_objects.size() &&
+         (m_next == m_position || m_dataBefore[m_next + 1] - m_dataBefore[m_position] <= maxDataAhead);
+}
+
+/// Give m_buffer the loaded objects the caller has moved past. Call with m_mutex held through lock.
+void DiskPrefetcher::handOver(std::unique_lock<std::mutex> &lock) {
+  while (!m_loaded.empty() && m_loaded.front() < m_position) {
+    ISaveable *object = m_objects[m_loaded.front()];
+    m_loaded.pop_front();
+    lock.unlock();
+    m_buffer.toWrite(object);
+    lock.lock();
+  }
+}
+
+/// Body of the background thread
+void DiskPrefetcher::run() {
+  std::unique_lock<std::mutex> lock(m_mutex);
+  while (!m_stop) {
+    handOver(lock);
+    // The caller may have moved past the objects loaded so far
+    m_next = std::max(m_next, m_position);
+    if (!canLoadNext()) {
+      m_wake.wait(lock);
+      continue;
+    }
+    const size_t index = m_next++;
+    lock.unlock();
+    try {
+      m_objects[index]->load();
+      ++m_numLoaded;
+      lock.lock();
+      m_loaded.emplace_back(index);
+    } catch (std::exception &e) {
+      // The caller gets the error when it loads the object itself
+      g_log.debug() << "Stopped prefetching: " << e.what() << '\n';
+      lock.lock();
+      m_failed = true;
+    }
+  }
+}
+
+} // namespace Mantid::Kernel
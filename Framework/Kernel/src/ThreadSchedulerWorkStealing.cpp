@@ -0,0 +1,204 @@
+// Mantid Repository : https://github.com/mantidproject/mantid
+//
+// Copyright &copy; 2022 ISIS Rutherford Appleton Laboratory UKRI,
+//   NScD Oak Ridge National Laboratory, European Spallation Source,
+//   Institut Laue - Langevin & CSNS, Institute of High Energy Physics, CAS
+// SPDX - License - Identifier: GPL - 3.0 +
+#include "MantidKernel/ThreadSchedulerWorkStealing.h"
+#include "MantidKernel/ThreadPool.h"
+
+#include <algorithm>
+
+namespace Mantid::Kernel {
+
+namespace {
+/// Source of the scheduler IDs, which unlike addresses are never reused
+std::atomic<size_t> nextSchedulerId(1);
+/// ID of the scheduler the current thread last took a task from
+thread_local size_t currentScheduler = 0;
+/// The queue of the current thread in currentScheduler
+thread_local size_t currentQueue = 0;
+} // namespace
+
+/** Constructor
+ *
+ * @param numQueues :: number of worker queues, normally the number of threads
+ *        of the ThreadPool; default = 0, meaning one for each physical core.
+ */
+ThreadSchedulerWorkStealing::ThreadSchedulerWorkStealing(size_t numQueues)
+    : ThreadScheduler(), m_id(nextSchedulerId++), m_mutexedCost(0.), m_numTasks(0), m_numMutexedTasks(0),
+      m_nextQueue(0) {
+  if (numQueues == 0)
+    numQueues = std::max(ThreadPool::getNumPhysicalCores(), size_t(1));
+  m_queues.reserve(numQueues);
+  for (size_t i = 0; i < numQueues; ++i)
+    m_queues.emplace_back(std::make_unique<WorkerQueue>());
+}
+
+/// Destructor
+ThreadSchedulerWorkStealing::~ThreadSchedulerWorkStealing() { clear(); }
+
+/** Add a Task. From inside a task run by this scheduler, it goes to the queue
+ * of the thread running it; otherwise to the next queue in turn.
+ * @param newTask :: Task to add
+ */
+void ThreadSchedulerWorkStealing::push(std::shared_ptr<Task> newTask) {
+  const size_t worker = currentScheduler == m_id ? currentQueue : m_nextQueue++;
+  push(std::move(newTask), worker);
+}
+
+/** Add a Task to the queue of a given worker, which will normally run it
+ * unless it is idle first elsewhere.
+ * @param newTask :: Task to add
+ * @param worker :: the worker thread to prefer; any number is accepted
+ */
+void ThreadSchedulerWorkStealing::push(std::shared_ptr<Task> newTask, size_t worker) {
+  // Count the task before it can be taken, so the count is never short
+  ++m_numTasks;
+  if (newTask->getMutex()) {
+    std::lock_guard<std::mutex> lock(m_mutexedLock);
+    m_mutexedCost += newTask->cost();
+    m_mutexedTasks.emplace_back(std::move(newTask));
+    ++m_numMutexedTasks;
+    return;
+  }
+  auto &queue = *m_queues[worker % m_queues.size()];
+  const double cost = newTask->cost();
+  std::lock_guard<std::mutex> lock(queue.lock);
+  queue.tasks.emplace_back(std::move(newTask));
+  queue.cost += cost;
+}
+
+/** Retrieves the next Task to execute: the newest of the thread's own queue,
+ * else the largest task with a free mutex, else the oldest task of the nearest
+ * other queue, else the largest task waiting for its mutex.
+ * @param threadnum :: ID of the calling thread.
+ * @return a Task pointer to execute, or nullptr if none is left.
+ */
+std::shared_ptr<Task> ThreadSchedulerWorkStealing::pop(size_t threadnum) {
+  const size_t numQueues = m_queues.size();
+  const size_t own = threadnum % numQueues;
+  currentScheduler = m_id;
+  currentQueue = own;
+
+  auto task = takeBack(*m_queues[own]);
+
+  if (!task && m_numMutexedTasks > 0)
+    task = takeMutexed(true);
+
+  // Steal from the following and preceding workers in turn, nearest first
+  for (size_t distance = 1; !task && distance < numQueues; ++distance) {
+    const size_t offset = (distance + 1) / 2;
+    const size_t victim = distance % 2 == 1 ? (own + offset) % numQueues : (own + numQueues - offset) % numQueues;
+    task = takeFront(*m_queues[victim]);
+  }
+
+  if (!task && m_numMutexedTasks > 0)
+    task = takeMutexed(false);
+
+  if (task)
+    --m_numTasks;
+  return task;
+}
+
+/** Signal to the scheduler that a task is complete, releasing its mutex.
+ *
+ * @param task :: the Task that was completed.
+ * @param threadnum :: Thread ID that launched the task
+ */
+void ThreadSchedulerWorkStealing::finished(Task *task, size_t threadnum) {
+  UNUSED_ARG(threadnum);
+  auto mutex = task->getMutex();
+  if (mutex) {
+    std::lock_guard<std::mutex> lock(m_mutexedLock);
+    auto busy = m_busyMutexes.find(mutex);
+    if (busy != m_busyMutexes.end())
+      m_busyMutexes.erase(busy);
+  }
+}
+
+/// @return the number of tasks waiting
+size_t ThreadSchedulerWorkStealing::size() { return m_numTasks; }
+
+/// @return true if no task is waiting
+bool ThreadSchedulerWorkStealing::empty() { return m_numTasks == 0; }
+
+/// Remove all the tasks
+void ThreadSchedulerWorkStealing::clear() {
+  for (auto &queue : m_queues) {
+    std::lock_guard<std::mutex> lock(queue->lock);
+    m_numTasks -= queue->tasks.size();
+    queue->tasks.clear();
+    queue->cost = 0.;
+  }
+  std::lock_guard<std::mutex> lock(m_mutexedLock);
+  m_numTasks -= m_mutexedTasks.size();
+  m_numMutexedTasks = 0;
+  m_mutexedTasks.clear();
+  m_mutexedCost = 0.;
+}
+
+/// @return the total cost of the tasks waiting
+double ThreadSchedulerWorkStealing::totalCost() {
+  double cost = 0.;
+  for (auto &queue : m_queues) {
+    std::lock_guard<std::mutex> lock(queue->lock);
+    cost += queue->cost;
+  }
+  std::lock_guard<std::mutex> lock(m_mutexedLock);
+  return cost + m_mutexedCost;
+}
+
+/** Take the newest task of a queue
+ * @param queue :: the queue to take from
+ * @return the task, or nullptr if the queue is empty
+ */
+std::shared_ptr<Task> ThreadSchedulerWorkStealing::takeBack(WorkerQueue &queue) {
+  std::lock_guard<std::mutex> lock(queue.lock);
+  if (queue.tasks.empty())
+    return nullptr;
+  auto task = std::move(queue.tasks.back());
+  queue.tasks.pop_back();
+  queue.cost -= task->cost();
+  return task;
+}
+
+/** Take the oldest task of a queue
+ * @param queue :: the queue to take from
+ * @return the task, or nullptr if the queue is empty
+ */
+std::shared_ptr<Task> ThreadSchedulerWorkStealing::takeFront(WorkerQueue &queue) {
+  std::lock_guard<std::mutex> lock(queue.lock);
+  if (queue.tasks.empty())
+    return nullptr;
+  auto task = std::move(queue.tasks.front());
+  queue.tasks.pop_front();
+  queue.cost -= task->cost();
+  return task;
+}
+
+/** Take the largest cost task with a mutex, the oldest of equal cost, and
+ * mark its mutex as busy
+ * @param onlyFree :: if true, skip the tasks whose mutex is busy
+ * @return the task, or nullptr if there is none
+ */
+std::shared_ptr<Task> ThreadSchedulerWorkStealing::takeMutexed(const bool onlyFree) {
+  std::lock_guard<std::mutex> lock(m_mutexedLock);
+  auto next = m_mutexedTasks.end();
+  for (auto it = m_mutexedTasks.begin(); it != m_mutexedTasks.end(); ++it) {
+    if (onlyFree && m_busyMutexes.count((*it)->getMutex()) > 0)
+      continue;
+    if (next == m_mutexedTasks.end() || (*it)->cost() > (*next)->cost())
+      next = it;
+  }
+  if (next == m_mutexedTasks.end())
+    return nullptr;
+  auto task = std::move(*next);
+  m_mutexedTasks.erase(next);
+  m_mutexedCost -= task->cost();
+  --m_numMutexedTasks;
+  m_busyMutexes.insert(task->getMutex());
+  return task;
+}
+
+} // namespace Mantid::Kernel
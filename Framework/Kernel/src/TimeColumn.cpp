@@ -0,0 +1,288 @@
+// Mantid Repository : https://github.com/mantidproject/mantid
+//
+// Copyright &copy; 2022 ISIS Rutherford Appleton Laboratory UKRI,
+//   NScD Oak Ridge National Laboratory, European Spallation Source,
+//   Institut Laue - Langevin & CSNS, Institute of High Energy Physics, CAS
+// SPDX - License - Identifier: GPL - 3.0 +
+#include "MantidKernel/TimeColumn.h"
+
+#include <algorithm>
+#include <array>
+#include <limits>
+#include <numeric>
+#include <stdexcept>
+
+namespace Mantid::Kernel {
+
+namespace {
+/// @return true if the offset can be stored in a narrow block
+bool fitsOffset(const int64_t offset) {
+  return offset >= std::numeric_limits<int32_t>::min() && offset <= std::numeric_limits<int32_t>::max();
+}
+
+/// Largest slot that fits in the bookkeeping of a block
+constexpr size_t MAX_SLOT = std::numeric_limits<uint32_t>::max() >> 3;
+} // namespace
+
+/** Add a time at the end
+ * @param time :: the time in nanoseconds
+ */
+void TimeColumn::push_back(const int64_t time) {
+  m_tail.emplace_back(time);
+  if (m_tail.size() == BLOCK_SIZE) {
+    addBlock(m_tail.data());
+    m_tail.clear();
+  }
+}
+
+/** Replace a time
+ * @param i :: index of the time
+ * @param time :: the new time in nanoseconds
+ */
+void TimeColumn::set(const size_t i, const int64_t time) {
+  const size_t blockIndex = i >> BLOCK_BITS;
+  if (blockIndex == m_blocks.size()) {
+    m_tail[i & BLOCK_MASK] = time;
+    return;
+  }
+  uint32_t &block = m_blocks[blockIndex];
+  const size_t slot = block >> SLOT_SHIFT;
+  const size_t index = (slot << BLOCK_BITS) + (i & BLOCK_MASK);
+  if (block & WIDE_FLAG) {
+    m_wideTimes[index] = time;
+    return;
+  }
+  const int64_t unit = UNITS[(block >> 1) & UNIT_MASK];
+  const int64_t offset = time - m_starts[slot];
+  if (offset % unit == 0 && fitsOffset(offset / unit)) {
+    m_offsets[index] = static_cast<int32_t>(offset / unit);
+    return;
+  }
+  // The block needs a finer unit or full storage: encode it again
+  std::vector<int64_t> times(BLOCK_SIZE);
+  const size_t blockStart = blockIndex << BLOCK_BITS;
+  for (size_t k = 0; k < BLOCK_SIZE; ++k)
+    times[k] = blockStart + k == i ? time : nanoseconds(blockStart + k);
+  uint32_t newUnit = 0;
+  if (encodeOffsets(times.data(), newUnit, &m_offsets[slot << BLOCK_BITS])) {
+    m_starts[slot] = times[0];
+    block = static_cast<uint32_t>(slot << SLOT_SHIFT) | (newUnit << 1);
+  } else {
+    // The offsets of the old slot are left unused
+    const size_t wideSlot = m_wideTimes.size() >> BLOCK_BITS;
+    m_wideTimes.insert(m_wideTimes.end(), times.cbegin(), times.cend());
+    block = makeBlock(wideSlot, 0, true);
+  }
+}
+
+/** Add the times of another column at the end
+ * @param other :: the column to append
+ */
+void TimeColumn::append(const TimeColumn &other) {
+  // other may be this column
+  const size_t numOther = other.size();
+  reserve(size() + numOther);
+  for (size_t i = 0; i < numOther; ++i)
+    push_back(other.nanoseconds(i));
+}
+
+/** Remove the times with indices in [first, last). The blocks before the one
+ * holding first are kept as they are and the times after it are added again.
+ * @param first :: index of the first time to remove
+ * @param last :: index after the last time to remove
+ */
+void TimeColumn::erase(const size_t first, size_t last) {
+  const size_t numTimes = size();
+  last = std::min(last, numTimes);
+  if (first >= last)
+    return;
+  const size_t numKept = first >> BLOCK_BITS;
+  std::vector<int64_t> moved;
+  moved.reserve(numTimes - (last - first) - (numKept << BLOCK_BITS));
+  for (size_t i = numKept << BLOCK_BITS; i < first; ++i)
+    moved.emplace_back(nanoseconds(i));
+  for (size_t i = last; i < numTimes; ++i)
+    moved.emplace_back(nanoseconds(i));
+  keepBlocks(numKept);
+  for (const auto time : moved)
+    push_back(time);
+}
+
+/** Reorder the times
+ * @param order :: the new i-th time is the current order[i]-th time
+ */
+void TimeColumn::permute(const std::vector<size_t> &order) {
+  TimeColumn result;
+  result.reserve(order.size());
+  for (const auto i : order)
+    result.push_back(nanoseconds(i));
+  *this = std::move(result);
+}
+
+/** Reserve memory for the given number of times, assuming they fit in narrow
+ * blocks
+ * @param size :: total number of times
+ */
+void TimeColumn::reserve(const size_t size) {
+  const size_t numBlocks = size >> BLOCK_BITS;
+  m_blocks.reserve(numBlocks);
+  m_starts.reserve(numBlocks);
+  m_offsets.reserve(numBlocks << BLOCK_BITS);
+}
+
+/// Remove all the times and free their memory
+void TimeColumn::clear() {
+  std::vector<uint32_t>().swap(m_blocks);
+  std::vector<int64_t>().swap(m_starts);
+  std::vector<int32_t>().swap(m_offsets);
+  std::vector<int64_t>().swap(m_wideTimes);
+  std::vector<int64_t>().swap(m_tail);
+}
+
+/// @return true if the times never decrease
+bool TimeColumn::isSorted() const {
+  for (size_t i = 1; i < size(); ++i) {
+    if (nanoseconds(i) < nanoseconds(i - 1))
+      return false;
+  }
+  return true;
+}
+
+/// @return the indices of the times in increasing time, equal times in their current order
+std::vector<size_t> TimeColumn::sortedOrder() const {
+  std::vector<int64_t> times(size());
+  for (size_t i = 0; i < size(); ++i)
+    times[i] = nanoseconds(i);
+  std::vector<size_t> order(size());
+  std::iota(order.begin(), order.end(), 0);
+  std::stable_sort(order.begin(), order.end(),
+                   [&times](const size_t a, const size_t b) { return times[a] < times[b]; });
+  return order;
+}
+
+/** Binary search of the times in [first, last), which must be sorted
+ * @param time :: the time in nanoseconds to look for
+ * @param first :: index of the first time to search
+ * @param last :: index after the last time to search
+ * @return the index of the first time not before time, or last if there is none
+ */
+size_t TimeColumn::lowerBound(const int64_t time, size_t first, size_t last) const {
+  while (first < last) {
+    const size_t middle = first + (last - first) / 2;
+    if (nanoseconds(middle) < time)
+      first = middle + 1;
+    else
+      last = middle;
+  }
+  return first;
+}
+
+/** Binary search of the times in [first, last), which must be sorted
+ * @param time :: the time in nanoseconds to look for
+ * @param first :: index of the first time to search
+ * @param last :: index after the last time to search
+ * @return the index of the first time after time, or last if there is none
+ */
+size_t TimeColumn::upperBound(const int64_t time, size_t first, size_t last) const {
+  while (first < last) {
+    const size_t middle = first + (last - first) / 2;
+    if (nanoseconds(middle) <= time)
+      first = middle + 1;
+    else
+      last = middle;
+  }
+  return first;
+}
+
+/// @return the times as a vector
+std::vector<Types::Core::DateAndTime> TimeColumn::toVector() const {
+  std::vector<Types::Core::DateAndTime> times;
+  times.reserve(size());
+  for (size_t i = 0; i < size(); ++i)
+    times.emplace_back(nanoseconds(i));
+  return times;
+}
+
+/// @return the memory used by the times, in bytes
+size_t TimeColumn::getMemorySize() const {
+  return m_blocks.size() * sizeof(uint32_t) + m_starts.size() * sizeof(int64_t) +
+         m_offsets.size() * sizeof(int32_t) + (m_wideTimes.size() + m_tail.size()) * sizeof(int64_t);
+}
+
+/** Encode the times of a block as offsets from the first one in the coarsest
+ * unit that they are all a whole number of. Each unit divides the ones before
+ * it.
+ * @param times :: the BLOCK_SIZE times of the block
+ * @param unit :: set to the index of the unit in UNITS
+ * @param offsets :: filled with the BLOCK_SIZE offsets if they fit; may be
+ * overwritten otherwise
+ * @return true if the offsets fit in 32 bits
+ */
+bool TimeColumn::encodeOffsets(const int64_t *times, uint32_t &unit, int32_t *offsets) {
+  const int64_t start = times[0];
+  unit = 0;
+  for (size_t k = 1; k < BLOCK_SIZE; ++k) {
+    while (unit < UNIT_MASK && (times[k] - start) % UNITS[unit] != 0)
+      ++unit;
+  }
+  std::array<int32_t, BLOCK_SIZE> encoded;
+  for (size_t k = 0; k < BLOCK_SIZE; ++k) {
+    const int64_t offset = (times[k] - start) / UNITS[unit];
+    if (!fitsOffset(offset))
+      return false;
+    encoded[k] = static_cast<int32_t>(offset);
+  }
+  std::copy(encoded.cbegin(), encoded.cend(), offsets);
+  return true;
+}
+
+/** @return the bookkeeping of a block
+ * @param slot :: slot of the block in m_starts and m_offsets, or in m_wideTimes
+ * @param unit :: index of the unit of the offsets in UNITS
+ * @param wide :: true if the times are stored in full
+ */
+uint32_t TimeColumn::makeBlock(const size_t slot, const uint32_t unit, const bool wide) {
+  if (slot > MAX_SLOT)
+    throw std::length_error("TimeColumn cannot hold more times");
+  return static_cast<uint32_t>(slot << SLOT_SHIFT) | (unit << 1) | (wide ? WIDE_FLAG : 0);
+}
+
+/** Encode a complete block of times and add it after the existing blocks
+ * @param times :: the BLOCK_SIZE times of the block
+ */
+void TimeColumn::addBlock(const int64_t *times) {
+  std::array<int32_t, BLOCK_SIZE> offsets;
+  uint32_t unit = 0;
+  if (encodeOffsets(times, unit, offsets.data())) {
+    m_blocks.emplace_back(makeBlock(m_starts.size(), unit, false));
+    m_starts.emplace_back(times[0]);
+    m_offsets.insert(m_offsets.end(), offsets.cbegin(), offsets.cend());
+  } else {
+    m_blocks.emplace_back(makeBlock(m_wideTimes.size() >> BLOCK_BITS, 0, true));
+    m_wideTimes.insert(m_wideTimes.end(), times, times + BLOCK_SIZE);
+  }
+}
+
+/** Remove the blocks after the first numBlocks, the storage they used and the
+ * incomplete last block
+ * @param numBlocks :: number of complete blocks to keep
+ */
+void TimeColumn::keepBlocks(const size_t numBlocks) {
+  m_blocks.resize(numBlocks);
+  m_tail.clear();
+  // A block that was widened by set() may have moved its storage after that
+  // of later blocks, so keep up to the last slot still in use
+  size_t numNarrow = 0, numWide = 0;
+  for (const auto block : m_blocks) {
+    const size_t slotEnd = (block >> SLOT_SHIFT) + 1;
+    if (block & WIDE_FLAG)
+      numWide = std::max(numWide, slotEnd);
+    else
+      numNarrow = std::max(numNarrow, slotEnd);
+  }
+  m_starts.resize(numNarrow);
+  m_offsets.resize(numNarrow << BLOCK_BITS);
+  m_wideTimes.resize(numWide << BLOCK_BITS);
+}
+
+} // namespace Mantid::Kernel
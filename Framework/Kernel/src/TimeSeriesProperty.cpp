@@ -30,8 +30,8 @@ Logger g_log("TimeSeriesProperty");
  */
 template <typename TYPE>
 TimeSeriesProperty<TYPE>::TimeSeriesProperty(const std::string &name)
-    : Property(name, typeid(std::vector<TimeValueUnit<TYPE>>)), m_values(), m_size(), m_propSortedFlag(),
-      m_filterApplied() {}
+    : Property(name, typeid(std::vector<TimeValueUnit<TYPE>>)), m_times(), m_values(), m_integrals(), m_size(),
+      m_propSortedFlag(), m_filterApplied() {}
 
 /**
  * Constructor
@@ -92,16 +92,14 @@ template <typename TYPE> std::unique_ptr<TimeSeriesProperty<double>> TimeSeriesP
   }
 
   this->sortIfNecessary();
-  auto it = this->m_values.begin();
-  int64_t t0 = it->time().totalNanoseconds();
-  TYPE v0 = it->value();
+  int64_t t0 = m_times.nanoseconds(0);
+  TYPE v0 = m_values[0];
 
-  it++;
   auto timeSeriesDeriv = std::make_unique<TimeSeriesProperty<double>>(this->name() + "_derivative");
   timeSeriesDeriv->reserve(this->m_values.size() - 1);
-  for (; it != m_values.end(); it++) {
-    TYPE v1 = it->value();
-    int64_t t1 = it->time().totalNanoseconds();
+  for (size_t i = 1; i < m_values.size(); ++i) {
+    TYPE v1 = m_values[i];
+    int64_t t1 = m_times.nanoseconds(i);
     if (t1 != t0) {
       double deriv = 1.e+9 * (double(v1 - v0) / double(t1 - t0));
       auto tm = static_cast<int64_t>((t1 + t0) / 2);
@@ -121,8 +119,8 @@ template <> std::unique_ptr<TimeSeriesProperty<double>> TimeSeriesProperty<std::
  * Return the memory used by the property, in bytes
  * */
 template <typename TYPE> size_t TimeSeriesProperty<TYPE>::getMemorySize() const {
-  // Rough estimate
-  return m_values.size() * (sizeof(TYPE) + sizeof(DateAndTime));
+  // Rough estimate for the values
+  return m_times.getMemorySize() + m_values.size() * sizeof(TYPE);
 }
 
 /**
@@ -144,6 +142,7 @@ template <typename TYPE> TimeSeriesProperty<TYPE> &TimeSeriesProperty<TYPE>::ope
 
   if (rhs) {
     if (this->operator!=(*rhs)) {
+      m_times.append(rhs->m_times);
       m_values.insert(m_values.end(), rhs->m_values.begin(), rhs->m_values.end());
       m_propSortedFlag = TimeSeriesSortStatus::TSUNKNOWN;
     } else {
@@ -266,25 +265,24 @@ void TimeSeriesProperty<TYPE>::filterByTime(const Types::Core::DateAndTime &star
   if (m_values.size() <= 1)
     return;
 
-  typename std::vector<TimeValueUnit<TYPE>>::iterator iterhead, iterend;
-
   // 2. Determine index for start and remove  Note erase is [...)
   int istart = this->findIndex(start);
   if (istart >= 0 && static_cast<size_t>(istart) < m_values.size()) {
     // "start time" is behind time-series's starting time
-    iterhead = m_values.begin() + istart;
 
     // False - The filter time is on the mark.  Erase [begin(),  istart)
     // True - The filter time is larger than T[istart]. Erase[begin(), istart)
     // ...
     //       filter start(time) and move istart to filter startime
-    bool useprefiltertime = !(m_values[istart].time() == start);
+    bool useprefiltertime = !(m_times[istart] == start);
 
     // Remove the series
-    m_values.erase(m_values.begin(), iterhead);
+    m_integrals.clear();
+    m_times.erase(0, istart);
+    m_values.erase(m_values.begin(), m_values.begin() + istart);
 
     if (useprefiltertime) {
-      m_values[0].setTime(start);
+      m_times.set(0, start.totalNanoseconds());
     }
   } else {
     // "start time" is before/after time-series's starting time: do nothing
@@ -294,15 +292,12 @@ void TimeSeriesProperty<TYPE>::filterByTime(const Types::Core::DateAndTime &star
   // 3. Determine index for end and remove  Note erase is [...)
   int iend = this->findIndex(stop);
   if (static_cast<size_t>(iend) < m_values.size()) {
-    if (m_values[iend].time() == stop) {
-      // Filter stop is on a log.  Delete that log
-      iterend = m_values.begin() + iend;
-    } else {
-      // Filter stop is behind iend. Keep iend
-      iterend = m_values.begin() + iend + 1;
-    }
+    // Filter stop on a log: delete that log. Filter stop behind iend: keep iend
+    const size_t iterend = m_times[iend] == stop ? iend : iend + 1;
     // Delete from [iend to mp.end)
-    m_values.erase(iterend, m_values.end());
+    m_integrals.truncate(iterend);
+    m_times.erase(iterend, m_times.size());
+    m_values.erase(m_values.begin() + iterend, m_values.end());
   }
 
   // 4. Make size consistent
@@ -324,10 +319,11 @@ void TimeSeriesProperty<TYPE>::filterByTimes(const std::vector<SplittingInterval
     return;
   }
 
-  // 3. Prepare a copy
-  std::vector<TimeValueUnit<TYPE>> mp_copy;
+  // 3. Prepare the new columns
+  TimeColumn times_copy;
+  std::vector<TYPE> values_copy;
 
-  g_log.debug() << "DB541  mp_copy Size = " << mp_copy.size() << "  Original MP Size = " << m_values.size() << "\n";
+  g_log.debug() << "DB541  Original MP Size = " << m_values.size() << "\n";
 
   // 4. Create new
   for (const auto &splitter : splittervec) {
@@ -350,7 +346,7 @@ void TimeSeriesProperty<TYPE>::filterByTimes(const std::vector<SplittingInterval
     } else if (tstopindex >= int(m_values.size())) {
       tstopindex = int(m_values.size()) - 1;
     } else {
-      if (t_stop == m_values[size_t(tstopindex)].time() && size_t(tstopindex) > 0) {
+      if (t_stop == m_times[size_t(tstopindex)] && size_t(tstopindex) > 0) {
         tstopindex--;
       }
     }
@@ -360,24 +356,21 @@ void TimeSeriesProperty<TYPE>::filterByTimes(const std::vector<SplittingInterval
       g_log.warning() << "Memory Leak In SplitbyTime!\n";
     }
 
-    if (tstartindex == tstopindex) {
-      TimeValueUnit<TYPE> temp(t_start, m_values[tstartindex].value());
-      mp_copy.emplace_back(temp);
-    } else {
-      mp_copy.emplace_back(t_start, m_values[tstartindex].value());
-      for (auto im = size_t(tstartindex + 1); im <= size_t(tstopindex); ++im) {
-        mp_copy.emplace_back(m_values[im].time(), m_values[im].value());
-      }
+    times_copy.push_back(t_start);
+    values_copy.emplace_back(m_values[tstartindex]);
+    for (auto im = size_t(tstartindex + 1); im <= size_t(tstopindex); ++im) {
+      times_copy.push_back(m_times.nanoseconds(im));
+      values_copy.emplace_back(m_values[im]);
     }
   } // ENDFOR
 
-  g_log.debug() << "DB530  Filtered Log Size = " << mp_copy.size() << "  Original Log Size = " << m_values.size()
+  g_log.debug() << "DB530  Filtered Log Size = " << values_copy.size() << "  Original Log Size = " << m_values.size()
                 << "\n";
 
-  // 5. Clear
-  m_values.clear();
-  m_values = mp_copy;
-  mp_copy.clear();
+  // 5. Replace
+  m_integrals.clear();
+  m_times = std::move(times_copy);
+  m_values = std::move(values_copy);
 
   m_size = static_cast<int>(m_values.size());
 }
@@ -415,9 +408,13 @@ void TimeSeriesProperty<TYPE>::splitByTime(std::vector<SplittingInterval> &split
       outputs_tsp.emplace_back(myOutput);
       if (this->m_values.size() == 1) {
         // Special case for TSP with a single entry = just copy.
+        myOutput->m_times = this->m_times;
         myOutput->m_values = this->m_values;
+        myOutput->m_integrals.clear();
         myOutput->m_size = 1;
       } else {
+        myOutput->m_integrals.clear();
+        myOutput->m_times.clear();
         myOutput->m_values.clear();
         myOutput->m_size = 0;
       }
@@ -446,8 +443,11 @@ void TimeSeriesProperty<TYPE>::splitByTime(std::vector<SplittingInterval> &split
 
     int output_index = itspl->index();
     // output workspace index is out of range. go to the next splitter
-    if (output_index < 0 || output_index >= static_cast<int>(numOutputs))
+    if (output_index < 0 || output_index >= static_cast<int>(numOutputs)) {
+      ++itspl;
+      ++counter;
       continue;
+    }
 
     TimeSeriesProperty<TYPE> *myOutput = outputs_tsp[output_index];
     // skip if the input property is of wrong type
@@ -458,29 +458,28 @@ void TimeSeriesProperty<TYPE>::splitByTime(std::vector<SplittingInterval> &split
     }
 
     // Skip the events before the start of the time
-    while (i_property < m_values.size() && m_values[i_property].time() < start)
-      ++i_property;
+    i_property = m_times.lowerBound(start.totalNanoseconds(), i_property, m_times.size());
 
     if (i_property == m_values.size()) {
       // i_property is out of the range. Then use the last entry
-      myOutput->addValue(m_values[i_property - 1].time(), m_values[i_property - 1].value());
+      myOutput->addValue(m_times[i_property - 1], m_values[i_property - 1]);
       break;
     }
 
     // The current entry is within an interval. Record them until out
-    if (m_values[i_property].time() > start && i_property > 0 && !isPeriodic) {
+    if (m_times[i_property] > start && i_property > 0 && !isPeriodic) {
       // Record the previous oneif this property is not exactly on start time
       //   and this entry is not recorded
       size_t i_prev = i_property - 1;
-      if (myOutput->size() == 0 || m_values[i_prev].time() != myOutput->lastTime())
-        myOutput->addValue(m_values[i_prev].time(), m_values[i_prev].value());
+      if (myOutput->size() == 0 || m_times[i_prev] != myOutput->lastTime())
+        myOutput->addValue(m_times[i_prev], m_values[i_prev]);
     }
 
     // Loop through all the entries until out.
-    while (i_property < m_values.size() && m_values[i_property].time() < stop) {
+    while (i_property < m_values.size() && m_times[i_property] < stop) {
 
       // Copy the log out to the output
-      myOutput->addValue(m_values[i_property].time(), m_values[i_property].value());
+      myOutput->addValue(m_times[i_property], m_values[i_property]);
       ++i_property;
     }
 
@@ -519,14 +518,12 @@ void TimeSeriesProperty<TYPE>::splitByTimeVector(const std::vector<DateAndTime>
 
   sortIfNecessary();
 
-  // work on m_values, m_size, and m_time
-  auto const currentTimes = timesAsVector();
-  auto const currentValues = valuesAsVector();
+  // work on m_times and m_values
   size_t index_splitter = 0;
 
   // move splitter index such that the first entry of TSP is before the stop
   // time of a splitter
-  DateAndTime firstPropTime = currentTimes[0];
+  DateAndTime firstPropTime = m_times.front();
   auto firstFilterTime = std::lower_bound(timeToFilterTo.begin(), timeToFilterTo.end(), firstPropTime);
   if (firstFilterTime == timeToFilterTo.end()) {
     // do nothing as the first TimeSeriesProperty entry's time is before any
@@ -541,8 +538,8 @@ void TimeSeriesProperty<TYPE>::splitByTimeVector(const std::vector<DateAndTime>
   DateAndTime filterEndTime;
 
   // move along the entries to find the entry inside the current splitter
-  auto firstEntryInSplitter = std::lower_bound(currentTimes.begin(), currentTimes.end(), filterStartTime);
-  if (firstEntryInSplitter == currentTimes.end()) {
+  size_t timeIndex = m_times.lowerBound(filterStartTime.totalNanoseconds(), 0, m_times.size());
+  if (timeIndex == m_times.size()) {
     // the first splitter's start time is LATER than the last TSP entry, then
     // there won't be any
     // TSP entry to be split into any wsIndex splitter.
@@ -554,11 +551,8 @@ void TimeSeriesProperty<TYPE>::splitByTimeVector(const std::vector<DateAndTime>
     return;
   }
 
-  // first splitter start time is between firstEntryInSplitter and the one
-  // before it. so the index for firstEntryInSplitter is the first TSP entry
-  // in the splitter
-  size_t timeIndex = firstEntryInSplitter - currentTimes.begin();
-  firstPropTime = *firstEntryInSplitter;
+  // first splitter start time is between the entry at timeIndex and the one
+  // before it. so timeIndex is the first TSP entry in the splitter
 
   for (; index_splitter < timeToFilterTo.size() - 1; ++index_splitter) {
     int wsIndex = inputWorkspaceIndicies[index_splitter];
@@ -571,24 +565,24 @@ void TimeSeriesProperty<TYPE>::splitByTimeVector(const std::vector<DateAndTime>
       --timeIndex;
 
     // add the continuous entries to same wsIndex time series property
-    const size_t numEntries = currentTimes.size();
+    const size_t numEntries = m_times.size();
 
     // Add properties to the current wsIndex.
     if (timeIndex >= numEntries) {
       // We have run out of TSP entries, so use the last TSP value
       // for all remaining outputs
-      auto currentTime = currentTimes.back();
+      auto currentTime = m_times.back();
       if (output[wsIndex]->size() == 0 || output[wsIndex]->lastTime() != currentTime) {
-        output[wsIndex]->addValue(currentTime, currentValues.back());
+        output[wsIndex]->addValue(currentTime, m_values.back());
       }
     } else {
       // Add TSP values until we run out or go past the current filter
       // end time.
       for (; timeIndex < numEntries; ++timeIndex) {
-        auto currentTime = currentTimes[timeIndex];
+        auto currentTime = m_times[timeIndex];
         if (output[wsIndex]->size() == 0 || output[wsIndex]->lastTime() < currentTime) {
           // avoid to add duplicate entry
-          output[wsIndex]->addValue(currentTime, currentValues[timeIndex]);
+          output[wsIndex]->addValue(currentTime, m_values[timeIndex]);
         }
         if (currentTime > filterEndTime)
           break;
@@ -676,8 +670,8 @@ void TimeSeriesProperty<TYPE>::makeFilterByValue(std::vector<SplittingInterval>
   for (size_t i = 0; i < m_values.size(); ++i) {
     const DateAndTime lastTime = t;
     // The new entry
-    t = m_values[i].time();
-    TYPE val = m_values[i].value();
+    t = m_times[i];
+    TYPE val = m_values[i];
 
     // A good value?
     const bool isGood = ((val >= min) && (val <= max));
@@ -819,35 +813,17 @@ double TimeSeriesProperty<TYPE>::averageValueInFilter(const std::vector<Splittin
 
   // If there's just a single value in the log, return that.
   if (realSize() == 1) {
-    return static_cast<double>(m_values.front().value());
+    return static_cast<double>(m_values.front());
   }
 
-  sortIfNecessary();
-
-  double numerator(0.0), totalTime(0.0);
-  // Loop through the filter ranges
-  for (const auto &time : filter) {
-    // Calculate the total time duration (in seconds) within by the filter
-    totalTime += time.duration();
-
-    // Get the log value and index at the start time of the filter
-    int index;
-    double value = static_cast<double>(getSingleValue(time.start(), index));
-    DateAndTime startTime = time.start();
-
-    while (index < realSize() - 1 && m_values[index + 1].time() < time.stop()) {
-      ++index;
-      numerator += DateAndTime::secondsFromDuration(m_values[index].time() - startTime) * value;
-      startTime = m_values[index].time();
-      value = static_cast<double>(m_values[index].value());
-    }
-
-    // Now close off with the end of the current filter range
-    numerator += DateAndTime::secondsFromDuration(time.stop() - startTime) * value;
-  }
+  // Calculate the total time duration (in seconds) within by the filter
+  const double totalTime = std::accumulate(filter.cbegin(), filter.cend(), 0.,
+                                           [](double sum, const auto &time) { return sum + time.duration(); });
+  // This sorts the log, so take the first value afterwards
+  const double numerator = integrateInFilter(filter).first;
 
   // 'Normalise' by the total time
-  return numerator / totalTime;
+  return static_cast<double>(m_values.front()) + numerator / totalTime;
 }
 
 /** Function specialization for TimeSeriesProperty<std::string>
@@ -874,43 +850,24 @@ template <typename TYPE> std::pair<double, double> TimeSeriesProperty<TYPE>::tim
 template <typename TYPE>
 std::pair<double, double>
 TimeSeriesProperty<TYPE>::averageAndStdDevInFilter(const std::vector<SplittingInterval> &filter) const {
-  // the mean to calculate the standard deviation about
-  // this will sort the log as necessary as well
-  const double mean = this->averageValueInFilter(filter);
-
   // First of all, if the log or the filter is empty or is a single value,
   // return NaN for the uncertainty
   if (realSize() <= 1 || filter.empty()) {
-    return std::pair<double, double>{mean, std::numeric_limits<double>::quiet_NaN()};
+    return std::pair<double, double>{this->averageValueInFilter(filter), std::numeric_limits<double>::quiet_NaN()};
   }
 
-  double numerator(0.0), totalTime(0.0);
-  // Loop through the filter ranges
-  for (const auto &time : filter) {
-    // Calculate the total time duration (in seconds) within by the filter
-    totalTime += time.duration();
-
-    // Get the log value and index at the start time of the filter
-    int index;
-    double value = static_cast<double>(getSingleValue(time.start(), index));
-    double valuestddev = (value - mean) * (value - mean);
-    DateAndTime startTime = time.start();
-
-    while (index < realSize() - 1 && m_values[index + 1].time() < time.stop()) {
-      ++index;
-
-      numerator += DateAndTime::secondsFromDuration(m_values[index].time() - startTime) * valuestddev;
-      startTime = m_values[index].time();
-      value = static_cast<double>(m_values[index].value());
-      valuestddev = (value - mean) * (value - mean);
-    }
-
-    // Now close off with the end of the current filter range
-    numerator += DateAndTime::secondsFromDuration(time.stop() - startTime) * valuestddev;
-  }
+  // Calculate the total time duration (in seconds) within by the filter
+  const double totalTime = std::accumulate(filter.cbegin(), filter.cend(), 0.,
+                                           [](double sum, const auto &time) { return sum + time.duration(); });
+  // This sorts the log, so take the first value afterwards
+  const auto integrals = integrateInFilter(filter);
 
-  // Normalise by the total time
-  return std::pair<double, double>{mean, std::sqrt(numerator / totalTime)};
+  // The moments are about the first value, which keeps the variance accurate
+  // for a log fluctuating a little around a large value
+  const double offset = integrals.first / totalTime;
+  const double mean = static_cast<double>(m_values.front()) + offset;
+  const double variance = std::max(integrals.second / totalTime - offset * offset, 0.);
+  return std::pair<double, double>{mean, std::sqrt(variance)};
 }
 
 /** Function specialization for TimeSeriesProperty<std::string>
@@ -924,6 +881,82 @@ TimeSeriesProperty<std::string>::averageAndStdDevInFilter(const TimeSplitterType
                                        "implemented for string properties");
 }
 
+/** Integrate the log over the ranges of a filter, taking each value to hold
+ *  until the next entry, the first value before the first entry and the last
+ *  value after the last one. The cumulative integrals at the start of each block
+ *  of the time column are cached, so each range costs two binary searches and
+ *  a walk over at most a block of entries rather than over all its entries.
+ *  @param filter The ranges to integrate over
+ *  @return The time integrals, in seconds, of the values minus the first value
+ * and of the squares of these differences
+ */
+template <typename TYPE>
+std::pair<double, double>
+TimeSeriesProperty<TYPE>::integrateInFilter(const std::vector<SplittingInterval> &filter) const {
+  sortIfNecessary();
+  const size_t numEntries = m_values.size();
+  if (numEntries == 0)
+    return {0., 0.};
+
+  const auto firstValue = static_cast<double>(m_values.front());
+  // Add the integrals over entries [first, last), up to the time of entry last
+  const auto addEntries = [this, firstValue](std::pair<double, double> integrals, size_t first, const size_t last) {
+    for (; first < last; ++first) {
+      const double value = static_cast<double>(m_values[first]) - firstValue;
+      const double duration = static_cast<double>(m_times.nanoseconds(first + 1) - m_times.nanoseconds(first)) * 1.e-9;
+      integrals.first += value * duration;
+      integrals.second += value * value * duration;
+    }
+    return integrals;
+  };
+
+  // Extend the cumulative integrals to the blocks started since the last call
+  std::lock_guard<std::mutex> lock(m_integrals.mutex);
+  auto &blocks = m_integrals.blocks;
+  if (blocks.empty())
+    blocks.emplace_back(0., 0.);
+  const size_t numBlocks = (numEntries + TimeColumn::BLOCK_SIZE - 1) / TimeColumn::BLOCK_SIZE;
+  for (size_t block = blocks.size(); block < numBlocks; ++block)
+    blocks.emplace_back(
+        addEntries(blocks.back(), (block - 1) * TimeColumn::BLOCK_SIZE, block * TimeColumn::BLOCK_SIZE));
+
+  // The integrals from the first entry to a time
+  const auto integralsTo = [this, numEntries, firstValue, &blocks, &addEntries](const DateAndTime &time) {
+    const int64_t nanoseconds = time.totalNanoseconds();
+    const size_t next = m_times.upperBound(nanoseconds, 0, numEntries);
+    if (next == 0)
+      return std::pair<double, double>{0., 0.};
+    const size_t index = next - 1;
+    const size_t block = index / TimeColumn::BLOCK_SIZE;
+    auto integrals = addEntries(blocks[block], block * TimeColumn::BLOCK_SIZE, index);
+    const double value = static_cast<double>(m_values[index]) - firstValue;
+    const double duration = static_cast<double>(nanoseconds - m_times.nanoseconds(index)) * 1.e-9;
+    integrals.first += value * duration;
+    integrals.second += value * value * duration;
+    return integrals;
+  };
+
+  std::pair<double, double> result{0., 0.};
+  for (const auto &time : filter) {
+    const auto start = integralsTo(time.start());
+    const auto stop = integralsTo(time.stop());
+    result.first += stop.first - start.first;
+    result.second += stop.second - start.second;
+  }
+  return result;
+}
+
+/** Function specialization for TimeSeriesProperty<std::string>
+ *  @throws Kernel::Exception::NotImplementedError always
+ */
+template <>
+std::pair<double, double>
+TimeSeriesProperty<std::string>::integrateInFilter(const TimeSplitterType & /*filter*/) const {
+  throw Exception::NotImplementedError("TimeSeriesProperty::"
+                                       "integrateInFilter is not "
+                                       "implemented for string properties");
+}
+
 // Re-enable the warnings disabled before makeFilterByValue
 #ifdef _WIN32
 #pragma warning(pop)
@@ -947,7 +980,7 @@ template <typename TYPE> std::map<DateAndTime, TYPE> TimeSeriesProperty<TYPE>::v
 
   if (!m_values.empty()) {
     for (size_t i = 0; i < m_values.size(); i++)
-      asMap[m_values[i].time()] = m_values[i].value();
+      asMap[m_times[i]] = m_values[i];
   }
 
   return asMap;
@@ -959,14 +992,7 @@ template <typename TYPE> std::map<DateAndTime, TYPE> TimeSeriesProperty<TYPE>::v
  */
 template <typename TYPE> std::vector<TYPE> TimeSeriesProperty<TYPE>::valuesAsVector() const {
   sortIfNecessary();
-
-  std::vector<TYPE> out;
-  out.reserve(m_values.size());
-
-  for (size_t i = 0; i < m_values.size(); i++)
-    out.emplace_back(m_values[i].value());
-
-  return out;
+  return m_values;
 }
 
 /**
@@ -980,7 +1006,7 @@ template <typename TYPE> std::multimap<DateAndTime, TYPE> TimeSeriesProperty<TYP
 
   if (!m_values.empty()) {
     for (size_t i = 0; i < m_values.size(); i++)
-      asMultiMap.insert(std::make_pair(m_values[i].time(), m_values[i].value()));
+      asMultiMap.insert(std::make_pair(m_times[i], m_values[i]));
   }
 
   return asMultiMap;
@@ -992,15 +1018,7 @@ template <typename TYPE> std::multimap<DateAndTime, TYPE> TimeSeriesProperty<TYP
  */
 template <typename TYPE> std::vector<DateAndTime> TimeSeriesProperty<TYPE>::timesAsVector() const {
   sortIfNecessary();
-
-  std::vector<DateAndTime> out;
-  out.reserve(m_values.size());
-
-  for (size_t i = 0; i < m_values.size(); i++) {
-    out.emplace_back(m_values[i].time());
-  }
-
-  return out;
+  return m_times.toVector();
 }
 
 /**
@@ -1018,9 +1036,10 @@ template <typename TYPE> std::vector<DateAndTime> TimeSeriesProperty<TYPE>::filt
 
   std::vector<DateAndTime> out;
 
-  for (const auto &value : m_values) {
-    if (isTimeFiltered(value.time())) {
-      out.emplace_back(value.time());
+  for (size_t i = 0; i < m_times.size(); ++i) {
+    const DateAndTime time = m_times[i];
+    if (isTimeFiltered(time)) {
+      out.emplace_back(time);
     }
   }
 
@@ -1039,9 +1058,9 @@ template <typename TYPE> std::vector<double> TimeSeriesProperty<TYPE>::timesAsVe
   std::vector<double> out;
   out.reserve(m_values.size());
 
-  Types::Core::DateAndTime start = m_values[0].time();
-  for (size_t i = 0; i < m_values.size(); i++) {
-    out.emplace_back(DateAndTime::secondsFromDuration(m_values[i].time() - start));
+  Types::Core::DateAndTime start = m_times[0];
+  for (size_t i = 0; i < m_times.size(); i++) {
+    out.emplace_back(DateAndTime::secondsFromDuration(m_times[i] - start));
   }
 
   return out;
@@ -1054,9 +1073,9 @@ template <typename TYPE> std::vector<double> TimeSeriesProperty<TYPE>::timesAsVe
  */
 template <typename TYPE>
 void TimeSeriesProperty<TYPE>::addValue(const Types::Core::DateAndTime &time, const TYPE &value) {
-  TimeValueUnit<TYPE> newvalue(time, value);
-  // Add the value to the back of the vector
-  m_values.emplace_back(newvalue);
+  // Add the value to the back of the columns
+  m_times.push_back(time);
+  m_values.emplace_back(value);
   // Increment the separate record of the property's size
   m_size++;
 
@@ -1066,10 +1085,10 @@ void TimeSeriesProperty<TYPE>::addValue(const Types::Core::DateAndTime &time, co
   if (m_size == 1) {
     // First item, must be sorted.
     m_propSortedFlag = TimeSeriesSortStatus::TSSORTED;
-  } else if (m_propSortedFlag == TimeSeriesSortStatus::TSUNKNOWN && m_values.back() < *(m_values.rbegin() + 1)) {
+  } else if (m_propSortedFlag == TimeSeriesSortStatus::TSUNKNOWN && time < m_times[m_times.size() - 2]) {
     // Previously unknown and still unknown
     m_propSortedFlag = TimeSeriesSortStatus::TSUNSORTED;
-  } else if (m_propSortedFlag == TimeSeriesSortStatus::TSSORTED && m_values.back() < *(m_values.rbegin() + 1)) {
+  } else if (m_propSortedFlag == TimeSeriesSortStatus::TSSORTED && time < m_times[m_times.size() - 2]) {
     // Previously sorted but last added is not in order
     m_propSortedFlag = TimeSeriesSortStatus::TSUNSORTED;
   }
@@ -1109,9 +1128,11 @@ void TimeSeriesProperty<TYPE>::addValues(const std::vector<Types::Core::DateAndT
                                          const std::vector<TYPE> &values) {
   size_t length = std::min(times.size(), values.size());
   m_size += static_cast<int>(length);
+  m_times.reserve(m_times.size() + length);
   for (size_t i = 0; i < length; ++i) {
-    m_values.emplace_back(times[i], values[i]);
+    m_times.push_back(times[i]);
   }
+  m_values.insert(m_values.end(), values.begin(), values.begin() + length);
 
   if (!values.empty())
     m_propSortedFlag = TimeSeriesSortStatus::TSUNKNOWN;
@@ -1142,7 +1163,7 @@ template <typename TYPE> DateAndTime TimeSeriesProperty<TYPE>::lastTime() const
 
   sortIfNecessary();
 
-  return m_values.rbegin()->time();
+  return m_times.back();
 }
 
 /** Returns the first value regardless of filter
@@ -1157,7 +1178,7 @@ template <typename TYPE> TYPE TimeSeriesProperty<TYPE>::firstValue() const {
 
   sortIfNecessary();
 
-  return m_values[0].value();
+  return m_values[0];
 }
 
 /** Returns the first time regardless of filter
@@ -1172,7 +1193,7 @@ template <typename TYPE> DateAndTime TimeSeriesProperty<TYPE>::firstTime() const
 
   sortIfNecessary();
 
-  return m_values[0].time();
+  return m_times[0];
 }
 
 /**
@@ -1188,15 +1209,15 @@ template <typename TYPE> TYPE TimeSeriesProperty<TYPE>::lastValue() const {
 
   sortIfNecessary();
 
-  return m_values.rbegin()->value();
+  return m_values.back();
 }
 
 template <typename TYPE> TYPE TimeSeriesProperty<TYPE>::minValue() const {
-  return std::min_element(m_values.begin(), m_values.end(), TimeValueUnit<TYPE>::valueCmp)->value();
+  return *std::min_element(m_values.begin(), m_values.end());
 }
 
 template <typename TYPE> TYPE TimeSeriesProperty<TYPE>::maxValue() const {
-  return std::max_element(m_values.begin(), m_values.end(), TimeValueUnit<TYPE>::valueCmp)->value();
+  return *std::max_element(m_values.begin(), m_values.end());
 }
 
 template <typename TYPE> double TimeSeriesProperty<TYPE>::mean() const {
@@ -1225,8 +1246,8 @@ template <typename TYPE> std::string TimeSeriesProperty<TYPE>::value() const {
   std::stringstream ins;
   for (size_t i = 0; i < m_values.size(); i++) {
     try {
-      ins << m_values[i].time().toSimpleString();
-      ins << "  " << m_values[i].value() << "\n";
+      ins << m_times[i].toSimpleString();
+      ins << "  " << m_values[i] << "\n";
     } catch (...) {
       // Some kind of error; for example, invalid year, can occur when
       // converting boost time.
@@ -1250,7 +1271,7 @@ template <typename TYPE> std::vector<std::string> TimeSeriesProperty<TYPE>::time
 
   for (size_t i = 0; i < m_values.size(); i++) {
     std::stringstream line;
-    line << m_values[i].time().toSimpleString() << " " << m_values[i].value();
+    line << m_times[i].toSimpleString() << " " << m_values[i];
     values.emplace_back(line.str());
   }
 
@@ -1274,14 +1295,14 @@ template <typename TYPE> std::map<DateAndTime, TYPE> TimeSeriesProperty<TYPE>::v
   if (m_values.empty())
     return asMap;
 
-  TYPE d = m_values[0].value();
-  asMap[m_values[0].time()] = d;
+  TYPE d = m_values[0];
+  asMap[m_times[0]] = d;
 
   for (size_t i = 1; i < m_values.size(); i++) {
-    if (m_values[i].value() != d) {
+    if (m_values[i] != d) {
       // Only put entry with different value from last entry to map
-      asMap[m_values[i].time()] = m_values[i].value();
-      d = m_values[i].value();
+      asMap[m_times[i]] = m_values[i];
+      d = m_values[i];
     }
   }
   return asMap;
@@ -1324,6 +1345,8 @@ std::string TimeSeriesProperty<TYPE>::setDataItem(const std::shared_ptr<DataItem
  */
 template <typename TYPE> void TimeSeriesProperty<TYPE>::clear() {
   m_size = 0;
+  m_integrals.clear();
+  m_times.clear();
   m_values.clear();
 
   m_propSortedFlag = TimeSeriesSortStatus::TSSORTED;
@@ -1339,9 +1362,11 @@ template <typename TYPE> void TimeSeriesProperty<TYPE>::clear() {
  */
 template <typename TYPE> void TimeSeriesProperty<TYPE>::clearOutdated() {
   if (realSize() > 1) {
-    auto lastValue = m_values.back();
+    const DateAndTime lastTime = m_times.back();
+    TYPE lastValue = m_values.back();
     clear();
-    m_values.emplace_back(lastValue);
+    m_times.push_back(lastTime);
+    m_values.emplace_back(std::move(lastValue));
     m_size = 1;
   }
 }
@@ -1388,14 +1413,14 @@ void TimeSeriesProperty<TYPE>::create(const std::vector<Types::Core::DateAndTime
                                 "for the time and values vectors.");
 
   clear();
-  m_values.reserve(new_times.size());
+  m_times.reserve(new_times.size());
+  m_values = new_values;
 
   std::size_t num = new_values.size();
 
   m_propSortedFlag = TimeSeriesSortStatus::TSSORTED;
   for (std::size_t i = 0; i < num; i++) {
-    TimeValueUnit<TYPE> newentry(new_times[i], new_values[i]);
-    m_values.emplace_back(newentry);
+    m_times.push_back(new_times[i]);
     if (m_propSortedFlag == TimeSeriesSortStatus::TSSORTED && i > 0 && new_times[i - 1] > new_times[i]) {
       // Status gets to unsorted
       m_propSortedFlag = TimeSeriesSortStatus::TSUNSORTED;
@@ -1422,12 +1447,12 @@ template <typename TYPE> TYPE TimeSeriesProperty<TYPE>::getSingleValue(const Typ
 
   // 2.
   TYPE value;
-  if (t < m_values[0].time()) {
+  if (t < m_times[0]) {
     // 1. Out side of lower bound
-    value = m_values[0].value();
-  } else if (t >= m_values.back().time()) {
+    value = m_values[0];
+  } else if (t >= m_times.back()) {
     // 2. Out side of upper bound
-    value = m_values.back().value();
+    value = m_values.back();
   } else {
     // 3. Within boundary
     int index = this->findIndex(t);
@@ -1445,7 +1470,7 @@ template <typename TYPE> TYPE TimeSeriesProperty<TYPE>::getSingleValue(const Typ
       throw std::logic_error(errss.str());
     }
 
-    value = m_values[static_cast<size_t>(index)].value();
+    value = m_values[static_cast<size_t>(index)];
   }
 
   return value;
@@ -1469,13 +1494,13 @@ TYPE TimeSeriesProperty<TYPE>::getSingleValue(const Types::Core::DateAndTime &t,
 
   // 2.
   TYPE value;
-  if (t < m_values[0].time()) {
+  if (t < m_times[0]) {
     // 1. Out side of lower bound
-    value = m_values[0].value();
+    value = m_values[0];
     index = 0;
-  } else if (t >= m_values.back().time()) {
+  } else if (t >= m_times.back()) {
     // 2. Out side of upper bound
-    value = m_values.back().value();
+    value = m_values.back();
     index = int(m_values.size()) - 1;
   } else {
     // 3. Within boundary
@@ -1494,7 +1519,7 @@ TYPE TimeSeriesProperty<TYPE>::getSingleValue(const Types::Core::DateAndTime &t,
       throw std::logic_error(errss.str());
     }
 
-    value = m_values[static_cast<size_t>(index)].value();
+    value = m_values[static_cast<size_t>(index)];
   }
 
   return value;
@@ -1533,14 +1558,15 @@ template <typename TYPE> TimeInterval TimeSeriesProperty<TYPE>::nthInterval(int
       ;
     } else if (n == static_cast<int>(m_values.size()) - 1) {
       // 2. Last one by making up an end time.
-      time_duration d = m_values.rbegin()->time() - (m_values.rbegin() + 1)->time();
-      DateAndTime endTime = m_values.rbegin()->time() + d;
-      Kernel::TimeInterval dt(m_values.rbegin()->time(), endTime);
+      const size_t last = m_times.size() - 1;
+      time_duration d = m_times[last] - m_times[last - 1];
+      DateAndTime endTime = m_times[last] + d;
+      Kernel::TimeInterval dt(m_times[last], endTime);
       deltaT = dt;
     } else {
       // 3. Regular
-      DateAndTime startT = m_values[static_cast<std::size_t>(n)].time();
-      DateAndTime endT = m_values[static_cast<std::size_t>(n) + 1].time();
+      DateAndTime startT = m_times[static_cast<std::size_t>(n)];
+      DateAndTime endT = m_times[static_cast<std::size_t>(n) + 1];
       TimeInterval dt(startT, endT);
       deltaT = dt;
     }
@@ -1556,8 +1582,8 @@ template <typename TYPE> TimeInterval TimeSeriesProperty<TYPE>::nthInterval(int
       // 2. n = size of the allowed region, duplicate the last one
       auto ind_t1 = static_cast<long>(m_filterQuickRef.back().first);
       long ind_t2 = ind_t1 - 1;
-      Types::Core::DateAndTime t1 = (m_values.begin() + ind_t1)->time();
-      Types::Core::DateAndTime t2 = (m_values.begin() + ind_t2)->time();
+      Types::Core::DateAndTime t1 = m_times[ind_t1];
+      Types::Core::DateAndTime t2 = m_times[ind_t2];
       time_duration d = t1 - t2;
       Types::Core::DateAndTime t3 = t1 + d;
       Kernel::TimeInterval dt(t1, t3);
@@ -1578,7 +1604,7 @@ template <typename TYPE> TimeInterval TimeSeriesProperty<TYPE>::nthInterval(int
       // i) start time
       Types::Core::DateAndTime ftime0 = m_filter[m_filterQuickRef[refindex].first].first;
       size_t iStartIndex = m_filterQuickRef[refindex + 1].first + static_cast<size_t>(diff);
-      Types::Core::DateAndTime ltime0 = m_values[iStartIndex].time();
+      Types::Core::DateAndTime ltime0 = m_times[iStartIndex];
       if (iStartIndex == 0 && ftime0 < ltime0) {
         // a) Special case that True-filter time starts before log time
         t0 = ltime0;
@@ -1599,7 +1625,7 @@ template <typename TYPE> TimeInterval TimeSeriesProperty<TYPE>::nthInterval(int
         tf = ftimef;
       } else {
         // b) Using the earlier value of next log entry and next filter entry
-        Types::Core::DateAndTime ltimef = m_values[iStopIndex].time();
+        Types::Core::DateAndTime ltimef = m_times[iStopIndex];
         Types::Core::DateAndTime ftimef = m_filter[m_filterQuickRef[refindex + 3].first].first;
         if (ltimef < ftimef)
           tf = ltimef;
@@ -1637,11 +1663,9 @@ template <typename TYPE> TYPE TimeSeriesProperty<TYPE>::nthValue(int n) const {
   if (m_filter.empty()) {
     // 3. Situation 1:  No filter
     if (static_cast<size_t>(n) < m_values.size()) {
-      TimeValueUnit<TYPE> entry = m_values[static_cast<std::size_t>(n)];
-      value = entry.value();
+      value = m_values[static_cast<std::size_t>(n)];
     } else {
-      TimeValueUnit<TYPE> entry = m_values[static_cast<std::size_t>(m_size) - 1];
-      value = entry.value();
+      value = m_values[static_cast<std::size_t>(m_size) - 1];
     }
   } else {
     // 4. Situation 2: There is filter
@@ -1650,7 +1674,7 @@ template <typename TYPE> TYPE TimeSeriesProperty<TYPE>::nthValue(int n) const {
     if (static_cast<size_t>(n) > m_filterQuickRef.back().second + 1) {
       // 1. n >= size of the allowed region
       size_t ilog = (m_filterQuickRef.rbegin() + 1)->first;
-      value = m_values[ilog].value();
+      value = m_values[ilog];
     } else {
       // 2. n < size
       Types::Core::DateAndTime t0;
@@ -1662,7 +1686,7 @@ template <typename TYPE> TYPE TimeSeriesProperty<TYPE>::nthValue(int n) const {
       }
       size_t ilog =
           m_filterQuickRef[refindex + 1].first + (static_cast<std::size_t>(n) - m_filterQuickRef[refindex].second);
-      value = m_values[ilog].value();
+      value = m_values[ilog];
     } // END-IF-ELSE Cases
   }
 
@@ -1686,7 +1710,7 @@ template <typename TYPE> Types::Core::DateAndTime TimeSeriesProperty<TYPE>::nthT
   if (n < 0 || n >= static_cast<int>(m_values.size()))
     n = static_cast<int>(m_values.size()) - 1;
 
-  return m_values[static_cast<size_t>(n)].time();
+  return m_times[static_cast<size_t>(n)];
 }
 
 /* Divide the property into  allowed and disallowed time intervals according to
@@ -1742,12 +1766,12 @@ template <typename TYPE> void TimeSeriesProperty<TYPE>::filterWith(const TimeSer
   // 2b) Get a clean finish
   if (filtervalues.back()) {
     DateAndTime lastTime, nextLastT;
-    if (m_values.back().time() > filtertimes.back()) {
-      const size_t nvalues(m_values.size());
+    if (m_times.back() > filtertimes.back()) {
+      const size_t nvalues(m_times.size());
       // Last log time is later than last filter time
-      lastTime = m_values.back().time();
-      if (nvalues > 1 && m_values[nvalues - 2].time() > filtertimes.back())
-        nextLastT = m_values[nvalues - 2].time();
+      lastTime = m_times.back();
+      if (nvalues > 1 && m_times[nvalues - 2] > filtertimes.back())
+        nextLastT = m_times[nvalues - 2];
       else
         nextLastT = filtertimes.back();
     } else {
@@ -1757,10 +1781,10 @@ template <typename TYPE> void TimeSeriesProperty<TYPE>::filterWith(const TimeSer
       // If last-but-one filter time is still later than value then previous is
       // this
       // else it is the last value time
-      if (nfilterValues > 1 && m_values.back().time() > filtertimes[nfilterValues - 2])
+      if (nfilterValues > 1 && m_times.back() > filtertimes[nfilterValues - 2])
         nextLastT = filtertimes[nfilterValues - 2];
       else
-        nextLastT = m_values.back().time();
+        nextLastT = m_times.back();
     }
 
     time_duration dtime = lastTime - nextLastT;
@@ -1873,29 +1897,28 @@ template <typename TYPE> void TimeSeriesProperty<TYPE>::eliminateDuplicates() {
   // 1. Sort if necessary
   sortIfNecessary();
 
-  // 2. Detect and Remove Duplicated
+  // 2. Detect and Remove Duplicated, keeping the last entry at each time
   size_t numremoved = 0;
 
-  typename std::vector<TimeValueUnit<TYPE>>::iterator vit;
-  vit = m_values.begin() + 1;
-  Types::Core::DateAndTime prevtime = m_values.begin()->time();
-  while (vit != m_values.end()) {
-    Types::Core::DateAndTime currtime = vit->time();
-    if (prevtime == currtime) {
+  TimeColumn times;
+  times.reserve(m_times.size());
+  size_t numkept = 0;
+  for (size_t i = 0; i < m_times.size(); ++i) {
+    if (i + 1 < m_times.size() && m_times.nanoseconds(i) == m_times.nanoseconds(i + 1)) {
       // Print out warning
-      g_log.debug() << "Entry @ Time = " << prevtime
-                    << "has duplicate time stamp.  Remove entry with Value = " << (vit - 1)->value() << "\n";
-
-      // A duplicated entry!
-      vit = m_values.erase(vit - 1);
-
+      g_log.debug() << "Entry @ Time = " << m_times[i]
+                    << "has duplicate time stamp.  Remove entry with Value = " << m_values[i] << "\n";
       numremoved++;
+      continue;
     }
-
-    // b) progress
-    prevtime = currtime;
-    ++vit;
+    times.push_back(m_times.nanoseconds(i));
+    if (numkept != i)
+      m_values[numkept] = m_values[i];
+    ++numkept;
   }
+  m_integrals.clear();
+  m_times = std::move(times);
+  m_values.resize(numkept);
 
   // update m_size
   countSize();
@@ -1911,7 +1934,7 @@ template <typename TYPE> void TimeSeriesProperty<TYPE>::eliminateDuplicates() {
 template <typename TYPE> std::string TimeSeriesProperty<TYPE>::toString() const {
   std::stringstream ss;
   for (size_t i = 0; i < m_values.size(); ++i)
-    ss << m_values[i].time() << "\t\t" << m_values[i].value() << "\n";
+    ss << m_times[i] << "\t\t" << m_values[i] << "\n";
 
   return ss.str();
 }
@@ -1927,7 +1950,7 @@ template <typename TYPE> std::string TimeSeriesProperty<TYPE>::toString() const
  */
 template <typename TYPE> void TimeSeriesProperty<TYPE>::sortIfNecessary() const {
   if (m_propSortedFlag == TimeSeriesSortStatus::TSUNKNOWN) {
-    bool sorted = is_sorted(m_values.begin(), m_values.end());
+    bool sorted = m_times.isSorted();
     if (sorted)
       m_propSortedFlag = TimeSeriesSortStatus::TSSORTED;
     else
@@ -1936,11 +1959,23 @@ template <typename TYPE> void TimeSeriesProperty<TYPE>::sortIfNecessary() const
 
   if (m_propSortedFlag == TimeSeriesSortStatus::TSUNSORTED) {
     g_log.information("TimeSeriesProperty is not sorted.  Sorting is operated on it. ");
-    std::stable_sort(m_values.begin(), m_values.end());
+    sortByTime();
     m_propSortedFlag = TimeSeriesSortStatus::TSSORTED;
   }
 }
 
+/// Sort both columns by time, keeping the order of the entries at equal times
+template <typename TYPE> void TimeSeriesProperty<TYPE>::sortByTime() const {
+  const auto order = m_times.sortedOrder();
+  m_integrals.clear();
+  m_times.permute(order);
+  std::vector<TYPE> values;
+  values.reserve(m_values.size());
+  for (const auto index : order)
+    values.emplace_back(std::move(m_values[index]));
+  m_values = std::move(values);
+}
+
 /** Find the index of the entry of time t in the mP vector (sorted)
  *  Return @ if t is within log.begin and log.end, then the index of the log
  * equal or just smaller than t
@@ -1956,19 +1991,17 @@ template <typename TYPE> int TimeSeriesProperty<TYPE>::findIndex(Types::Core::Da
   sortIfNecessary();
 
   // 2. Extreme value
-  if (t <= m_values[0].time()) {
+  if (t <= m_times[0]) {
     return -1;
-  } else if (t >= m_values.back().time()) {
-    return (int(m_values.size()));
+  } else if (t >= m_times.back()) {
+    return (int(m_times.size()));
   }
 
   // 3. Find by lower_bound()
-  typename std::vector<TimeValueUnit<TYPE>>::const_iterator fid;
-  TimeValueUnit<TYPE> temp(t, m_values[0].value());
-  fid = std::lower_bound(m_values.begin(), m_values.end(), temp);
+  const size_t fid = m_times.lowerBound(t.totalNanoseconds(), 0, m_times.size());
 
-  int newindex = int(fid - m_values.begin());
-  if (fid->time() > t)
+  int newindex = int(fid);
+  if (m_times[fid] > t)
     newindex--;
 
   return newindex;
@@ -1994,25 +2027,22 @@ int TimeSeriesProperty<TYPE>::upperBound(Types::Core::DateAndTime t, int istart,
   }
 
   // 1. Return instantly if it is out of boundary
-  if (t < (m_values.begin() + istart)->time()) {
+  if (t < m_times[istart]) {
     return -1;
   }
-  if (t > (m_values.begin() + iend)->time()) {
+  if (t > m_times[iend]) {
     return static_cast<int>(m_values.size());
   }
 
   // 2. Sort
   sortIfNecessary();
 
-  // 3. Construct the pair for comparison and do lower_bound()
-  TimeValueUnit<TYPE> temppair(t, m_values[0].value());
-  typename std::vector<TimeValueUnit<TYPE>>::iterator fid;
-  fid = std::lower_bound((m_values.begin() + istart), (m_values.begin() + iend + 1), temppair);
-  if (fid == m_values.end())
+  // 3. Do lower_bound()
+  const size_t index = m_times.lowerBound(t.totalNanoseconds(), istart, iend + 1);
+  if (index == m_times.size())
     throw std::runtime_error("Cannot find data");
 
   // 4. Calculate return value
-  size_t index = size_t(fid - m_values.begin());
 
   return int(index);
 }
@@ -2069,7 +2099,7 @@ template <typename TYPE> void TimeSeriesProperty<TYPE>::applyFilter() const {
         if (!m_filterQuickRef.empty()) {
           numintervals = m_filterQuickRef.back().second;
         }
-        if (m_filter[ift].first < m_values[static_cast<std::size_t>(icurlog)].time()) {
+        if (m_filter[ift].first < m_times[static_cast<std::size_t>(icurlog)]) {
           if (icurlog == 0) {
             throw std::logic_error("In this case, icurlog won't be zero! ");
           }
@@ -2172,7 +2202,9 @@ template <typename TYPE> std::string TimeSeriesProperty<TYPE>::setValueFromPrope
   if (!prop) {
     return "Could not set value: properties have different type.";
   }
+  m_times = prop->m_times;
   m_values = prop->m_values;
+  m_integrals.clear();
   m_size = prop->m_size;
   m_propSortedFlag = prop->m_propSortedFlag;
   m_filter = prop->m_filter;
@@ -2286,12 +2318,12 @@ void TimeSeriesProperty<TYPE>::histogramData(const Types::Core::DateAndTime &tMi
 
   double dt = (t1 - t0) / static_cast<double>(nPoints);
 
-  for (auto &ev : m_values) {
-    auto time = static_cast<double>(ev.time().totalNanoseconds());
+  for (size_t i = 0; i < m_times.size(); ++i) {
+    auto time = static_cast<double>(m_times.nanoseconds(i));
     if (time < t0 || time >= t1)
       continue;
     auto ind = static_cast<size_t>((time - t0) / dt);
-    counts[ind] += static_cast<double>(ev.value());
+    counts[ind] += static_cast<double>(m_values[i]);
   }
 }
 
@@ -2322,9 +2354,9 @@ template <typename TYPE> std::vector<TYPE> TimeSeriesProperty<TYPE>::filteredVal
   sortIfNecessary();
 
   std::vector<TYPE> filteredValues;
-  for (const auto &value : m_values) {
-    if (isTimeFiltered(value.time())) {
-      filteredValues.emplace_back(value.value());
+  for (size_t i = 0; i < m_times.size(); ++i) {
+    if (isTimeFiltered(m_times[i])) {
+      filteredValues.emplace_back(m_values[i]);
     }
   }
 
@@ -0,0 +1,196 @@
+// Mantid Repository : https://github.com/mantidproject/mantid
+//
+// Copyright &copy; 2022 ISIS Rutherford Appleton Laboratory UKRI,
+//   NScD Oak Ridge National Laboratory, European Spallation Source,
+//   Institut Laue - Langevin & CSNS, Institute of High Energy Physics, CAS
+// SPDX - License - Identifier: GPL - 3.0 +
+#include "MantidKernel/TraceRecorder.h"
+#include "MantidKernel/ConfigService.h"
+#include "MantidKernel/Memory.h"
+#include "MantidKernel/MultiThreaded.h"
+
+#include <Poco/Process.h>
+
+#include <json/json.h>
+
+#include <algorithm>
+#include <fstream>
+#include <memory>
+#include <stdexcept>
+
+namespace Mantid::Kernel {
+
+namespace {
+/// Source of the thread indices
+std::atomic<size_t> nextThread(1);
+/// The innermost span open on this thread
+thread_local TraceSpan *currentSpan = nullptr;
+
+/// @return a small index for the current thread, easier to read in a trace than its id
+size_t currentThread() {
+  thread_local const size_t thread = nextThread++;
+  return thread;
+}
+
+/// Add value to the counter, or add the counter if it is not there
+void addTo(std::vector<std::pair<std::string, double>> &counters, const std::string &name, const double value) {
+  auto counter = std::find_if(counters.begin(), counters.end(),
+                              [&name](const std::pair<std::string, double> &item) { return item.first == name; });
+  if (counter == counters.end())
+    counters.emplace_back(name, value);
+  else
+    counter->second += value;
+}
+} // namespace
+
+TraceRecorderImpl::TraceRecorderImpl() : m_enabled(false), m_start(std::chrono::steady_clock::now()) {
+  auto filename = ConfigService::Instance().getValue<std::string>("algorithms.trace.filename");
+  if (filename.is_initialized() && !filename.get().empty()) {
+    m_filename = filename.get();
+    m_enabled = true;
+  }
+}
+
+TraceRecorderImpl::~TraceRecorderImpl() {
+  if (m_filename.empty())
+    return;
+  try {
+    saveTrace(m_filename);
+  } catch (std::exception &) {
+    // Nowhere left to report it
+  }
+}
+
+/// Start recording spans
+void TraceRecorderImpl::enable() { m_enabled = true; }
+
+/// Stop recording spans. The spans already open are still recorded.
+void TraceRecorderImpl::disable() { m_enabled = false; }
+
+/// Forget the recorded spans
+void TraceRecorderImpl::clear() {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  m_events.clear();
+}
+
+/** Add to a counter of the innermost span open on the calling thread. Nothing is
+ * recorded if there is none.
+ * @param name :: name of the counter
+ * @param value :: value to add to the counter
+ */
+void TraceRecorderImpl::addCounter(const std::string &name, const double value) {
+  if (currentSpan)
+    currentSpan->addCounter(name, value);
+}
+
+/// @return a copy of the recorded spans, in the order they ended
+std::vector<TraceRecorderImpl::Event> TraceRecorderImpl::events() const {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  return m_events;
+}
+
+/** Write the recorded spans as a Chrome trace
+ * @param stream :: the stream to write to
+ */
+void TraceRecorderImpl::writeTrace(std::ostream &stream) const {
+  const auto pid = static_cast<Json::Int64>(Poco::Process::id());
+  Json::Value traceEvents(Json::arrayValue);
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    for (const auto &event : m_events) {
+      Json::Value item;
+      item["name"] = event.name;
+      item["cat"] = event.category;
+      item["ph"] = "X";
+      item["pid"] = pid;
+      item["tid"] = static_cast<Json::UInt64>(event.thread);
+      item["ts"] = event.start;
+      item["dur"] = event.duration;
+      Json::Value args(Json::objectValue);
+      for (const auto &counter : event.counters)
+        args[counter.first] = counter.second;
+      item["args"] = args;
+      traceEvents.append(item);
+    }
+  }
+  Json::Value trace;
+  trace["traceEvents"] = traceEvents;
+  trace["displayTimeUnit"] = "ms";
+
+  Json::StreamWriterBuilder builder;
+  builder.settings_["indentation"] = "";
+  std::unique_ptr<Json::StreamWriter> writer(builder.newStreamWriter());
+  writer->write(trace, &stream);
+}
+
+/** Write the recorded spans as a Chrome trace
+ * @param filename :: the file to write to
+ * @throws std::runtime_error if the file cannot be written
+ */
+void TraceRecorderImpl::saveTrace(const std::string &filename) const {
+  std::ofstream file(filename);
+  if (!file)
+    throw std::runtime_error("Cannot open " + filename + " to write the trace");
+  writeTrace(file);
+}
+
+/// Add a completed span
+void TraceRecorderImpl::record(Event event) {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  m_events.emplace_back(std::move(event));
+}
+
+/** Start the span, if the recorder is enabled
+ * @param name :: name of the span
+ * @param category :: category of the span, e.g. algorithm
+ */
+TraceSpan::TraceSpan(std::string name, std::string category) : m_active(TraceRecorder::Instance().isEnabled()) {
+  if (!m_active)
+    return;
+  m_event.name = std::move(name);
+  m_event.category = std::move(category);
+  m_event.thread = currentThread();
+  m_parent = currentSpan;
+  currentSpan = this;
+  MemoryStats memory;
+  m_startRSS = memory.getCurrentRSS();
+  m_startPeakRSS = memory.getPeakRSS();
+  m_startCPU = std::clock();
+  m_start = std::chrono::steady_clock::now();
+}
+
+/// Record the span
+TraceSpan::~TraceSpan() {
+  if (!m_active)
+    return;
+  const auto end = std::chrono::steady_clock::now();
+  const std::clock_t endCPU = std::clock();
+  currentSpan = m_parent;
+
+  auto &recorder = TraceRecorder::Instance();
+  m_event.start = std::chrono::duration<double, std::micro>(m_start - recorder.m_start).count();
+  m_event.duration = std::chrono::duration<double, std::micro>(end - m_start).count();
+
+  MemoryStats memory;
+  addCounter("rss_change", static_cast<double>(memory.getCurrentRSS()) - static_cast<double>(m_startRSS));
+  addCounter("peak_rss_change", static_cast<double>(memory.getPeakRSS()) - static_cast<double>(m_startPeakRSS));
+  // CPU time of the whole process, so spans running at the same time on other
+  // threads count towards each other's utilisation. On Windows std::clock gives
+  // the wall-clock time instead.
+  if (m_event.duration > 0.) {
+    const double cpu = 1e6 * static_cast<double>(endCPU - m_startCPU) / CLOCKS_PER_SEC;
+    addCounter("thread_utilisation", cpu / (m_event.duration * PARALLEL_GET_MAX_THREADS));
+  }
+  recorder.record(std::move(m_event));
+}
+
+/** Add to a counter of the span
+ * @param name :: name of the counter
+ * @param value :: value to add to the counter
+ */
+void TraceSpan::addCounter(const std::string &name, const double value) {
+  if (m_active)
+    addTo(m_event.counters, name, value);
+}
+
+} // namespace Mantid::Kernel
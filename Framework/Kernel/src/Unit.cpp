@@ -290,6 +290,11 @@ double TOF::singleFromTOF(const double tof) const {
   return tof;
 }
 
+bool TOF::tofCoefficients(TOFCoefficients &coefficients) const {
+  coefficients = {1., 0., 1., 0., 1};
+  return true;
+}
+
 Unit *TOF::clone() const { return new TOF(*this); }
 double TOF::conversionTOFMin() const { return -DBL_MAX; }
 ///@return DBL_MAX as ToF convetanble to TOF for in any time range
@@ -397,6 +402,13 @@ double Wavelength::singleFromTOF(const double tof) const {
   x *= factorFrom;
   return x;
 }
+bool Wavelength::tofCoefficients(TOFCoefficients &coefficients) const {
+  if (!isInitialized())
+    return false;
+  const double offsetTo = (emode == 1 || emode == 2) ? sfpTo : 0.;
+  coefficients = {factorTo, offsetTo, factorFrom, do_sfpFrom ? sfpFrom : 0., 1};
+  return true;
+}
 ///@return  Minimal time of flight, which can be reversively converted into
 /// wavelength
 double Wavelength::conversionTOFMin() const {
@@ -722,6 +734,14 @@ double dSpacing::singleFromTOF(const double tof) const {
     return negativeConstantTerm / (0.5 * difc * (1 + sqrt(sqrtTerm)));
 }
 
+/// The conversion is only linear without a quadratic term
+bool dSpacing::tofCoefficients(TOFCoefficients &coefficients) const {
+  if (!isInitialized() || difa != 0. || !toDSpacingError.empty())
+    return false;
+  coefficients = {difc, tzero, 1. / difc, tzero, 1};
+  return true;
+}
+
 double dSpacing::conversionTOFMin() const {
   // quadratic only has a min if difa is positive
   if (difa > 0) {
@@ -872,6 +892,14 @@ double MomentumTransfer::singleToTOF(const double x) const { return 2. * M_PI *
 //
 double MomentumTransfer::singleFromTOF(const double tof) const { return 2. * M_PI * difc / tof; }
 
+bool MomentumTransfer::tofCoefficients(TOFCoefficients &coefficients) const {
+  if (!isInitialized())
+    return false;
+  const double factor = 2. * M_PI * difc;
+  coefficients = {factor, 0., factor, 0., -1};
+  return true;
+}
+
 double MomentumTransfer::conversionTOFMin() const { return 2. * M_PI * difc / DBL_MAX; }
 double MomentumTransfer::conversionTOFMax() const { return DBL_MAX; }
 
@@ -1210,6 +1238,14 @@ double Momentum::singleFromTOF(const double tof) const {
   return factorFrom / x;
 }
 
+bool Momentum::tofCoefficients(TOFCoefficients &coefficients) const {
+  if (!isInitialized())
+    return false;
+  const double offsetTo = (emode == 1 || emode == 2) ? sfpTo : 0.;
+  coefficients = {factorTo, offsetTo, factorFrom, do_sfpFrom ? sfpFrom : 0., -1};
+  return true;
+}
+
 Unit *Momentum::clone() const { return new Momentum(*this); }
 
 // ============================================================================================
@@ -10,10 +10,13 @@
 #include "MantidKernel/MultiThreaded.h"
 #include <Poco/NObserver.h>
 #include <cxxtest/TestSuite.h>
+#include <atomic>
 #include <memory>
 
 #include <mutex>
 #include <sstream>
+#include <string>
+#include <vector>
 
 using namespace Mantid;
 using namespace Mantid::Kernel;
@@ -445,6 +448,66 @@ public:
     TS_ASSERT_EQUALS(*svc.retrieve("item2345"), 2345);
   }
 
+  void test_names_are_case_insensitive() {
+    auto one = std::make_shared<int>(1);
+    svc.add("MixedCase", one);
+    TS_ASSERT(svc.doesExist("mixedcase"));
+    TS_ASSERT(svc.doesExist("MIXEDCASE"));
+    TS_ASSERT_EQUALS(svc.retrieve("mIxEdCaSe"), one);
+    TS_ASSERT_THROWS(svc.add("mixedCASE", one), const std::runtime_error &);
+
+    // Replacing keeps the stored name
+    auto two = std::make_shared<int>(2);
+    svc.addOrReplace("MIXEDCASE", two);
+    TS_ASSERT_EQUALS(svc.retrieve("MixedCase"), two);
+    TS_ASSERT_EQUALS(svc.getObjectNames(), std::vector<std::string>{"MixedCase"});
+
+    // Renaming to the same name in another case only changes the case
+    svc.rename("MixedCase", "MIXEDCASE");
+    TS_ASSERT_EQUALS(svc.size(), 1);
+    TS_ASSERT_EQUALS(svc.retrieve("mixedcase"), two);
+    TS_ASSERT_EQUALS(svc.getObjectNames(), std::vector<std::string>{"MIXEDCASE"});
+
+    svc.remove("mixedCase");
+    TS_ASSERT_EQUALS(svc.size(), 0);
+  }
+
+  void test_getObjectNames_unsorted_is_in_case_insensitive_order() {
+    const std::vector<std::string> names{"delta", "Bravo", "alpha", "Echo", "charlie", "Foxtrot", "golf", "Hotel"};
+    for (size_t i = 0; i < names.size(); ++i)
+      svc.add(names[i], std::make_shared<int>(static_cast<int>(i)));
+
+    TS_ASSERT_EQUALS(svc.getObjectNames(), (std::vector<std::string>{"alpha", "Bravo", "charlie", "delta", "Echo",
+                                                                     "Foxtrot", "golf", "Hotel"}));
+    TS_ASSERT_EQUALS(svc.getObjectNames(DataServiceSort::Sorted),
+                     (std::vector<std::string>{"Bravo", "Echo", "Foxtrot", "Hotel", "alpha", "charlie", "delta",
+                                               "golf"}));
+    const auto objects = svc.getObjects();
+    TS_ASSERT_EQUALS(objects.size(), names.size());
+    TS_ASSERT_EQUALS(*objects.front(), 2);
+    TS_ASSERT_EQUALS(*objects.back(), 7);
+  }
+
+  void test_rename_between_threads() {
+    const int num = 200;
+    for (int i = 0; i < num; ++i)
+      svc.add("a" + std::to_string(i), std::make_shared<int>(i));
+
+    // Each object is renamed back and forth while other threads read
+    PARALLEL_FOR_NO_WSP_CHECK()
+    for (int i = 0; i < num; ++i) {
+      const std::string name = "a" + std::to_string(i);
+      const std::string newName = "b" + std::to_string(num - 1 - i);
+      svc.rename(name, newName);
+      TS_ASSERT_EQUALS(*svc.retrieve(newName), i);
+      svc.rename(newName, name);
+      TS_ASSERT(svc.doesExist(name));
+      TS_ASSERT_EQUALS(svc.getObjectNames().size(), size_t(num));
+    }
+    TS_ASSERT_EQUALS(svc.size(), size_t(num));
+    TS_ASSERT_EQUALS(*svc.retrieve("a123"), 123);
+  }
+
   void test_prefixToHide() { TS_ASSERT_EQUALS(FakeDataService::prefixToHide(), "__"); }
 
   void test_isHiddenDataServiceObject() {
@@ -471,3 +534,45 @@ public:
     TS_ASSERT(!FakeDataService::showingHiddenObjects());
   }
 };
+
+class DataServiceTestPerformance : public CxxTest::TestSuite {
+public:
+  // This pair of boilerplate methods prevent the suite being created statically
+  // This means the constructor isn't called when running other tests
+  static DataServiceTestPerformance *createSuite() { return new DataServiceTestPerformance(); }
+  static void destroySuite(DataServiceTestPerformance *suite) { delete suite; }
+
+  DataServiceTestPerformance() {
+    for (size_t i = 0; i < NUM_OBJECTS; ++i) {
+      m_names.emplace_back("Workspace_" + std::to_string(i));
+      svc.add(m_names.back(), std::make_shared<int>(static_cast<int>(i)));
+    }
+  }
+
+  void test_retrieve_from_many_threads() {
+    std::atomic<int64_t> total(0);
+    PARALLEL_FOR_NO_WSP_CHECK()
+    for (int i = 0; i < NUM_ITERATIONS; ++i) {
+      total += *svc.retrieve(m_names[static_cast<size_t>(i) % NUM_OBJECTS]);
+    }
+    TS_ASSERT_LESS_THAN(0, total.load());
+  }
+
+  void test_retrieve_and_addOrReplace_from_many_threads() {
+    PARALLEL_FOR_NO_WSP_CHECK()
+    for (int i = 0; i < NUM_ITERATIONS; ++i) {
+      const auto &name = m_names[static_cast<size_t>(i) % NUM_OBJECTS];
+      if (i % 10 == 0)
+        svc.addOrReplace(name, std::make_shared<int>(i));
+      else
+        svc.retrieve(name);
+    }
+    TS_ASSERT_EQUALS(svc.size(), NUM_OBJECTS);
+  }
+
+private:
+  static constexpr size_t NUM_OBJECTS = 1000;
+  static constexpr int NUM_ITERATIONS = 2000000;
+  FakeDataService svc;
+  std::vector<std::string> m_names;
+};
@@ -0,0 +1,172 @@
+// Mantid Repository : https://github.com/mantidproject/mantid
+//
+// Copyright &copy; 2022 ISIS Rutherford Appleton Laboratory UKRI,
+//   NScD Oak Ridge National Laboratory, European Spallation Source,
+//   Institut Laue - Langevin & CSNS, Institute of High Energy Physics, CAS
+// SPDX - License - Identifier: GPL - 3.0 +
+#pragma once
+
+#include "MantidKernel/DiskBuffer.h"
+#include "MantidKernel/DiskPrefetcher.h"
+#include "MantidKernel/ISaveable.h"
+
+#include <cxxtest/TestSuite.h>
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <thread>
+
+using namespace Mantid::Kernel;
+
+namespace {
+/// ISaveable counting its loads; load() is safe to call concurrently
+class PrefetchTester : public ISaveable {
+public:
+  explicit PrefetchTester(const size_t size) { setFilePosition(0, size, true); }
+  void save() const override {}
+  void load() override {
+    std::lock_guard<std::mutex> lock(m_loadMutex);
+    if (!m_loaded) {
+      m_loaded = true;
+      ++numLoads;
+    }
+  }
+  void flushData() const override {}
+  void clearDataFromMemory() override { m_loaded = false; }
+  uint64_t getTotalDataSize() const override { return getFileSize(); }
+  size_t getDataMemorySize() const override { return m_loaded ? getFileSize() : 0; }
+  bool loaded() const { return m_loaded; }
+
+  std::atomic<int> numLoads{0};
+
+private:
+  std::mutex m_loadMutex;
+  std::atomic<bool> m_loaded{false};
+};
+
+/// Wait up to a second for a condition set by the background thread
+template <class Condition> bool waitFor(Condition condition) {
+  for (int i = 0; i < 1000 && !condition(); ++i)
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  return condition();
+}
+} // namespace
+
+class DiskPrefetcherTest : public CxxTest::TestSuite {
+public:
+  // This pair of boilerplate methods prevent the suite being created statically
+  // This means the constructor isn't called when running other tests
+  static DiskPrefetcherTest *createSuite() { return new DiskPrefetcherTest(); }
+  static void destroySuite(DiskPrefetcherTest *suite) { delete suite; }
+
+  void setUp() override {
+    m_buffer = std::make_unique<DiskBuffer>(1000);
+    m_objects.clear();
+    for (size_t i = 0; i < 10; ++i)
+      m_objects.emplace_back(std::make_unique<PrefetchTester>(10));
+  }
+
+  void test_loads_everything_within_the_limit() {
+    DiskPrefetcher prefetcher(pointers(), *m_buffer, 1000);
+    TS_ASSERT(waitFor([&] { return prefetcher.getNumLoaded() == 10; }));
+    for (const auto &object : m_objects) {
+      TS_ASSERT(object->loaded());
+      TS_ASSERT_EQUALS(object->numLoads, 1);
+    }
+  }
+
+  void test_stays_within_the_limit_ahead_of_the_caller() {
+    DiskPrefetcher prefetcher(pointers(), *m_buffer, 30);
+    TS_ASSERT(waitFor([&] { return prefetcher.getNumLoaded() == 3; }));
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    TS_ASSERT_EQUALS(prefetcher.getNumLoaded(), 3);
+    TS_ASSERT(!m_objects[3]->loaded());
+
+    // Using the first five objects lets it load up to the eighth
+    prefetcher.advanceTo(5);
+    TS_ASSERT(waitFor([&] { return m_objects[7]->loaded(); }));
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    TS_ASSERT(!m_objects[3]->loaded());
+    TS_ASSERT(!m_objects[4]->loaded());
+    TS_ASSERT(!m_objects[8]->loaded());
+  }
+
+  void test_prefetchers_of_the_same_buffer_share_the_limit() {
+    std::vector<std::unique_ptr<PrefetchTester>> others;
+    std::vector<ISaveable *> otherPointers;
+    for (size_t i = 0; i < 10; ++i) {
+      others.emplace_back(std::make_unique<PrefetchTester>(10));
+      otherPointers.emplace_back(others.back().get());
+    }
+    DiskPrefetcher prefetcher(pointers(), *m_buffer, 60);
+    DiskPrefetcher other(otherPointers, *m_buffer, 60);
+    // Each gets half of the limit
+    TS_ASSERT(waitFor([&] { return other.getNumLoaded() == 3; }));
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    TS_ASSERT_EQUALS(other.getNumLoaded(), 3);
+    TS_ASSERT(!others[3]->loaded());
+    TS_ASSERT_LESS_THAN_EQUALS(prefetcher.getNumLoaded(), 6);
+
+    // A prefetcher of another buffer has a limit of its own
+    DiskBuffer otherBuffer(1000);
+    std::vector<std::unique_ptr<PrefetchTester>> alone;
+    std::vector<ISaveable *> alonePointers;
+    for (size_t i = 0; i < 10; ++i) {
+      alone.emplace_back(std::make_unique<PrefetchTester>(10));
+      alonePointers.emplace_back(alone.back().get());
+    }
+    {
+      DiskPrefetcher separate(alonePointers, otherBuffer, 60);
+      TS_ASSERT(waitFor([&] { return separate.getNumLoaded() == 6; }));
+    }
+  }
+
+  void test_always_loads_the_next_object() {
+    DiskPrefetcher prefetcher(pointers(), *m_buffer, 0);
+    TS_ASSERT(waitFor([&] { return m_objects[0]->loaded(); }));
+    prefetcher.advanceTo(9);
+    TS_ASSERT(waitFor([&] { return m_objects[9]->loaded(); }));
+    TS_ASSERT_EQUALS(prefetcher.getNumLoaded(), 2);
+  }
+
+  void test_concurrent_loads_by_the_caller() {
+    {
+      DiskPrefetcher prefetcher(pointers(), *m_buffer, 1000);
+      for (size_t i = 0; i < m_objects.size(); ++i) {
+        prefetcher.advanceTo(i);
+        m_objects[i]->load();
+      }
+    }
+    // Each object is loaded once, by whichever thread got there first
+    for (const auto &object : m_objects)
+      TS_ASSERT_EQUALS(object->numLoads, 1);
+  }
+
+  void test_loaded_objects_are_given_to_the_buffer() {
+    {
+      DiskPrefetcher prefetcher(pointers(), *m_buffer, 30);
+      for (size_t i = 0; i <= m_objects.size(); ++i) {
+        TS_ASSERT(waitFor([&] { return prefetcher.getNumLoaded() >= std::min(i + 1, m_objects.size()); }));
+        prefetcher.advanceTo(i);
+      }
+    }
+    // Each object was added to the buffer once
+    TS_ASSERT_EQUALS(m_buffer->getWriteBufferUsed(), 100);
+  }
+
+  void test_destruction_while_loading() {
+    TS_ASSERT_THROWS_NOTHING(DiskPrefetcher(pointers(), *m_buffer, 1000));
+  }
+
+private:
+  std::vector<ISaveable *> pointers() const {
+    std::vector<ISaveable *> result;
+    for (const auto &object : m_objects)
+      result.emplace_back(object.get());
+    return result;
+  }
+
+  std::unique_ptr<DiskBuffer> m_buffer;
+  std::vector<std::unique_ptr<PrefetchTester>> m_objects;
+};
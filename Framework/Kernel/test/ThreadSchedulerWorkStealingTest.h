@@ -0,0 +1,117 @@
+// Mantid Repository : https://github.com/mantidproject/mantid
+//
+// Copyright &copy; 2022 ISIS Rutherford Appleton Laboratory UKRI,
+//   NScD Oak Ridge National Laboratory, European Spallation Source,
+//   Institut Laue - Langevin & CSNS, Institute of High Energy Physics, CAS
+// SPDX - License - Identifier: GPL - 3.0 +
+#pragma once
+
+#include <cxxtest/TestSuite.h>
+
+#include "MantidKernel/FunctionTask.h"
+#include "MantidKernel/ThreadSchedulerWorkStealing.h"
+
+#include <functional>
+#include <memory>
+
+using namespace Mantid::Kernel;
+
+class ThreadSchedulerWorkStealingTest : public CxxTest::TestSuite {
+public:
+  // This pair of boilerplate methods prevent the suite being created statically
+  // This means the constructor isn't called when running other tests
+  static ThreadSchedulerWorkStealingTest *createSuite() { return new ThreadSchedulerWorkStealingTest(); }
+  static void destroySuite(ThreadSchedulerWorkStealingTest *suite) { delete suite; }
+
+  void test_default_has_a_queue_for_each_core() {
+    ThreadSchedulerWorkStealing sc;
+    TS_ASSERT_LESS_THAN(0, sc.numQueues());
+    TS_ASSERT(sc.empty());
+    TS_ASSERT_EQUALS(sc.pop(0), nullptr);
+  }
+
+  void test_push_from_outside_goes_to_the_queues_in_turn() {
+    ThreadSchedulerWorkStealing sc(2);
+    auto task1 = makeTask(1.);
+    auto task2 = makeTask(2.);
+    auto task3 = makeTask(3.);
+    sc.push(task1);
+    sc.push(task2);
+    sc.push(task3);
+    TS_ASSERT_EQUALS(sc.size(), 3);
+    TS_ASSERT_DELTA(sc.totalCost(), 6., 1e-12);
+
+    // Worker 0 has tasks 1 and 3 and takes the newest first
+    TS_ASSERT_EQUALS(sc.pop(0), task3);
+    TS_ASSERT_EQUALS(sc.pop(0), task1);
+    // Then steals from worker 1
+    TS_ASSERT_EQUALS(sc.pop(0), task2);
+    TS_ASSERT(sc.empty());
+    TS_ASSERT_DELTA(sc.totalCost(), 0., 1e-12);
+  }
+
+  void test_push_to_a_worker() {
+    ThreadSchedulerWorkStealing sc(3);
+    auto task1 = makeTask(1.);
+    auto task2 = makeTask(2.);
+    sc.push(task1, 2);
+    sc.push(task2, 5);
+    // Worker 1 steals the oldest task of worker 2
+    TS_ASSERT_EQUALS(sc.pop(1), task1);
+    TS_ASSERT_EQUALS(sc.pop(2), task2);
+    TS_ASSERT(sc.empty());
+  }
+
+  void test_push_from_a_task_goes_to_its_worker() {
+    ThreadSchedulerWorkStealing sc(4);
+    auto child = makeTask(1.);
+    auto parent = std::make_shared<FunctionTask>([&sc, &child]() { sc.push(child); });
+    sc.push(parent, 3);
+    auto task = sc.pop(3);
+    TS_ASSERT_EQUALS(task, parent);
+    task->run();
+    sc.finished(task.get(), 3);
+    TS_ASSERT_EQUALS(sc.size(), 1);
+    // Nobody else has to steal it
+    TS_ASSERT_EQUALS(sc.pop(3), child);
+  }
+
+  void test_tasks_sharing_a_mutex_are_not_started_together() {
+    ThreadSchedulerWorkStealing sc(2);
+    auto mutex = std::make_shared<std::mutex>();
+    auto task1 = makeTask(2., mutex);
+    auto task2 = makeTask(1., mutex);
+    auto task3 = makeTask(1.);
+    sc.push(task2);
+    sc.push(task1);
+    sc.push(task3, 1);
+    TS_ASSERT_EQUALS(sc.size(), 3);
+
+    // The largest task with a mutex first
+    TS_ASSERT_EQUALS(sc.pop(0), task1);
+    // The mutex is busy, so worker 0 steals the task without a mutex
+    TS_ASSERT_EQUALS(sc.pop(0), task3);
+    sc.finished(task1.get(), 0);
+    sc.finished(task3.get(), 0);
+    TS_ASSERT_EQUALS(sc.pop(1), task2);
+    TS_ASSERT(sc.empty());
+  }
+
+  void test_clear() {
+    ThreadSchedulerWorkStealing sc(2);
+    sc.push(makeTask(1.));
+    sc.push(makeTask(1.));
+    sc.push(makeTask(1., std::make_shared<std::mutex>()));
+    TS_ASSERT_EQUALS(sc.size(), 3);
+    sc.clear();
+    TS_ASSERT(sc.empty());
+    TS_ASSERT_EQUALS(sc.pop(0), nullptr);
+  }
+
+private:
+  std::shared_ptr<Task> makeTask(const double cost, std::shared_ptr<std::mutex> mutex = nullptr) {
+    auto task = std::make_shared<FunctionTask>(std::function<void()>([]() {}), cost);
+    task->setMutex(std::move(mutex));
+    return task;
+  }
+};
@@ -0,0 +1,201 @@
+// Mantid Repository : https://github.com/mantidproject/mantid
+//
+// Copyright &copy; 2022 ISIS Rutherford Appleton Laboratory UKRI,
+//   NScD Oak Ridge National Laboratory, European Spallation Source,
+//   Institut Laue - Langevin & CSNS, Institute of High Energy Physics, CAS
+// SPDX - License - Identifier: GPL - 3.0 +
+#pragma once
+
+#include "MantidKernel/TimeColumn.h"
+
+#include <cxxtest/TestSuite.h>
+
+#include <cstdint>
+#include <vector>
+
+using namespace Mantid::Kernel;
+using Mantid::Types::Core::DateAndTime;
+
+namespace {
+/// Start of the test logs, in nanoseconds
+constexpr int64_t START = 1000000000000000000;
+
+/// A column of n times, step nanoseconds apart, with a jump of jump
+/// nanoseconds every jumpEvery entries
+TimeColumn makeColumn(const size_t n, const int64_t step, const int64_t jump = 0, const size_t jumpEvery = 0) {
+  TimeColumn column;
+  int64_t time = START;
+  for (size_t i = 0; i < n; ++i) {
+    column.push_back(time);
+    time += step;
+    if (jumpEvery > 0 && (i + 1) % jumpEvery == 0)
+      time += jump;
+  }
+  return column;
+}
+
+/// @return the times of the column in nanoseconds
+std::vector<int64_t> nanosecondsOf(const TimeColumn &column) {
+  std::vector<int64_t> times;
+  for (size_t i = 0; i < column.size(); ++i)
+    times.emplace_back(column.nanoseconds(i));
+  return times;
+}
+} // namespace
+
+class TimeColumnTest : public CxxTest::TestSuite {
+public:
+  // This pair of boilerplate methods prevent the suite being created statically
+  // This means the constructor isn't called when running other tests
+  static TimeColumnTest *createSuite() { return new TimeColumnTest(); }
+  static void destroySuite(TimeColumnTest *suite) { delete suite; }
+
+  void test_empty() {
+    TimeColumn column;
+    TS_ASSERT(column.empty());
+    TS_ASSERT_EQUALS(column.size(), 0);
+    TS_ASSERT_EQUALS(column.getMemorySize(), 0);
+    TS_ASSERT(column.isSorted());
+  }
+
+  void test_fast_log_is_stored_as_offsets() {
+    const size_t n = 10 * TimeColumn::BLOCK_SIZE;
+    auto column = makeColumn(n, 1000);
+    TS_ASSERT_EQUALS(column.size(), n);
+    for (size_t i = 0; i < n; ++i)
+      TS_ASSERT_EQUALS(column.nanoseconds(i), START + static_cast<int64_t>(i) * 1000);
+    TS_ASSERT_EQUALS(column.front(), DateAndTime(START));
+    TS_ASSERT_EQUALS(column.back(), DateAndTime(START + static_cast<int64_t>(n - 1) * 1000));
+    // About half of a vector of DateAndTime
+    TS_ASSERT_LESS_THAN(column.getMemorySize(), n * sizeof(DateAndTime) * 6 / 10);
+  }
+
+  void test_short_column_takes_the_memory_of_plain_times() {
+    auto column = makeColumn(TimeColumn::BLOCK_SIZE - 1, 1000);
+    TS_ASSERT_EQUALS(column.getMemorySize(), (TimeColumn::BLOCK_SIZE - 1) * sizeof(int64_t));
+  }
+
+  void test_slow_log_on_whole_seconds_is_stored_as_offsets() {
+    const size_t n = 10 * TimeColumn::BLOCK_SIZE;
+    // One entry an hour spans far more than the range of nanosecond offsets
+    auto slow = makeColumn(n, 3600000000000);
+    for (size_t i = 0; i < slow.size(); ++i)
+      TS_ASSERT_EQUALS(slow.nanoseconds(i), START + static_cast<int64_t>(i) * 3600000000000);
+    TS_ASSERT_LESS_THAN(slow.getMemorySize(), n * sizeof(DateAndTime) * 6 / 10);
+  }
+
+  void test_irregular_slow_log_and_pauses_are_stored_in_full() {
+    const size_t n = 10 * TimeColumn::BLOCK_SIZE;
+    // Ten seconds and one nanosecond apart: only nanosecond offsets are exact
+    auto slow = makeColumn(n, 10000000001);
+    for (size_t i = 0; i < slow.size(); ++i)
+      TS_ASSERT_EQUALS(slow.nanoseconds(i), START + static_cast<int64_t>(i) * 10000000001);
+    // Plain times and 4 bytes for each block
+    TS_ASSERT_EQUALS(slow.getMemorySize(), n * sizeof(int64_t) + 10 * sizeof(uint32_t));
+
+    // A pause of an hour in the middle of a block
+    auto paused = makeColumn(100, 1000, 3600000000000, 30);
+    TS_ASSERT_EQUALS(paused.nanoseconds(29), START + 29 * 1000);
+    TS_ASSERT_EQUALS(paused.nanoseconds(30), START + 30 * 1000 + 3600000000000);
+    TS_ASSERT_EQUALS(paused.nanoseconds(99), START + 99 * 1000 + 3 * 3600000000000);
+  }
+
+  void test_times_before_the_block_start() {
+    TimeColumn column;
+    column.push_back(START);
+    column.push_back(START - 5);
+    column.push_back(START - 3000000000);
+    TS_ASSERT_EQUALS(nanosecondsOf(column), (std::vector<int64_t>{START, START - 5, START - 3000000000}));
+    TS_ASSERT(!column.isSorted());
+  }
+
+  void test_set() {
+    auto column = makeColumn(200, 1000);
+    column.set(3, START + 3);
+    TS_ASSERT_EQUALS(column.nanoseconds(3), START + 3);
+    // Outside of the range of offsets, in a complete block and in the last one
+    column.set(5, START + 5000000000);
+    column.set(199, START + 7000000000);
+    TS_ASSERT_EQUALS(column.nanoseconds(5), START + 5000000000);
+    TS_ASSERT_EQUALS(column.nanoseconds(199), START + 7000000000);
+    TS_ASSERT_EQUALS(column.nanoseconds(198), START + 198 * 1000);
+    TS_ASSERT_EQUALS(column.nanoseconds(6), START + 6 * 1000);
+    TS_ASSERT_EQUALS(column.nanoseconds(64), START + 64 * 1000);
+
+    // A finer unit than the block was encoded with
+    constexpr int64_t second = 1000000000;
+    auto slow = makeColumn(200, second);
+    slow.set(70, START + 70 * second + 1);
+    TS_ASSERT_EQUALS(slow.nanoseconds(70), START + 70 * second + 1);
+    TS_ASSERT_EQUALS(slow.nanoseconds(71), START + 71 * second);
+    TS_ASSERT_EQUALS(slow.nanoseconds(130), START + 130 * second);
+  }
+
+  void test_append_itself() {
+    auto column = makeColumn(70, 1000);
+    auto expected = nanosecondsOf(column);
+    expected.insert(expected.end(), expected.begin(), expected.end());
+    column.append(column);
+    TS_ASSERT_EQUALS(nanosecondsOf(column), expected);
+  }
+
+  void test_erase() {
+    auto column = makeColumn(300, 1000, 10000000000, 100);
+    auto expected = nanosecondsOf(column);
+
+    // From the front
+    column.erase(0, 10);
+    expected.erase(expected.begin(), expected.begin() + 10);
+    TS_ASSERT_EQUALS(nanosecondsOf(column), expected);
+
+    // From the end
+    column.erase(150, column.size());
+    expected.erase(expected.begin() + 150, expected.end());
+    TS_ASSERT_EQUALS(nanosecondsOf(column), expected);
+
+    // Then add more
+    column.push_back(START + 1);
+    expected.emplace_back(START + 1);
+    TS_ASSERT_EQUALS(nanosecondsOf(column), expected);
+
+    // From the middle, across blocks
+    column.erase(20, 90);
+    expected.erase(expected.begin() + 20, expected.begin() + 90);
+    TS_ASSERT_EQUALS(nanosecondsOf(column), expected);
+
+    // Everything
+    column.erase(0, 1000);
+    TS_ASSERT(column.empty());
+    TS_ASSERT_EQUALS(column.getMemorySize(), 0);
+  }
+
+  void test_sortedOrder_is_stable_and_permute() {
+    TimeColumn column;
+    for (const int64_t time : {START + 3, START + 1, START + 3, START + 2, START + 1})
+      column.push_back(time);
+    const auto order = column.sortedOrder();
+    TS_ASSERT_EQUALS(order, (std::vector<size_t>{1, 4, 3, 0, 2}));
+    column.permute(order);
+    TS_ASSERT(column.isSorted());
+    TS_ASSERT_EQUALS(nanosecondsOf(column),
+                     (std::vector<int64_t>{START + 1, START + 1, START + 2, START + 3, START + 3}));
+  }
+
+  void test_lowerBound() {
+    auto column = makeColumn(200, 10);
+    TS_ASSERT_EQUALS(column.lowerBound(START - 1, 0, column.size()), 0);
+    TS_ASSERT_EQUALS(column.lowerBound(START + 50, 0, column.size()), 5);
+    TS_ASSERT_EQUALS(column.lowerBound(START + 51, 0, column.size()), 6);
+    TS_ASSERT_EQUALS(column.lowerBound(START + 51, 10, 20), 10);
+    TS_ASSERT_EQUALS(column.lowerBound(START + 10000, 0, column.size()), 200);
+  }
+
+  void test_clear_frees_memory() {
+    auto column = makeColumn(200, 10);
+    column.clear();
+    TS_ASSERT(column.empty());
+    TS_ASSERT_EQUALS(column.getMemorySize(), 0);
+    column.push_back(START);
+    TS_ASSERT_EQUALS(column.toVector(), std::vector<DateAndTime>{DateAndTime(START)});
+  }
+};
@@ -17,6 +17,7 @@
 #include <cmath>
 #include <json/value.h>
 #include <memory>
+#include <thread>
 #include <vector>
 
 using namespace Mantid::Kernel;
@@ -642,6 +643,110 @@ public:
     delete intLog;
   }
 
+  void test_averageValueInFilter_follows_changes_to_the_log() {
+    TimeSeriesProperty<double> log("doubleProp");
+    log.addValue(DateAndTime("2007-11-30T16:17:00"), 1.0);
+    log.addValue(DateAndTime("2007-11-30T16:17:10"), 3.0);
+    TimeSplitterType filter{SplittingInterval(DateAndTime("2007-11-30T16:17:00"), DateAndTime("2007-11-30T16:17:40"))};
+    TS_ASSERT_DELTA(log.averageValueInFilter(filter), 2.5, 1e-9);
+
+    // Appending extends the cached integrals
+    log.addValue(DateAndTime("2007-11-30T16:17:20"), 5.0);
+    TS_ASSERT_DELTA(log.averageValueInFilter(filter), 3.5, 1e-9);
+
+    // An entry out of order sorts the log again
+    log.addValue(DateAndTime("2007-11-30T16:17:05"), 2.0);
+    TS_ASSERT_DELTA(log.averageValueInFilter(filter), 3.625, 1e-9);
+
+    // Removing the first entries changes the value before the log starts
+    log.filterByTime(DateAndTime("2007-11-30T16:17:10"), DateAndTime("2007-11-30T16:17:40"));
+    TS_ASSERT_DELTA(log.averageValueInFilter(filter), 4.0, 1e-9);
+  }
+
+  void test_averageAndStdDevInFilter_of_small_changes_to_a_large_value() {
+    TimeSeriesProperty<double> log("doubleProp");
+    log.addValue(DateAndTime("2007-11-30T16:17:00"), 1.e9 + 1.);
+    log.addValue(DateAndTime("2007-11-30T16:17:10"), 1.e9 + 3.);
+    TimeSplitterType filter{SplittingInterval(DateAndTime("2007-11-30T16:17:00"), DateAndTime("2007-11-30T16:17:20"))};
+    const auto meanAndStdDev = log.averageAndStdDevInFilter(filter);
+    TS_ASSERT_DELTA(meanAndStdDev.first, 1.e9 + 2., 1e-6);
+    TS_ASSERT_DELTA(meanAndStdDev.second, 1., 1e-6);
+  }
+
+  void test_averageAndStdDevInFilter_of_a_long_log() {
+    const DateAndTime start("2007-11-30T16:17:00");
+    TimeSeriesProperty<double> log("doubleProp");
+    std::vector<std::pair<int, double>> entries;
+    const auto addEntries = [&](const size_t count) {
+      for (size_t i = 0; i < count; ++i) {
+        const int seconds = entries.empty() ? 0 : entries.back().first + 1 + static_cast<int>(entries.size() % 3);
+        entries.emplace_back(seconds, static_cast<double>((entries.size() * 7) % 13));
+        log.addValue(start + static_cast<double>(seconds), entries.back().second);
+      }
+    };
+    const auto checkFilter = [&](const std::vector<std::pair<int, int>> &ranges) {
+      // Walk the log second by second, as all the times are whole seconds
+      double sum = 0., squareSum = 0., totalTime = 0.;
+      TimeSplitterType filter;
+      for (const auto &range : ranges) {
+        filter.emplace_back(start + static_cast<double>(range.first), start + static_cast<double>(range.second));
+        for (int seconds = range.first; seconds < range.second; ++seconds) {
+          auto entry = std::upper_bound(entries.cbegin(), entries.cend(), seconds,
+                                        [](const int time, const auto &item) { return time < item.first; });
+          const double value = entry == entries.cbegin() ? entries.front().second : std::prev(entry)->second;
+          sum += value;
+          squareSum += value * value;
+          totalTime += 1.;
+        }
+      }
+      const double mean = sum / totalTime;
+      const auto meanAndStdDev = log.averageAndStdDevInFilter(filter);
+      TS_ASSERT_DELTA(log.averageValueInFilter(filter), mean, 1e-9);
+      TS_ASSERT_DELTA(meanAndStdDev.first, mean, 1e-9);
+      TS_ASSERT_DELTA(meanAndStdDev.second, std::sqrt(squareSum / totalTime - mean * mean), 1e-6);
+    };
+    const std::vector<std::vector<std::pair<int, int>>> filters{
+        {{-10, 5}}, {{10, 20}, {100, 400}}, {{50, 51}}, {{129, 131}, {200, 1000}}};
+
+    addEntries(300);
+    for (const auto &filter : filters)
+      checkFilter(filter);
+    // Appending extends the cached integrals
+    addEntries(100);
+    for (const auto &filter : filters)
+      checkFilter(filter);
+    // Removing entries at the end, then adding others in their place
+    log.filterByTime(start, start + 250.);
+    entries.erase(std::upper_bound(entries.begin(), entries.end(), 250,
+                                   [](const int time, const auto &item) { return time < item.first; }),
+                  entries.end());
+    addEntries(50);
+    for (const auto &filter : filters)
+      checkFilter(filter);
+  }
+
+  void test_averageAndStdDevInFilter_from_many_threads() {
+    const DateAndTime start("2007-11-30T16:17:00");
+    TimeSeriesProperty<double> log("doubleProp");
+    for (int i = 0; i < 10000; ++i)
+      log.addValue(start + static_cast<double>(i), static_cast<double>(i % 17));
+    TimeSplitterType filter{SplittingInterval(start + 10., start + 5000.),
+                            SplittingInterval(start + 6000., start + 9990.)};
+    // A copy does not share the integrals of the log
+    const auto expected = TimeSeriesProperty<double>(log).averageAndStdDevInFilter(filter);
+
+    std::vector<std::pair<double, double>> results(8);
+    std::vector<std::thread> threads;
+    for (auto &result : results)
+      threads.emplace_back([&log, &filter, &result] { result = log.averageAndStdDevInFilter(filter); });
+    for (auto &thread : threads)
+      thread.join();
+    for (const auto &result : results) {
+      TS_ASSERT_EQUALS(result.first, expected.first);
+      TS_ASSERT_EQUALS(result.second, expected.second);
+    }
+  }
+
   void test_averageValueInFilter_throws_for_string_property() {
     TimeSplitterType splitter;
     TS_ASSERT_THROWS(sProp->averageValueInFilter(splitter), const Exception::NotImplementedError &);
@@ -697,6 +802,23 @@ public:
     delete outputs[4];
   }
 
+  void test_splitByTime_skips_splitters_with_an_invalid_index() {
+    TimeSeriesProperty<int> *log = createIntegerTSP(12);
+    std::vector<Property *> outputs{new TimeSeriesProperty<int>("MyIntLog")};
+
+    TimeSplitterType splitter;
+    const DateAndTime start("2007-11-30T16:17:10"), stop("2007-11-30T16:17:40");
+    splitter.emplace_back(SplittingInterval(start, stop, 1));
+    splitter.emplace_back(SplittingInterval(start, stop, 0));
+
+    log->splitByTime(splitter, outputs, false);
+
+    TS_ASSERT_EQUALS(dynamic_cast<TimeSeriesProperty<int> *>(outputs[0])->realSize(), 3);
+
+    delete log;
+    delete outputs[0];
+  }
+
   //----------------------------------------------------------------------------
   void test_splitByTime_withOverlap() {
     TimeSeriesProperty<int> *log = createIntegerTSP(12);
@@ -2095,7 +2217,8 @@ public:
 
   /*
    * Test getMemorySize()
-   * Note that this will be same with new container
+   * Entries seconds apart are stored in full: one 24 byte block of times plus
+   * 8 bytes for each time and each value
    */
   void test_getMemorySize() {
     TimeSeriesProperty<double> *p = new TimeSeriesProperty<double>("doubleProp");
@@ -2124,6 +2247,19 @@ public:
     return;
   }
 
+  /// Entries less than two seconds apart only store 4 bytes for each time
+  void test_getMemorySize_fast_log() {
+    TimeSeriesProperty<double> p("doubleProp");
+    const DateAndTime start("2007-11-30T16:17:00");
+    const size_t n = TimeColumn::BLOCK_SIZE;
+    for (size_t i = 0; i < n; ++i)
+      p.addValue(start + static_cast<int64_t>(i) * 1000000, static_cast<double>(i));
+
+    // One block of 32-bit offsets, its start and its bookkeeping
+    TS_ASSERT_EQUALS(p.getMemorySize(), 4 + 8 + n * 4 + n * 8);
+    TS_ASSERT_EQUALS(p.nthTime(3), start + int64_t(3000000));
+  }
+
   void test_filter_by_first_value() {
     TimeSeriesProperty<double> series("doubleProperty");
 
@@ -0,0 +1,140 @@
+// Mantid Repository : https://github.com/mantidproject/mantid
+//
+// Copyright &copy; 2022 ISIS Rutherford Appleton Laboratory UKRI,
+//   NScD Oak Ridge National Laboratory, European Spallation Source,
+//   Institut Laue - Langevin & CSNS, Institute of High Energy Physics, CAS
+// SPDX - License - Identifier: GPL - 3.0 +
+#pragma once
+
+#include <cxxtest/TestSuite.h>
+
+#include "MantidJson/Json.h"
+#include "MantidKernel/TraceRecorder.h"
+
+#include <sstream>
+#include <string>
+#include <thread>
+
+using namespace Mantid::Kernel;
+
+namespace {
+/// @return the value of the counter of the event, or -1 if it is not there
+double counterOf(const TraceRecorderImpl::Event &event, const std::string &name) {
+  for (const auto &counter : event.counters) {
+    if (counter.first == name)
+      return counter.second;
+  }
+  return -1.;
+}
+} // namespace
+
+class TraceRecorderTest : public CxxTest::TestSuite {
+public:
+  // This pair of boilerplate methods prevent the suite being created statically
+  // This means the constructor isn't called when running other tests
+  static TraceRecorderTest *createSuite() { return new TraceRecorderTest(); }
+  static void destroySuite(TraceRecorderTest *suite) { delete suite; }
+
+  void setUp() override {
+    TraceRecorder::Instance().clear();
+    TraceRecorder::Instance().enable();
+  }
+
+  void tearDown() override {
+    TraceRecorder::Instance().disable();
+    TraceRecorder::Instance().clear();
+  }
+
+  void test_nothing_is_recorded_when_disabled() {
+    TraceRecorder::Instance().disable();
+    {
+      TraceSpan span("Idle", "test");
+      TS_ASSERT(!span.isActive());
+      span.addCounter("count", 1.);
+    }
+    TS_ASSERT(TraceRecorder::Instance().events().empty());
+  }
+
+  void test_span_records_time_memory_and_utilisation() {
+    {
+      TraceSpan span("Work", "test");
+      TS_ASSERT(span.isActive());
+      std::this_thread::sleep_for(std::chrono::milliseconds(2));
+    }
+    const auto events = TraceRecorder::Instance().events();
+    TS_ASSERT_EQUALS(events.size(), 1);
+    const auto &event = events.front();
+    TS_ASSERT_EQUALS(event.name, "Work");
+    TS_ASSERT_EQUALS(event.category, "test");
+    TS_ASSERT_LESS_THAN_EQUALS(2000., event.duration);
+    TS_ASSERT_LESS_THAN_EQUALS(0., counterOf(event, "peak_rss_change"));
+    TS_ASSERT_LESS_THAN_EQUALS(0., counterOf(event, "thread_utilisation"));
+    TS_ASSERT_DIFFERS(counterOf(event, "rss_change"), -1.);
+  }
+
+  void test_counters_go_to_the_innermost_span() {
+    {
+      TraceSpan parent("Parent", "test");
+      parent.addCounter("bytes_read", 10.);
+      {
+        TraceSpan child("Child", "test");
+        TraceRecorder::Instance().addCounter("bytes_read", 3.);
+        TraceRecorder::Instance().addCounter("bytes_read", 4.);
+      }
+      TraceRecorder::Instance().addCounter("events", 5.);
+    }
+    // Counters outside of any span are dropped
+    TraceRecorder::Instance().addCounter("events", 1.);
+
+    const auto events = TraceRecorder::Instance().events();
+    TS_ASSERT_EQUALS(events.size(), 2);
+    const auto &child = events[0];
+    const auto &parent = events[1];
+    TS_ASSERT_EQUALS(child.name, "Child");
+    TS_ASSERT_EQUALS(parent.name, "Parent");
+    TS_ASSERT_EQUALS(counterOf(child, "bytes_read"), 7.);
+    TS_ASSERT_EQUALS(counterOf(child, "events"), -1.);
+    TS_ASSERT_EQUALS(counterOf(parent, "bytes_read"), 10.);
+    TS_ASSERT_EQUALS(counterOf(parent, "events"), 5.);
+    // The child is nested in the parent on the same thread
+    TS_ASSERT_EQUALS(child.thread, parent.thread);
+    TS_ASSERT_LESS_THAN_EQUALS(parent.start, child.start);
+    TS_ASSERT_LESS_THAN_EQUALS(child.start + child.duration, parent.start + parent.duration);
+  }
+
+  void test_spans_on_other_threads() {
+    {
+      TraceSpan span("Main", "test");
+      std::thread worker([]() { TraceSpan span("Worker", "test"); });
+      worker.join();
+    }
+    const auto events = TraceRecorder::Instance().events();
+    TS_ASSERT_EQUALS(events.size(), 2);
+    TS_ASSERT_EQUALS(events[0].name, "Worker");
+    TS_ASSERT_EQUALS(events[1].name, "Main");
+    TS_ASSERT_DIFFERS(events[0].thread, events[1].thread);
+  }
+
+  void test_writeTrace() {
+    {
+      TraceSpan span("LoadEventNexus", "algorithm");
+      span.addCounter("bytes_read", 1024.);
+    }
+    std::ostringstream stream;
+    TraceRecorder::Instance().writeTrace(stream);
+
+    const auto trace = Mantid::JsonHelpers::stringToJson(stream.str());
+    TS_ASSERT(trace.isMember("traceEvents"));
+    const auto &events = trace["traceEvents"];
+    TS_ASSERT_EQUALS(events.size(), 1);
+    const auto &event = events[0];
+    TS_ASSERT_EQUALS(event["name"].asString(), "LoadEventNexus");
+    TS_ASSERT_EQUALS(event["cat"].asString(), "algorithm");
+    TS_ASSERT_EQUALS(event["ph"].asString(), "X");
+    TS_ASSERT(event.isMember("pid"));
+    TS_ASSERT(event.isMember("tid"));
+    TS_ASSERT(event["ts"].isNumeric());
+    TS_ASSERT(event["dur"].isNumeric());
+    TS_ASSERT_EQUALS(event["args"]["bytes_read"].asDouble(), 1024.);
+  }
+};
@@ -1612,6 +1612,62 @@ public:
     TS_ASSERT(check_vector_conversion(vec, 1.0));
   }
 
+  /// Check that the coefficients of an initialized unit reproduce its conversions
+  void check_tofCoefficients(const Unit &unit, const std::vector<double> &tofs) {
+    TOFCoefficients coefficients{};
+    TSM_ASSERT(unit.unitID(), unit.tofCoefficients(coefficients));
+    for (const double tof : tofs) {
+      const double base = tof - coefficients.fromOffset;
+      const double x = coefficients.power == 1 ? coefficients.fromFactor * base : coefficients.fromFactor / base;
+      TSM_ASSERT_DELTA(unit.unitID(), x, unit.singleFromTOF(tof), 1e-9 * std::abs(x));
+      const double back = (coefficients.power == 1 ? coefficients.toFactor * x : coefficients.toFactor / x) +
+                          coefficients.toOffset;
+      TSM_ASSERT_DELTA(unit.unitID(), back, unit.singleToTOF(x), 1e-9 * std::abs(back));
+    }
+  }
+
+  void test_tofCoefficients() {
+    const std::vector<double> tofs{1000., 5432.1, 20000.};
+    TOFCoefficients coefficients{};
+
+    Units::TOF tofUnit;
+    check_tofCoefficients(tofUnit, tofs);
+
+    Units::Wavelength wavelength;
+    TS_ASSERT(!wavelength.tofCoefficients(coefficients));
+    wavelength.initialize(10., 0, {{UnitParams::l2, 2.}});
+    check_tofCoefficients(wavelength, tofs);
+    wavelength.initialize(10., 1, {{UnitParams::l2, 2.}, {UnitParams::efixed, 50.}});
+    check_tofCoefficients(wavelength, tofs);
+
+    Units::Momentum momentum;
+    momentum.initialize(10., 2, {{UnitParams::l2, 2.}, {UnitParams::efixed, 5.}});
+    check_tofCoefficients(momentum, tofs);
+
+    Units::MomentumTransfer qUnit;
+    qUnit.initialize(10., 0, {{UnitParams::difc, 3000.}});
+    check_tofCoefficients(qUnit, tofs);
+
+    Units::dSpacing dUnit;
+    dUnit.initialize(10., 0, {{UnitParams::difc, 3000.}, {UnitParams::tzero, 5.}});
+    check_tofCoefficients(dUnit, tofs);
+    // A quadratic term has no coefficients
+    dUnit.initialize(10., 0, {{UnitParams::difc, 3000.}, {UnitParams::difa, 1.}});
+    TS_ASSERT(!dUnit.tofCoefficients(coefficients));
+
+    // Units derived from ones with coefficients but with other conversions
+    Units::QSquared q2Unit;
+    q2Unit.initialize(10., 0, {{UnitParams::difc, 3000.}});
+    TS_ASSERT(!q2Unit.tofCoefficients(coefficients));
+    Units::SpinEchoLength spinEchoLength;
+    spinEchoLength.initialize(10., 2, {{UnitParams::l2, 2.}, {UnitParams::efixed, 5.}});
+    TS_ASSERT(!spinEchoLength.tofCoefficients(coefficients));
+
+    Units::Energy energyUnit;
+    energyUnit.initialize(10., 0, {{UnitParams::l2, 2.}});
+    TS_ASSERT(!energyUnit.tofCoefficients(coefficients));
+  }
+
 private:
   Units::Label label;
   Units::TOF tof;
@@ -62,6 +62,11 @@ private:
   /// Helper method
   template <typename MDE, size_t nd> void binByIterating(typename DataObjects::MDEventWorkspace<MDE, nd>::sptr ws);
 
+  /// Copy the bins shared with the last incremental binning
+  bool reuseCachedBins(std::vector<std::vector<size_t>> &regionMin, std::vector<std::vector<size_t>> &regionMax);
+  /// Keep the output for the next incremental binning
+  void cacheBins();
+
   /// Method to bin a single MDBox
   template <typename MDE, size_t nd>
   void binMDBox(DataObjects::MDBox<MDE, nd> *box, const size_t *const chunkMin, const size_t *const chunkMax);
@@ -81,19 +81,19 @@ private:
 
 template <typename EventType, size_t ND, template <size_t> class MDEventType>
 std::vector<MDEventType<ND>> ConvToMDEventsWSIndexing::convertEvents() {
-  std::vector<MDEventType<ND>> mdEvents;
-  mdEvents.reserve(m_EventWS->getNumberEvents());
-
   const auto &pws = m_OutWSWrapper->pWorkspace();
   std::array<std::pair<coord_t, coord_t>, ND> bounds;
   for (size_t ax = 0; ax < ND; ++ax) {
     bounds[ax] = std::make_pair(pws->getDimension(ax)->getMinimum(), pws->getDimension(ax)->getMaximum());
   }
 
+  // Each thread converts its spectra into its own buffer, without locking
+  const int nThreads = numWorkers();
+  std::vector<std::vector<MDEventType<ND>>> threadEvents(nThreads);
   std::vector<MDTransf_sptr> qConverters;
-  for (int i = 0; i < numWorkers(); ++i)
+  for (int i = 0; i < nThreads; ++i)
     qConverters.emplace_back(m_QConverter->clone());
-#pragma omp parallel for num_threads(numWorkers())
+#pragma omp parallel for schedule(dynamic) num_threads(nThreads)
   for (int workspaceIndex = 0; workspaceIndex < static_cast<int>(m_NSpectra); ++workspaceIndex) {
     const Mantid::DataObjects::EventList &el = m_EventWS->getSpectrum(workspaceIndex);
 
@@ -105,6 +105,7 @@ std::vector<MDEventType<ND>> ConvToMDEventsWSIndexing::convertEvents() {
     UnitsConversionHelper localUnitConv(m_UnitConversion);
     // create local QConverter
     MDTransf_sptr localQConverter = qConverters[PARALLEL_THREAD_NUMBER];
+    std::vector<MDEventType<ND>> &mdEventsForThread = threadEvents[PARALLEL_THREAD_NUMBER];
     int32_t detID = m_detID[workspaceIndex];
     uint16_t expInfoIndexLoc = m_ExpInfoIndex;
     uint16_t goniometerIndex(0); // default value
@@ -120,7 +121,6 @@ std::vector<MDEventType<ND>> ConvToMDEventsWSIndexing::convertEvents() {
     typename std::vector<EventType> const *events_ptr;
     getEventsFrom(el, events_ptr);
     const typename std::vector<EventType> &events = *events_ptr;
-    std::vector<MDEventType<ND>> mdEventsForSpectrum;
     // Iterators to start/end
     for (const auto &event : events) {
       double val = localUnitConv.convertUnits(event.tof());
@@ -130,27 +130,32 @@ std::vector<MDEventType<ND>> ConvToMDEventsWSIndexing::convertEvents() {
       if (!localQConverter->calcMatrixCoord(val, locCoord, signal, errorSq))
         continue; // skip ND outside the range
 
-      mdEventsForSpectrum.emplace_back(MDEventMaker<ND, MDEventType>::makeMDEvent(
-          signal, errorSq, expInfoIndexLoc, goniometerIndex, detID, &locCoord[0]));
-
       // Filter events before adding to the ndEvents vector to add in workspace
       // The bounds of the resulting WS have to be already defined
       bool isInOutWSBox = true;
       for (size_t ax = 0; ax < ND; ++ax) {
-        const coord_t &coord{mdEventsForSpectrum.back().getCenter(ax)};
+        const coord_t &coord{locCoord[ax]};
         if (coord < bounds[ax].first || coord > bounds[ax].second)
           isInOutWSBox = false;
       }
 
-      if (!isInOutWSBox)
-        mdEventsForSpectrum.pop_back();
+      if (isInOutWSBox)
+        mdEventsForThread.emplace_back(MDEventMaker<ND, MDEventType>::makeMDEvent(
+            signal, errorSq, expInfoIndexLoc, goniometerIndex, detID, &locCoord[0]));
     }
+  }
 
-#pragma omp critical
-    {
-      /* Add to event list */
-      mdEvents.insert(mdEvents.cend(), mdEventsForSpectrum.begin(), mdEventsForSpectrum.end());
-    }
+  // Concatenate the buffers, freeing each one once it has been copied. The
+  // pages of the reserved vector are only touched as they are filled, so the
+  // memory in use stays close to that of the events plus one buffer.
+  size_t numEvents = 0;
+  for (const auto &buffer : threadEvents)
+    numEvents += buffer.size();
+  std::vector<MDEventType<ND>> mdEvents;
+  mdEvents.reserve(numEvents);
+  for (auto &buffer : threadEvents) {
+    mdEvents.insert(mdEvents.end(), std::make_move_iterator(buffer.begin()), std::make_move_iterator(buffer.end()));
+    std::vector<MDEventType<ND>>().swap(buffer);
   }
   return mdEvents;
 }
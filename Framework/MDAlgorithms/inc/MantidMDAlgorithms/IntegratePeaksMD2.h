@@ -11,6 +11,7 @@
 #include "MantidAPI/IMDEventWorkspace_fwd.h"
 #include "MantidAPI/IPeaksWorkspace.h"
 #include "MantidDataObjects/MDEventWorkspace.h"
+#include "MantidDataObjects/MDIntegrationSphere.h"
 #include "MantidDataObjects/PeaksWorkspace.h"
 #include "MantidDataObjects/Workspace2D.h"
 #include "MantidKernel/System.h"
@@ -57,6 +58,15 @@ private:
 
   template <typename MDE, size_t nd> void integrate(typename DataObjects::MDEventWorkspace<MDE, nd>::sptr ws);
 
+  static Mantid::Kernel::V3D getPeakPosition(const Mantid::Geometry::IPeak &p,
+                                             const Mantid::Kernel::SpecialCoordinateSystem CoordinatesToUse);
+
+  /// Integrate many spheres in one pass over the boxes
+  template <typename MDE, size_t nd>
+  void integrateSpheres(const typename DataObjects::MDEventWorkspace<MDE, nd>::sptr &ws,
+                        const std::vector<DataObjects::MDIntegrationSphere> &spheres, std::vector<signal_t> &signal,
+                        std::vector<signal_t> &errorSquared);
+
   /// Input MDEventWorkspace
   Mantid::API::IMDEventWorkspace_sptr inWS;
 
@@ -58,10 +58,10 @@ private:
   std::vector<coord_t> getValuesFromOtherDimensions(bool &skipNormalization, uint16_t expInfoIndex = 0) const;
 
   void cacheDimensionXValues();
-  void calculateNormalization(const std::vector<coord_t> &otherValues, const Geometry::SymmetryOperation &so,
-                              uint16_t expInfoIndex, size_t soIndex);
+  void calculateNormalization(const std::vector<Geometry::SymmetryOperation> &symmetryOps);
 
-  void calculateIntersections(std::vector<std::array<double, 4>> &intersections, const double theta, const double phi,
+  void calculateIntersections(std::vector<std::array<double, 4>> &intersections,
+                              std::vector<std::array<double, 4>> &crossings, const double theta, const double phi,
                               const Kernel::DblMatrix &transform, double lowvalue, double highvalue);
 
   void calcIntegralsForIntersections(const std::vector<double> &xValues, const API::MatrixWorkspace &integrFlux,
@@ -77,12 +77,8 @@ private:
 
   void calcSingleDetectorNorm(const std::vector<std::array<double, 4>> &intersections, const double &solid,
                               std::vector<double> &yValues, const size_t &vmdDims, std::vector<coord_t> &pos,
-                              std::vector<coord_t> &posNew, std::vector<std::atomic<signal_t>> &signalArray,
-                              const double &solidBkgd, std::vector<std::atomic<signal_t>> &bkgdSignalArray);
-
-  API::IMDWorkspace_sptr divideMD(const API::IMDHistoWorkspace_sptr &lhs, const API::IMDHistoWorkspace_sptr &rhs,
-                                  const std::string &outputwsname, const double &startProgress,
-                                  const double &endProgress);
+                              std::vector<coord_t> &posNew, std::vector<signal_t> &signalArray,
+                              const double &solidBkgd, std::vector<signal_t> &bkgdSignalArray);
 
   /// Normalization workspace
   DataObjects::MDHistoWorkspace_sptr m_normWS;
@@ -115,8 +111,6 @@ private:
   double m_Ei;
   /// Flag indicating if the input workspace is from diffraction
   bool m_diffraction;
-  /// Flag to accumulate normalization
-  bool m_accumulate;
   /// Flag to indicate that the energy dimension is integrated
   bool m_dEIntegrated;
   /// Sample position
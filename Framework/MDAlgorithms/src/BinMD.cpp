@@ -5,6 +5,7 @@
 //   Institut Laue - Langevin & CSNS, Institute of High Energy Physics, CAS
 // SPDX - License - Identifier: GPL - 3.0 +
 #include "MantidMDAlgorithms/BinMD.h"
+#include "MantidAPI/AnalysisDataService.h"
 #include "MantidAPI/ImplicitFunctionFactory.h"
 #include "MantidDataObjects/CoordTransformAffine.h"
 #include "MantidDataObjects/CoordTransformAffineParser.h"
@@ -17,12 +18,18 @@
 #include "MantidGeometry/MDGeometry/MDBoxImplicitFunction.h"
 #include "MantidGeometry/MDGeometry/MDHistoDimension.h"
 #include "MantidKernel/CPUTimer.h"
+#include "MantidKernel/DiskPrefetcher.h"
 #include "MantidKernel/EnabledWhenProperty.h"
 #include "MantidKernel/Strings.h"
 #include "MantidKernel/System.h"
 #include "MantidKernel/Utils.h"
 #include <boost/algorithm/string.hpp>
 
+#include <Poco/NObserver.h>
+
+#include <map>
+#include <mutex>
+
 namespace Mantid::MDAlgorithms {
 
 // Register the algorithm into the AlgorithmFactory
@@ -33,6 +40,84 @@ using namespace Mantid::API;
 using namespace Mantid::Geometry;
 using namespace Mantid::DataObjects;
 
+namespace {
+/// The output of the last incremental binning of a workspace
+struct IncrementalCache {
+  /// The binned workspace; does not keep it alive
+  std::weak_ptr<const IMDWorkspace> workspace;
+  /// Modification count of the binned workspace, to spot any change to it
+  uint64_t modificationCount{0};
+  /// Affine matrix from the binned workspace to bin indices
+  Matrix<coord_t> transform;
+  std::vector<size_t> numBins;
+  std::vector<signal_t> signals;
+  std::vector<signal_t> errorsSquared;
+  std::vector<signal_t> numEvents;
+};
+
+/// The last incremental binning of each workspace. An entry is freed when its
+/// workspace is deleted from the ADS or no longer exists.
+class IncrementalCacheStore {
+public:
+  IncrementalCacheStore()
+      : m_deleteObserver(*this, &IncrementalCacheStore::deleteHandle),
+        m_clearObserver(*this, &IncrementalCacheStore::clearHandle) {
+    AnalysisDataService::Instance().notificationCenter.addObserver(m_deleteObserver);
+    AnalysisDataService::Instance().notificationCenter.addObserver(m_clearObserver);
+  }
+
+  /// Guards the entries
+  std::mutex mutex;
+  std::map<const IMDWorkspace *, IncrementalCache> entries;
+
+  /// Free the entries of workspaces that no longer exist
+  void releaseExpired() {
+    std::lock_guard<std::mutex> lock(mutex);
+    for (auto it = entries.begin(); it != entries.end();) {
+      if (it->second.workspace.expired())
+        it = entries.erase(it);
+      else
+        ++it;
+    }
+  }
+
+private:
+  void deleteHandle(WorkspacePreDeleteNotification_ptr notice) {
+    const auto *ws = dynamic_cast<const IMDWorkspace *>(notice->object().get());
+    if (!ws)
+      return;
+    std::lock_guard<std::mutex> lock(mutex);
+    entries.erase(ws);
+  }
+
+  void clearHandle(ClearADSNotification_ptr /*notice*/) {
+    std::lock_guard<std::mutex> lock(mutex);
+    entries.clear();
+  }
+
+  Poco::NObserver<IncrementalCacheStore, WorkspacePreDeleteNotification> m_deleteObserver;
+  Poco::NObserver<IncrementalCacheStore, ClearADSNotification> m_clearObserver;
+};
+
+/// @return the cache store. It is never destroyed, so that its observers stay
+/// valid for as long as the ADS may send notifications.
+IncrementalCacheStore &incrementalCache() {
+  static auto *store = new IncrementalCacheStore();
+  return *store;
+}
+
+/// @return the modification count of the workspace, 0 if it is not an MDEventWorkspace
+uint64_t modificationCountOf(const IMDWorkspace &ws) {
+  const auto *eventWS = dynamic_cast<const IMDEventWorkspace *>(&ws);
+  return eventWS ? eventWS->getModificationCount() : 0;
+}
+
+/// @return true if two matrix elements are equal to within rounding
+bool nearlyEqual(const coord_t a, const coord_t b) {
+  return std::abs(a - b) <= 1e-5f * std::max({1.f, std::abs(a), std::abs(b)});
+}
+} // namespace
+
 //----------------------------------------------------------------------------------------------
 /** Constructor
  */
@@ -71,6 +156,13 @@ void BinMD::init() {
                   "due to disk thrashing.");
   setPropertyGroup("Parallel", grp);
 
+  declareProperty(std::make_unique<PropertyWithValue<bool>>("Incremental", false, Direction::Input),
+                  "Keep the output for the next incremental BinMD. If the next one bins the same, "
+                  "unchanged workspace with the same bin widths and projection, shifted by a whole "
+                  "number of bins, the overlapping bins are copied and only the rest is binned. "
+                  "Ignored with an ImplicitFunctionXML or a TemporaryDataWorkspace.");
+  setPropertyGroup("Incremental", grp);
+
   declareProperty(std::make_unique<WorkspaceProperty<IMDHistoWorkspace>>("TemporaryDataWorkspace", "", Direction::Input,
                                                                          PropertyMode::Optional),
                   "An input MDHistoWorkspace used to accumulate results from "
@@ -242,6 +334,18 @@ template <typename MDE, size_t nd> void BinMD::binByIterating(typename MDEventWo
     outWS->setTo(0.0, 0.0, 0.0);
   }
 
+  // With Incremental, bins overlapping the last incremental binning are copied
+  // from it and only the regions not covered need binning
+  const bool incremental = getProperty("Incremental");
+  const bool useCache = incremental && !m_accumulate && !implicitFunction;
+  std::vector<std::vector<size_t>> regionMin, regionMax;
+  if (!useCache || !reuseCachedBins(regionMin, regionMax)) {
+    regionMin.assign(1, std::vector<size_t>(m_outD, 0));
+    regionMax.assign(1, std::vector<size_t>(m_outD));
+    for (size_t bd = 0; bd < m_outD; bd++)
+      regionMax[0][bd] = m_binDimensions[bd]->getNBins();
+  }
+
   // The dimension (in the output workspace) along which we chunk for parallel
   // processing
   // TODO: Find the smartest dimension to chunk against
@@ -261,6 +365,19 @@ template <typename MDE, size_t nd> void BinMD::binByIterating(typename MDEventWo
   if (!doParallel)
     chunkNumBins = int(m_binDimensions[chunkDimension]->getNBins());
 
+  // Parcel out each region in chunks along that single dimension
+  std::vector<std::vector<size_t>> chunksMin, chunksMax;
+  for (size_t region = 0; region < regionMin.size(); ++region) {
+    for (size_t chunk = regionMin[region][chunkDimension]; chunk < regionMax[region][chunkDimension];
+         chunk += size_t(chunkNumBins)) {
+      chunksMin.emplace_back(regionMin[region]);
+      chunksMax.emplace_back(regionMax[region]);
+      chunksMin.back()[chunkDimension] = chunk;
+      chunksMax.back()[chunkDimension] =
+          std::min(chunk + size_t(chunkNumBins), regionMax[region][chunkDimension]);
+    }
+  }
+
   // Total number of steps
   size_t progNumSteps = 0;
   if (prog) {
@@ -268,40 +385,55 @@ template <typename MDE, size_t nd> void BinMD::binByIterating(typename MDEventWo
     prog->resetNumSteps(100, 0.00, 1.0);
   }
 
+  // The leaf boxes within a chunk, sorted by file position if file backed to
+  // reduce seeking
+  const auto boxesInChunk = [&](const size_t chunk) {
+    // Build an implicit function (it needs to be in the space of the
+    // MDEventWorkspace)
+    auto function = this->getImplicitFunctionForChunk(chunksMin[chunk].data(), chunksMax[chunk].data());
+    std::vector<API::IMDNode *> boxes;
+    // Leaf-only; no depth limit; with the implicit function passed to it.
+    ws->getBox()->getBoxes(boxes, 1000, true, function.get());
+    if (bc->isFileBacked())
+      API::IMDNode::sortObjByID(boxes);
+    return boxes;
+  };
+
+  // A file-backed workspace is binned serially. Its boxes are found for all the
+  // chunks up front, so that one prefetcher can load them on another thread, in
+  // the order they are binned, for the whole pass.
+  std::vector<std::vector<API::IMDNode *>> fileBackedBoxes;
+  std::vector<size_t> firstBoxOfChunk, prefetchIndex;
+  std::unique_ptr<Kernel::DiskPrefetcher> prefetcher;
+  if (bc->isFileBacked()) {
+    std::vector<Kernel::ISaveable *> toLoad;
+    for (size_t chunk = 0; chunk < chunksMin.size(); ++chunk) {
+      firstBoxOfChunk.emplace_back(prefetchIndex.size());
+      fileBackedBoxes.emplace_back(boxesInChunk(chunk));
+      for (const auto &box : fileBackedBoxes.back()) {
+        prefetchIndex.emplace_back(toLoad.size());
+        Kernel::ISaveable *saveable = box->getISaveable();
+        if (saveable && saveable->wasSaved() && !box->getIsMasked())
+          toLoad.emplace_back(saveable);
+      }
+    }
+    prefetcher = std::make_unique<Kernel::DiskPrefetcher>(std::move(toLoad), *bc->getFileIO(),
+                                                         bc->getFileIO()->getWriteBufferSize());
+  }
+
   // Run the chunks in parallel. There is no overlap in the output workspace so
   // it is thread safe to write to it..
 
     PRAGMA_OMP( parallel for schedule(dynamic,1) if (doParallel) )
-    for (int chunk = 0; chunk < int(m_binDimensions[chunkDimension]->getNBins()); chunk += chunkNumBins) {
+    for (int chunk = 0; chunk < int(chunksMin.size()); ++chunk) {
       PARALLEL_START_INTERRUPT_REGION
       // Region of interest for this chunk.
-      std::vector<size_t> chunkMin(m_outD);
-      std::vector<size_t> chunkMax(m_outD);
-      for (size_t bd = 0; bd < m_outD; bd++) {
-        // Same limits in the other dimensions
-        chunkMin[bd] = 0;
-        chunkMax[bd] = m_binDimensions[bd]->getNBins();
-      }
-      // Parcel out a chunk in that single dimension dimension
-      chunkMin[chunkDimension] = size_t(chunk);
-      if (size_t(chunk + chunkNumBins) > m_binDimensions[chunkDimension]->getNBins())
-        chunkMax[chunkDimension] = m_binDimensions[chunkDimension]->getNBins();
-      else
-        chunkMax[chunkDimension] = size_t(chunk + chunkNumBins);
-
-      // Build an implicit function (it needs to be in the space of the
-      // MDEventWorkspace)
-      auto function = this->getImplicitFunctionForChunk(chunkMin.data(), chunkMax.data());
+      const std::vector<size_t> &chunkMin = chunksMin[chunk];
+      const std::vector<size_t> &chunkMax = chunksMax[chunk];
 
       // Use getBoxes() to get an array with a pointer to each box
-      std::vector<API::IMDNode *> boxes;
-      // Leaf-only; no depth limit; with the implicit function passed to it.
-      ws->getBox()->getBoxes(boxes, 1000, true, function.get());
-
-      // Sort boxes by file position IF file backed. This reduces seeking time,
-      // hopefully.
-      if (bc->isFileBacked())
-        API::IMDNode::sortObjByID(boxes);
+      const std::vector<API::IMDNode *> boxes =
+          prefetcher ? std::move(fileBackedBoxes[chunk]) : boxesInChunk(size_t(chunk));
 
       // For progress reporting, the # of boxes
       if (prog) {
@@ -313,8 +445,10 @@ template <typename MDE, size_t nd> void BinMD::binByIterating(typename MDEventWo
       }
 
       // Go through every box for this chunk.
-      for (auto &boxe : boxes) {
-        auto *box = dynamic_cast<MDBox<MDE, nd> *>(boxe);
+      for (size_t i = 0; i < boxes.size(); ++i) {
+        if (prefetcher)
+          prefetcher->advanceTo(prefetchIndex[firstBoxOfChunk[chunk] + i]);
+        auto *box = dynamic_cast<MDBox<MDE, nd> *>(boxes[i]);
         // Perform the binning in this separate method.
         if (box && !box->getIsMasked())
           this->binMDBox(box, chunkMin.data(), chunkMax.data());
@@ -330,6 +464,9 @@ template <typename MDE, size_t nd> void BinMD::binByIterating(typename MDEventWo
     } // for each chunk in parallel
     PARALLEL_CHECK_INTERRUPT_REGION
 
+    if (useCache)
+      cacheBins();
+
     // Now the implicit function
     if (implicitFunction) {
       if (prog)
@@ -339,10 +476,134 @@ template <typename MDE, size_t nd> void BinMD::binByIterating(typename MDEventWo
     }
 }
 
+//----------------------------------------------------------------------------------------------
+/** Fill the output with the bins it shares with the last incremental binning.
+ * That is possible if the same, unchanged workspace was binned with the same
+ * projection and bin widths and an origin shifted by a whole number of bins.
+ *
+ * @param regionMin :: set to the minimum bin index of each region still to be
+ *binned (inclusive)
+ * @param regionMax :: set to the maximum bin index of each region still to be
+ *binned (exclusive)
+ * @return true if cached bins were used; the regions are only set then
+ */
+bool BinMD::reuseCachedBins(std::vector<std::vector<size_t>> &regionMin, std::vector<std::vector<size_t>> &regionMax) {
+  const Matrix<coord_t> transform = m_transform->makeAffineMatrix();
+  auto &store = incrementalCache();
+  std::lock_guard<std::mutex> lock(store.mutex);
+  const auto entry = store.entries.find(m_inWS.get());
+  if (entry == store.entries.end())
+    return false;
+  const auto &cache = entry->second;
+  if (cache.workspace.lock() != m_inWS || cache.modificationCount != modificationCountOf(*m_inWS) ||
+      cache.numBins.size() != m_outD || cache.transform.numRows() != transform.numRows() ||
+      cache.transform.numCols() != transform.numCols())
+    return false;
+
+  // The linear part must match; the translation may differ by whole bins
+  const size_t inD = transform.numCols() - 1;
+  std::vector<int64_t> shift(m_outD);
+  for (size_t bd = 0; bd < m_outD; bd++) {
+    for (size_t d = 0; d < inD; d++) {
+      if (!nearlyEqual(transform[bd][d], cache.transform[bd][d]))
+        return false;
+    }
+    const double binShift = static_cast<double>(transform[bd][inD]) - static_cast<double>(cache.transform[bd][inD]);
+    shift[bd] = static_cast<int64_t>(std::llround(binShift));
+    if (std::abs(binShift - static_cast<double>(shift[bd])) > 1e-3)
+      return false;
+  }
+
+  // Bin i of the cache is bin i + shift of the output
+  std::vector<size_t> numBins(m_outD), overlapMin(m_outD), overlapMax(m_outD);
+  for (size_t bd = 0; bd < m_outD; bd++) {
+    numBins[bd] = m_binDimensions[bd]->getNBins();
+    const auto low = std::max<int64_t>(0, shift[bd]);
+    const auto high = std::min(static_cast<int64_t>(numBins[bd]), static_cast<int64_t>(cache.numBins[bd]) + shift[bd]);
+    if (low >= high)
+      return false;
+    overlapMin[bd] = static_cast<size_t>(low);
+    overlapMax[bd] = static_cast<size_t>(high);
+  }
+
+  // Copy the overlap, one row along the first dimension at a time
+  std::vector<size_t> cacheMultiplier(m_outD, 1);
+  for (size_t bd = 1; bd < m_outD; bd++)
+    cacheMultiplier[bd] = cacheMultiplier[bd - 1] * cache.numBins[bd - 1];
+  const size_t rowLength = overlapMax[0] - overlapMin[0];
+  std::vector<size_t> index(overlapMin);
+  while (true) {
+    size_t outIndex = 0;
+    size_t cacheIndex = 0;
+    for (size_t bd = 0; bd < m_outD; bd++) {
+      outIndex += index[bd] * indexMultiplier[bd];
+      cacheIndex += static_cast<size_t>(static_cast<int64_t>(index[bd]) - shift[bd]) * cacheMultiplier[bd];
+    }
+    std::copy_n(cache.signals.cbegin() + cacheIndex, rowLength, signals + outIndex);
+    std::copy_n(cache.errorsSquared.cbegin() + cacheIndex, rowLength, errors + outIndex);
+    std::copy_n(cache.numEvents.cbegin() + cacheIndex, rowLength, numEvents + outIndex);
+    size_t bd = 1;
+    for (; bd < m_outD; bd++) {
+      if (++index[bd] < overlapMax[bd])
+        break;
+      index[bd] = overlapMin[bd];
+    }
+    if (bd >= m_outD)
+      break;
+  }
+
+  // The rest of the output is covered by at most two slabs per dimension
+  regionMin.clear();
+  regionMax.clear();
+  for (size_t bd = 0; bd < m_outD; bd++) {
+    std::vector<size_t> slabMin(overlapMin.begin(), overlapMin.begin() + bd);
+    std::vector<size_t> slabMax(overlapMax.begin(), overlapMax.begin() + bd);
+    slabMin.resize(m_outD, 0);
+    slabMax.insert(slabMax.end(), numBins.begin() + bd, numBins.end());
+    if (overlapMin[bd] > 0) {
+      regionMin.emplace_back(slabMin);
+      regionMax.emplace_back(slabMax);
+      regionMax.back()[bd] = overlapMin[bd];
+    }
+    if (overlapMax[bd] < numBins[bd]) {
+      regionMin.emplace_back(slabMin);
+      regionMax.emplace_back(slabMax);
+      regionMin.back()[bd] = overlapMax[bd];
+    }
+  }
+  size_t numReused = 1;
+  for (size_t bd = 0; bd < m_outD; bd++)
+    numReused *= overlapMax[bd] - overlapMin[bd];
+  g_log.information() << "Reusing " << numReused << " bins of the previous incremental binning\n";
+  return true;
+}
+
+/** Keep the output for the next incremental binning of the same workspace,
+ * replacing the one kept before
+ */
+void BinMD::cacheBins() {
+  const size_t numPoints = outWS->getNPoints();
+  auto &store = incrementalCache();
+  std::lock_guard<std::mutex> lock(store.mutex);
+  auto &cache = store.entries[m_inWS.get()];
+  cache.workspace = m_inWS;
+  cache.modificationCount = modificationCountOf(*m_inWS);
+  cache.transform = m_transform->makeAffineMatrix();
+  cache.numBins.resize(m_outD);
+  for (size_t bd = 0; bd < m_outD; bd++)
+    cache.numBins[bd] = m_binDimensions[bd]->getNBins();
+  cache.signals.assign(signals, signals + numPoints);
+  cache.errorsSquared.assign(errors, errors + numPoints);
+  cache.numEvents.assign(numEvents, numEvents + numPoints);
+}
+
 //----------------------------------------------------------------------------------------------
 /** Execute the algorithm.
  */
 void BinMD::exec() {
+  // Do not keep the bins of workspaces that no longer exist
+  incrementalCache().releaseExpired();
+
   // Input MDEventWorkspace/MDHistoWorkspace
   m_inWS = getProperty("InputWorkspace");
   // Look at properties, create either axis-aligned or general transform.
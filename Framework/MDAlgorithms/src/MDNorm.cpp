@@ -11,6 +11,7 @@
 #include "MantidAPI/Run.h"
 #include "MantidAPI/Sample.h"
 #include "MantidAPI/SpectrumInfo.h"
+#include "MantidDataObjects/MDHistoExpression.h"
 #include "MantidDataObjects/MDHistoWorkspace.h"
 #include "MantidGeometry/Crystal/OrientedLattice.h"
 #include "MantidGeometry/Crystal/PointGroupFactory.h"
@@ -25,6 +26,8 @@
 #include "MantidKernel/CompositeValidator.h"
 #include "MantidKernel/ConfigService.h"
 #include "MantidKernel/Exception.h"
+#include "MantidKernel/Memory.h"
+#include "MantidKernel/MultiThreaded.h"
 #include "MantidKernel/Strings.h"
 #include "MantidKernel/UnitLabelTypes.h"
 #include "MantidKernel/VectorHelper.h"
@@ -51,6 +54,48 @@ constexpr double energyToK = 8.0 * M_PI * M_PI * PhysicalConstants::NeutronMass
 
 // compare absolute values of doubles
 static bool abs_compare(double a, double b) { return (std::fabs(a) < std::fabs(b)); }
+
+// Number of detectors handled by one normalization task
+constexpr int64_t DETECTOR_BLOCK_SIZE = 256;
+
+/**
+ * Call function with each of the sorted boundaries strictly between start and
+ * end, found by binary search
+ * @param boundaries :: bin boundaries in increasing order
+ * @param start :: one end of the range
+ * @param end :: the other end of the range
+ * @param increasing :: visit the boundaries in increasing order if true,
+ * decreasing otherwise
+ * @param function :: called with each boundary
+ */
+template <class Function>
+void forEachBoundaryBetween(const std::vector<double> &boundaries, const double start, const double end,
+                            const bool increasing, Function function) {
+  const auto first = std::upper_bound(boundaries.cbegin(), boundaries.cend(), std::min(start, end));
+  const auto last = std::lower_bound(first, boundaries.cend(), std::max(start, end));
+  if (increasing) {
+    for (auto it = first; it != last; ++it)
+      function(*it);
+  } else {
+    for (auto it = last; it != first;)
+      function(*--it);
+  }
+}
+
+// Add the per-thread normalization buffers to the signal of a workspace
+void addBuffers(const std::vector<std::vector<signal_t>> &buffers, MDHistoWorkspace &ws) {
+  signal_t *signal = ws.mutableSignalArray();
+  const auto numPoints = static_cast<int64_t>(ws.getNPoints());
+  PARALLEL_FOR_NO_WSP_CHECK()
+  for (int64_t i = 0; i < numPoints; ++i) {
+    signal_t sum = signal[i];
+    for (const auto &buffer : buffers) {
+      if (!buffer.empty())
+        sum += buffer[i];
+    }
+    signal[i] = sum;
+  }
+}
 } // namespace
 
 // Register the algorithm into the AlgorithmFactory
@@ -63,7 +108,7 @@ DECLARE_ALGORITHM(MDNorm)
 MDNorm::MDNorm()
     : m_normWS(), m_inputWS(), m_isRLU(false), m_UB(3, 3, true), m_W(3, 3, true), m_transformation(), m_hX(), m_kX(),
       m_lX(), m_eX(), m_hIdx(-1), m_kIdx(-1), m_lIdx(-1), m_eIdx(-1), m_numExptInfos(0), m_Ei(0.0), m_diffraction(true),
-      m_accumulate(false), m_dEIntegrated(true), m_samplePos(), m_beamDir(), convention("") {}
+      m_dEIntegrated(true), m_samplePos(), m_beamDir(), convention("") {}
 
 /// Algorithms name for identification. @see Algorithm::name
 const std::string MDNorm::name() const { return "MDNorm"; }
@@ -514,73 +559,30 @@ void MDNorm::exec() {
   }
 
   m_numExptInfos = outputDataWS->getNumExperimentInfo();
-  // loop over all experiment infos
-  for (uint16_t expInfoIndex = 0; expInfoIndex < m_numExptInfos; expInfoIndex++) {
-    // Check for other dimensions if we could measure anything in the original
-    // data
-    bool skipNormalization = false;
-    const std::vector<coord_t> otherValues = getValuesFromOtherDimensions(skipNormalization, expInfoIndex);
-
-    cacheDimensionXValues();
-
-    if (!skipNormalization) {
-      size_t symmOpsIndex = 0;
-      for (const auto &so : symmetryOps) {
-        calculateNormalization(otherValues, so, expInfoIndex, symmOpsIndex);
-        symmOpsIndex++;
-      }
-
-    } else {
-      g_log.warning("Binning limits are outside the limits of the MDWorkspace. "
-                    "Not applying normalization.");
-    }
-    // if more than one experiment info, keep accumulating
-    m_accumulate = true;
-  }
-
-  API::IMDWorkspace_sptr out(nullptr);
+  cacheDimensionXValues();
+  calculateNormalization(symmetryOps);
 
+  // Normalize binned (BinMD) sample workspace, and subtract the normalized
+  // background if there is one, in a single pass over the bins
+  MDHistoWorkspace_sptr out = outputDataWS->clone();
   if (m_backgroundWS) {
-    // Normalize binned (BinMD) sample workspace with background
-    out = divideMD(outputDataWS, m_normWS, getPropertyValue("OutputWorkspace"), 0.97, 0.98);
-
-    // Normalize background
-    const std::string normedBkgdWSName("_normedBkgd");
-    API::IMDWorkspace_sptr outbkgd = divideMD(outputBackgroundDataWS, m_bkgdNormWS, normedBkgdWSName, 0.98, 0.99);
-
-    // Clean workspace
-    auto minusMD = createChildAlgorithm("MinusMD", 0.99, 1.00);
-    // set up
-    minusMD->setProperty("LHSWorkspace", out);
-    minusMD->setProperty("RHSWorkspace", outbkgd);
-    minusMD->setPropertyValue("OutputWorkspace", getPropertyValue("OutputWorkspace"));
-    // run and return
-    minusMD->executeAsChildAlg();
-    out = minusMD->getProperty("OutputWorkspace");
-
+    (MDHistoExpression(*outputDataWS) / *m_normWS - MDHistoExpression(*outputBackgroundDataWS) / *m_bkgdNormWS)
+        .evaluateInto(*out);
   } else {
-    // Normalize binned (BinMD) sample workspace without background
-    out = divideMD(outputDataWS, m_normWS, getPropertyValue("OutputWorkspace"), 0.97, 1.);
+    (MDHistoExpression(*outputDataWS) / *m_normWS).evaluateInto(*out);
   }
+  out->clearMDMasking();
+  // Same flag as set by the MD arithmetic algorithms, checked in BinMD to
+  // avoid binning a modified workspace
+  if (out->getNumExperimentInfo() == 0)
+    out->addExperimentInfo(std::make_shared<ExperimentInfo>());
+  out->getExperimentInfo(0)->mutableRun().addProperty(new PropertyWithValue<std::string>("mdhisto_was_modified", "1"),
+                                                      true);
 
   // Set output workspace
   this->setProperty("OutputWorkspace", out);
 }
 
-inline API::IMDWorkspace_sptr MDNorm::divideMD(const API::IMDHistoWorkspace_sptr &lhs,
-                                               const API::IMDHistoWorkspace_sptr &rhs, const std::string &outputwsname,
-                                               const double &startProgress, const double &endProgress) {
-  auto divideMD = createChildAlgorithm("DivideMD", startProgress, endProgress);
-  divideMD->setProperty("LHSWorkspace", lhs);
-  divideMD->setProperty("RHSWorkspace", rhs);
-  divideMD->setPropertyValue("OutputWorkspace", outputwsname);
-  divideMD->executeAsChildAlg();
-  // API::IMDWorkspace_sptr
-  API::IMDWorkspace_sptr out = divideMD->getProperty("OutputWorkspace");
-
-  return out;
-}
-
 /**
  * Get the dimension name when not using reciprocal lattice units.
  * @param i - axis number to return axis name for.  Can be 0, 1, or 2.
@@ -782,9 +784,6 @@ void MDNorm::createNormalizationWS(const DataObjects::MDHistoWorkspace &dataWS)
   if (!m_normWS) {
     m_normWS = dataWS.clone();
     m_normWS->setTo(0., 0., 0.);
-  } else {
-    // Temp is given.  Accumulation mode is on
-    m_accumulate = true;
   }
 }
 
@@ -1382,15 +1381,15 @@ inline void MDNorm::calcDiffractionIntersectionIntegral(std::vector<std::array<d
  * @param vmdDims: MD dimensions
  * @param pos: position from intersecton for memory efficiency
  * @param posNew: transformed positions
- * @param signalArray: (output) normalization
+ * @param signalArray: (output) normalization buffer of the calling thread
  * @param solidBkgd: background proton charge
- * @param bkgdSignalArray: (output) background normalization
+ * @param bkgdSignalArray: (output) background normalization buffer of the calling thread
  */
 inline void MDNorm::calcSingleDetectorNorm(const std::vector<std::array<double, 4>> &intersections, const double &solid,
                                            std::vector<double> &yValues, const size_t &vmdDims,
                                            std::vector<coord_t> &pos, std::vector<coord_t> &posNew,
-                                           std::vector<std::atomic<signal_t>> &signalArray, const double &solidBkgd,
-                                           std::vector<std::atomic<signal_t>> &bkgdSignalArray) {
+                                           std::vector<signal_t> &signalArray, const double &solidBkgd,
+                                           std::vector<signal_t> &bkgdSignalArray) {
 
   auto intersectionsBegin = intersections.begin();
   for (auto it = intersectionsBegin + 1; it != intersections.end(); ++it) {
@@ -1448,46 +1447,82 @@ inline void MDNorm::calcSingleDetectorNorm(const std::vector<std::array<double,
       continue; // not found
 
     // Set to output
-    // set the calculated signal to
-    Mantid::Kernel::AtomicOp(signalArray[linIndex], signal, std::plus<signal_t>());
+    // set the calculated signal to the buffer of this thread
+    signalArray[linIndex] += signal;
     // [Task 89]
     if (m_backgroundWS)
-      Mantid::Kernel::AtomicOp(bkgdSignalArray[linIndex], bkgdSignal, std::plus<signal_t>());
+      bkgdSignalArray[linIndex] += bkgdSignal;
   }
   return;
 }
 
 /**
- * Computed the normalization for the input workspace. Results are stored in
- * m_normWS
- * @param otherValues - values for dimensions other than Q or DeltaE
- * @param so - symmetry operation
- * @param expInfoIndex - current experiment info index
- * @param soIndex - the index of symmetry operation (for progress purposes only)
+ * Computed the normalization for the input workspace. Results are added to
+ * m_normWS, and m_bkgdNormWS if there is a background.
+ *
+ * Every (experiment info, symmetry operation, block of detectors) triple is a
+ * separate task and all tasks are spread over the threads in one parallel
+ * loop, so many runs or symmetry operations keep all cores busy even when
+ * there are few detectors. Each thread adds into its own normalization
+ * buffer, avoiding atomic updates of shared bins, and the buffers are summed
+ * in parallel over the bins at the end.
+ * @param symmetryOps - symmetry operations
  */
-void MDNorm::calculateNormalization(const std::vector<coord_t> &otherValues, const Geometry::SymmetryOperation &so,
-                                    uint16_t expInfoIndex, size_t soIndex) {
-  const auto &currentExptInfo = *(m_inputWS->getExperimentInfo(expInfoIndex));
-  std::vector<double> lowValues, highValues;
-  auto *lowValuesLog = dynamic_cast<VectorDoubleProperty *>(currentExptInfo.getLog("MDNorm_low"));
-  lowValues = (*lowValuesLog)();
-  auto *highValuesLog = dynamic_cast<VectorDoubleProperty *>(currentExptInfo.getLog("MDNorm_high"));
-  highValues = (*highValuesLog)();
-
-  // calculate Q transformation matrix (R * UB * SymmetryOperation * m_W)^-1
-  // in order to calculate intersections
-  DblMatrix Qtransform = calQTransform(currentExptInfo, so);
-
-  // get proton charges
-  const double protonCharge = currentExptInfo.run().getProtonCharge();
+void MDNorm::calculateNormalization(const std::vector<Geometry::SymmetryOperation> &symmetryOps) {
+  // Inputs common to all detectors of an experiment info
+  struct RunInputs {
+    std::vector<coord_t> otherValues;
+    std::vector<double> lowValues;
+    std::vector<double> highValues;
+    double protonCharge;
+    const SpectrumInfo *spectrumInfo;
+    /// (R * UB * SymmetryOperation * m_W)^-1 for each symmetry operation
+    std::vector<DblMatrix> qTransforms;
+  };
+  // A block of detectors of one experiment info under one symmetry operation
+  struct Task {
+    size_t run;
+    size_t soIndex;
+    int64_t begin;
+    int64_t end;
+  };
+  std::vector<RunInputs> runs;
+  std::vector<Task> tasks;
+  for (uint16_t expInfoIndex = 0; expInfoIndex < m_numExptInfos; expInfoIndex++) {
+    // Check for other dimensions if we could measure anything in the original
+    // data
+    bool skipNormalization = false;
+    RunInputs run;
+    run.otherValues = getValuesFromOtherDimensions(skipNormalization, expInfoIndex);
+    if (skipNormalization) {
+      g_log.warning("Binning limits are outside the limits of the MDWorkspace. "
+                    "Not applying normalization.");
+      continue;
+    }
+    const auto &currentExptInfo = *(m_inputWS->getExperimentInfo(expInfoIndex));
+    run.lowValues = (*dynamic_cast<VectorDoubleProperty *>(currentExptInfo.getLog("MDNorm_low")))();
+    run.highValues = (*dynamic_cast<VectorDoubleProperty *>(currentExptInfo.getLog("MDNorm_high")))();
+    run.protonCharge = currentExptInfo.run().getProtonCharge();
+    run.spectrumInfo = &currentExptInfo.spectrumInfo();
+    run.qTransforms.reserve(symmetryOps.size());
+    for (const auto &so : symmetryOps)
+      run.qTransforms.emplace_back(calQTransform(currentExptInfo, so));
+
+    const auto ndets = static_cast<int64_t>(run.spectrumInfo->size());
+    for (size_t soIndex = 0; soIndex < symmetryOps.size(); ++soIndex) {
+      for (int64_t begin = 0; begin < ndets; begin += DETECTOR_BLOCK_SIZE)
+        tasks.emplace_back(Task{runs.size(), soIndex, begin, std::min(begin + DETECTOR_BLOCK_SIZE, ndets)});
+    }
+    runs.emplace_back(std::move(run));
+  }
+  if (tasks.empty())
+    return;
+
   // [Task 89]
   const double protonChargeBkgd =
       (m_backgroundWS != nullptr) ? m_backgroundWS->getExperimentInfo(0)->run().getProtonCharge() : 0;
 
-  const auto &spectrumInfo = currentExptInfo.spectrumInfo();
-
   // Mappings: solid angle and flux workspaces' detector to ws_index map
-  const auto ndets = static_cast<int64_t>(spectrumInfo.size());
   bool haveSA = false;
   API::MatrixWorkspace_const_sptr solidAngleWS = getProperty("SolidAngleWorkspace");
   if (solidAngleWS != nullptr) {
@@ -1501,119 +1536,133 @@ void MDNorm::calculateNormalization(const std::vector<coord_t> &otherValues, con
 
   // Define dimension, signal array
   const size_t vmdDims = (m_diffraction) ? 3 : 4;
-  std::vector<std::atomic<signal_t>> signalArray(m_normWS->getNPoints());
-
-  size_t numNPoints = (m_backgroundWS) ? m_bkgdNormWS->getNPoints() : 0;
-  if (m_backgroundWS && numNPoints != m_normWS->getNPoints()) {
+  const size_t numNPoints = m_normWS->getNPoints();
+  if (m_backgroundWS && m_bkgdNormWS->getNPoints() != numNPoints) {
     throw std::runtime_error("N points are different");
   }
-  std::vector<std::atomic<signal_t>> bkgdSignalArray(numNPoints);
 
-  std::vector<std::array<double, 4>> intersections;
+  // One buffer per thread, limited by the memory available for them
+  const size_t bufferBytes = numNPoints * sizeof(signal_t) * (m_backgroundWS ? 2 : 1);
+  const size_t maxBuffers = std::max<size_t>(1, MemoryStats().availMem() * 1024 / 2 / std::max<size_t>(bufferBytes, 1));
+  const auto numThreads = static_cast<int>(std::min<size_t>(PARALLEL_GET_MAX_THREADS, maxBuffers));
+  std::vector<std::vector<signal_t>> signalBuffers(numThreads);
+  std::vector<std::vector<signal_t>> bkgdSignalBuffers(numThreads);
+
+  // Per-thread scratch space, reused by all the detectors of a thread
+  std::vector<std::array<double, 4>> intersections, crossings;
   std::vector<double> xValues, yValues;
   std::vector<coord_t> pos, posNew;
 
   // Progress report
-  double progStep = 0.7 / static_cast<double>(m_numExptInfos * m_numSymmOps);
-  auto progIndex = static_cast<double>(soIndex + expInfoIndex * m_numSymmOps);
-  auto prog =
-      std::make_unique<API::Progress>(this, 0.3 + progStep * progIndex, 0.3 + progStep * (1. + progIndex), ndets);
+  const auto numTasks = static_cast<int64_t>(tasks.size());
+  auto prog = std::make_unique<API::Progress>(this, 0.3, 1.0, numTasks);
   // muliple threading
   bool safe = m_diffraction ? Kernel::threadSafe(*integrFlux) : true;
 
-PRAGMA_OMP(parallel for private(intersections, xValues, yValues, pos, posNew) if (safe))
-for (int64_t i = 0; i < ndets; i++) {
-  PARALLEL_START_INTERRUPT_REGION
-
-  // Skip: non-existing detector, monitor and masked detector
-  if (!spectrumInfo.hasDetectors(i) || spectrumInfo.isMonitor(i) || spectrumInfo.isMasked(i)) {
-    continue;
-  }
-
-  const auto &detector = spectrumInfo.detector(i);
-  double theta = detector.getTwoTheta(m_samplePos, m_beamDir);
-  double phi = detector.getPhi();
-  // If the dtefctor is a group, this should be the ID of the first detector
-  const auto detID = detector.getID();
-
-  // get the flux spectrum number: this is for diffraction only!
-  size_t wsIdx = 0;
-  if (m_diffraction) {
-    auto index = fluxDetToIdx.find(detID);
-    if (index != fluxDetToIdx.end()) {
-      wsIdx = index->second;
-    } else { // masked detector in flux, but not in input workspace
-      continue;
+  PRAGMA_OMP(parallel for schedule(dynamic) num_threads(numThreads)
+             private(intersections, crossings, xValues, yValues, pos, posNew) if (safe))
+  for (int64_t taskIndex = 0; taskIndex < numTasks; taskIndex++) {
+    PARALLEL_START_INTERRUPT_REGION
+    const auto &task = tasks[taskIndex];
+    const auto &run = runs[task.run];
+    const auto &spectrumInfo = *run.spectrumInfo;
+    const auto &Qtransform = run.qTransforms[task.soIndex];
+
+    // Allocated by the thread using it
+    auto &signalArray = signalBuffers[PARALLEL_THREAD_NUMBER];
+    auto &bkgdSignalArray = bkgdSignalBuffers[PARALLEL_THREAD_NUMBER];
+    if (signalArray.empty()) {
+      signalArray.resize(numNPoints);
+      if (m_backgroundWS)
+        bkgdSignalArray.resize(numNPoints);
     }
-  }
 
-  // Intersections for sample and background if present
-  this->calculateIntersections(intersections, theta, phi, Qtransform, lowValues[i], highValues[i]);
+    for (int64_t i = task.begin; i < task.end; i++) {
+      // Skip: non-existing detector, monitor and masked detector
+      if (!spectrumInfo.hasDetectors(i) || spectrumInfo.isMonitor(i) || spectrumInfo.isMasked(i)) {
+        continue;
+      }
 
-  // No need to do normalization calculation if there is no intersection
-  if (intersections.empty())
-    continue;
+      const auto &detector = spectrumInfo.detector(i);
+      double theta = detector.getTwoTheta(m_samplePos, m_beamDir);
+      double phi = detector.getPhi();
+      // If the dtefctor is a group, this should be the ID of the first detector
+      const auto detID = detector.getID();
+
+      // get the flux spectrum number: this is for diffraction only!
+      size_t wsIdx = 0;
+      if (m_diffraction) {
+        auto index = fluxDetToIdx.find(detID);
+        if (index != fluxDetToIdx.end()) {
+          wsIdx = index->second;
+        } else { // masked detector in flux, but not in input workspace
+          continue;
+        }
+      }
 
-  // Get solid angle for this contribution
-  double solid = protonCharge;
-  // [Task 89]
-  double bkgdSolid = protonChargeBkgd;
-  if (haveSA) {
-    double solid_angle_factor = solidAngleWS->y(solidAngDetToIdx.find(detID)->second)[0];
-    //  solidAngleWS->y(solidAngDetToIdx.find(detID)->second)[0]
-    solid = solid_angle_factor * protonCharge;
-    // [Task 89]
-    bkgdSolid = solid_angle_factor * protonChargeBkgd;
-  }
+      // Intersections for sample and background if present
+      this->calculateIntersections(intersections, crossings, theta, phi, Qtransform, run.lowValues[i],
+                                   run.highValues[i]);
+
+      // No need to do normalization calculation if there is no intersection
+      if (intersections.empty())
+        continue;
+
+      // Get solid angle for this contribution
+      double solid = run.protonCharge;
+      // [Task 89]
+      double bkgdSolid = protonChargeBkgd;
+      if (haveSA) {
+        double solid_angle_factor = solidAngleWS->y(solidAngDetToIdx.find(detID)->second)[0];
+        solid = solid_angle_factor * run.protonCharge;
+        // [Task 89]
+        bkgdSolid = solid_angle_factor * protonChargeBkgd;
+      }
 
-  if (m_diffraction) {
-    // -- calculate integrals for the intersection --
-    calcDiffractionIntersectionIntegral(intersections, xValues, yValues, *integrFlux, wsIdx);
-  }
+      if (m_diffraction) {
+        // -- calculate integrals for the intersection --
+        calcDiffractionIntersectionIntegral(intersections, xValues, yValues, *integrFlux, wsIdx);
+      }
 
-  // Compute final position in HKL
-  // pre-allocate for efficiency and copy non-hkl dim values into place
-  pos.resize(vmdDims + otherValues.size());
-  std::copy(otherValues.begin(), otherValues.end(), pos.begin() + vmdDims);
+      // Compute final position in HKL
+      // pre-allocate for efficiency and copy non-hkl dim values into place
+      pos.resize(vmdDims + run.otherValues.size());
+      std::copy(run.otherValues.begin(), run.otherValues.end(), pos.begin() + vmdDims);
 
-  calcSingleDetectorNorm(intersections, solid, yValues, vmdDims, pos, posNew, signalArray, bkgdSolid,
-                         bkgdSignalArray); // [Task 89] ADD solidBkgd, bkgdYValues, bkgdSignalArray
+      calcSingleDetectorNorm(intersections, solid, yValues, vmdDims, pos, posNew, signalArray, bkgdSolid,
+                             bkgdSignalArray);
+    }
+    prog->report();
 
-  prog->report();
+    PARALLEL_END_INTERRUPT_REGION
+  }
+  PARALLEL_CHECK_INTERRUPT_REGION
 
-  PARALLEL_END_INTERRUPT_REGION
-}
-PARALLEL_CHECK_INTERRUPT_REGION
-if (m_accumulate) {
-  std::transform(signalArray.cbegin(), signalArray.cend(), m_normWS->getSignalArray(), m_normWS->mutableSignalArray(),
-                 [](const std::atomic<signal_t> &a, const signal_t &b) { return a + b; });
+  addBuffers(signalBuffers, *m_normWS);
   // [Task 89] Process background
   if (m_backgroundWS)
-    std::transform(bkgdSignalArray.cbegin(), bkgdSignalArray.cend(), m_bkgdNormWS->getSignalArray(),
-                   m_bkgdNormWS->mutableSignalArray(),
-                   [](const std::atomic<signal_t> &a, const signal_t &b) { return a + b; });
-
-} else {
-  // First time, init
-  std::copy(signalArray.cbegin(), signalArray.cend(), m_normWS->mutableSignalArray());
-  // [Task 89]
-  if (m_backgroundWS)
-    std::copy(bkgdSignalArray.cbegin(), bkgdSignalArray.cend(), m_bkgdNormWS->mutableSignalArray());
-}
-m_accumulate = true;
+    addBuffers(bkgdSignalBuffers, *m_bkgdNormWS);
 }
 
 /**
  * Calculate the points of intersection for the given detector with cuboid
  * surrounding the detector position in HKL
+ *
+ * The trajectory is a straight line in HKL along which the momentum changes
+ * linearly, so its crossings with the planes of one dimension are found by
+ * binary search of the bin boundaries and come out already ordered by
+ * momentum. The sorted runs of each dimension are then merged rather than
+ * sorted, and all work happens in buffers that are reused between calls.
  * @param intersections A list of intersections in HKL space
+ * @param crossings Scratch space for the crossings of each dimension
  * @param theta Polar angle withd detector
  * @param phi Azimuthal angle with detector
  * @param transform Matrix to convert frm Q_lab to HKL (2Pi*R *UB*W*SO)^{-1}
  * @param lowvalue The lowest momentum or energy transfer for the trajectory
  * @param highvalue The highest momentum or energy transfer for the trajectory
  */
-void MDNorm::calculateIntersections(std::vector<std::array<double, 4>> &intersections, const double theta,
+void MDNorm::calculateIntersections(std::vector<std::array<double, 4>> &intersections,
+                                    std::vector<std::array<double, 4>> &crossings, const double theta,
                                     const double phi, const Kernel::DblMatrix &transform, double lowvalue,
                                     double highvalue) {
   V3D qout(sin(theta) * cos(phi), sin(theta) * sin(phi), cos(theta)), qin(0., 0., 1);
@@ -1642,100 +1691,114 @@ void MDNorm::calculateIntersections(std::vector<std::array<double, 4>> &intersec
   double lStart = qin.Z() * kimin - qout.Z() * kfmin, lEnd = qin.Z() * kimax - qout.Z() * kfmax;
 
   double eps = 1e-10;
-  auto hNBins = m_hX.size();
-  auto kNBins = m_kX.size();
-  auto lNBins = m_lX.size();
-  auto eNBins = m_eX.size();
-  intersections.clear();
-  intersections.reserve(hNBins + kNBins + lNBins + eNBins + 2);
+  const double hMin = m_hX.front(), hMax = m_hX.back();
+  const double kMin = m_kX.front(), kMax = m_kX.back();
+  const double lMin = m_lX.front(), lMax = m_lX.back();
+  crossings.clear();
+  // crossings[runEnds[i - 1]:runEnds[i]] are the crossings of run i, sorted by momentum
+  std::array<size_t, 5> runEnds{};
+  size_t numRuns = 0;
+  // momentum goes from kfmin at the start of the trajectory to kfmax at its end
+  const bool momentumIncreases = kfmax >= kfmin;
 
   // calculate intersections with planes perpendicular to h
   if (fabs(hStart - hEnd) > eps) {
     double fmom = (kfmax - kfmin) / (hEnd - hStart);
     double fk = (kEnd - kStart) / (hEnd - hStart);
     double fl = (lEnd - lStart) / (hEnd - hStart);
-    for (size_t i = 0; i < hNBins; i++) {
-      double hi = m_hX[i];
-      if (((hStart - hi) * (hEnd - hi) < 0)) {
-        // if hi is between hStart and hEnd, then ki and li will be between
-        // kStart, kEnd and lStart, lEnd and momi will be between kfmin and
-        // kfmax
-        double ki = fk * (hi - hStart) + kStart;
-        double li = fl * (hi - hStart) + lStart;
-        if ((ki >= m_kX[0]) && (ki <= m_kX[kNBins - 1]) && (li >= m_lX[0]) && (li <= m_lX[lNBins - 1])) {
-          double momi = fmom * (hi - hStart) + kfmin;
-          intersections.push_back({{hi, ki, li, momi}});
-        }
+    forEachBoundaryBetween(m_hX, hStart, hEnd, (hEnd > hStart) == momentumIncreases, [&](const double hi) {
+      // hi is between hStart and hEnd, so ki and li are between kStart, kEnd
+      // and lStart, lEnd and momi is between kfmin and kfmax
+      double ki = fk * (hi - hStart) + kStart;
+      double li = fl * (hi - hStart) + lStart;
+      if ((ki >= kMin) && (ki <= kMax) && (li >= lMin) && (li <= lMax)) {
+        double momi = fmom * (hi - hStart) + kfmin;
+        crossings.push_back({{hi, ki, li, momi}});
       }
-    }
+    });
   }
+  runEnds[numRuns++] = crossings.size();
+
   // calculate intersections with planes perpendicular to k
   if (fabs(kStart - kEnd) > eps) {
     double fmom = (kfmax - kfmin) / (kEnd - kStart);
     double fh = (hEnd - hStart) / (kEnd - kStart);
     double fl = (lEnd - lStart) / (kEnd - kStart);
-    for (size_t i = 0; i < kNBins; i++) {
-      double ki = m_kX[i];
-      if (((kStart - ki) * (kEnd - ki) < 0)) {
-        // if ki is between kStart and kEnd, then hi and li will be between
-        // hStart, hEnd and lStart, lEnd and momi will be between kfmin and
-        // kfmax
-        double hi = fh * (ki - kStart) + hStart;
-        double li = fl * (ki - kStart) + lStart;
-        if ((hi >= m_hX[0]) && (hi <= m_hX[hNBins - 1]) && (li >= m_lX[0]) && (li <= m_lX[lNBins - 1])) {
-          double momi = fmom * (ki - kStart) + kfmin;
-          intersections.push_back({{hi, ki, li, momi}});
-        }
+    forEachBoundaryBetween(m_kX, kStart, kEnd, (kEnd > kStart) == momentumIncreases, [&](const double ki) {
+      double hi = fh * (ki - kStart) + hStart;
+      double li = fl * (ki - kStart) + lStart;
+      if ((hi >= hMin) && (hi <= hMax) && (li >= lMin) && (li <= lMax)) {
+        double momi = fmom * (ki - kStart) + kfmin;
+        crossings.push_back({{hi, ki, li, momi}});
       }
-    }
+    });
   }
+  runEnds[numRuns++] = crossings.size();
 
   // calculate intersections with planes perpendicular to l
   if (fabs(lStart - lEnd) > eps) {
     double fmom = (kfmax - kfmin) / (lEnd - lStart);
     double fh = (hEnd - hStart) / (lEnd - lStart);
     double fk = (kEnd - kStart) / (lEnd - lStart);
-
-    for (size_t i = 0; i < lNBins; i++) {
-      double li = m_lX[i];
-      if (((lStart - li) * (lEnd - li) < 0)) {
-        double hi = fh * (li - lStart) + hStart;
-        double ki = fk * (li - lStart) + kStart;
-        if ((hi >= m_hX[0]) && (hi <= m_hX[hNBins - 1]) && (ki >= m_kX[0]) && (ki <= m_kX[kNBins - 1])) {
-          double momi = fmom * (li - lStart) + kfmin;
-          intersections.push_back({{hi, ki, li, momi}});
-        }
+    forEachBoundaryBetween(m_lX, lStart, lEnd, (lEnd > lStart) == momentumIncreases, [&](const double li) {
+      double hi = fh * (li - lStart) + hStart;
+      double ki = fk * (li - lStart) + kStart;
+      if ((hi >= hMin) && (hi <= hMax) && (ki >= kMin) && (ki <= kMax)) {
+        double momi = fmom * (li - lStart) + kfmin;
+        crossings.push_back({{hi, ki, li, momi}});
       }
-    }
+    });
   }
+  runEnds[numRuns++] = crossings.size();
+
   // intersections with dE
   if (!m_dEIntegrated) {
-    for (size_t i = 0; i < eNBins; i++) {
-      double kfi = m_eX[i];
-      if ((kfi - kfmin) * (kfi - kfmax) <= 0) {
-        double h = qin.X() * kimin - qout.X() * kfi;
-        double k = qin.Y() * kimin - qout.Y() * kfi;
-        double l = qin.Z() * kimin - qout.Z() * kfi;
-        if ((h >= m_hX[0]) && (h <= m_hX[hNBins - 1]) && (k >= m_kX[0]) && (k <= m_kX[kNBins - 1]) && (l >= m_lX[0]) &&
-            (l <= m_lX[lNBins - 1])) {
-          intersections.push_back({{h, k, l, kfi}});
-        }
+    // m_eX holds final momenta, decreasing with energy transfer. Take those
+    // within [kfmin, kfmax] in increasing order.
+    const auto first = std::lower_bound(m_eX.cbegin(), m_eX.cend(), std::max(kfmin, kfmax), std::greater<double>());
+    auto last = std::upper_bound(first, m_eX.cend(), std::min(kfmin, kfmax), std::greater<double>());
+    while (last != first) {
+      double kfi = *--last;
+      double h = qin.X() * kimin - qout.X() * kfi;
+      double k = qin.Y() * kimin - qout.Y() * kfi;
+      double l = qin.Z() * kimin - qout.Z() * kfi;
+      if ((h >= hMin) && (h <= hMax) && (k >= kMin) && (k <= kMax) && (l >= lMin) && (l <= lMax)) {
+        crossings.push_back({{h, k, l, kfi}});
       }
     }
   }
+  runEnds[numRuns++] = crossings.size();
 
   // endpoints
-  if ((hStart >= m_hX[0]) && (hStart <= m_hX[hNBins - 1]) && (kStart >= m_kX[0]) && (kStart <= m_kX[kNBins - 1]) &&
-      (lStart >= m_lX[0]) && (lStart <= m_lX[lNBins - 1])) {
-    intersections.push_back({{hStart, kStart, lStart, kfmin}});
-  }
-  if ((hEnd >= m_hX[0]) && (hEnd <= m_hX[hNBins - 1]) && (kEnd >= m_kX[0]) && (kEnd <= m_kX[kNBins - 1]) &&
-      (lEnd >= m_lX[0]) && (lEnd <= m_lX[lNBins - 1])) {
-    intersections.push_back({{hEnd, kEnd, lEnd, kfmax}});
+  const bool startInside = (hStart >= hMin) && (hStart <= hMax) && (kStart >= kMin) && (kStart <= kMax) &&
+                           (lStart >= lMin) && (lStart <= lMax);
+  const bool endInside =
+      (hEnd >= hMin) && (hEnd <= hMax) && (kEnd >= kMin) && (kEnd <= kMax) && (lEnd >= lMin) && (lEnd <= lMax);
+  if (momentumIncreases && startInside)
+    crossings.push_back({{hStart, kStart, lStart, kfmin}});
+  if (endInside)
+    crossings.push_back({{hEnd, kEnd, lEnd, kfmax}});
+  if (!momentumIncreases && startInside)
+    crossings.push_back({{hStart, kStart, lStart, kfmin}});
+  runEnds[numRuns++] = crossings.size();
+
+  // merge the runs by final momentum; on ties earlier runs come first, as
+  // with a stable sort of all crossings
+  intersections.clear();
+  std::array<size_t, 5> heads{};
+  for (size_t run = 1; run < numRuns; ++run)
+    heads[run] = runEnds[run - 1];
+  while (true) {
+    size_t next = numRuns;
+    for (size_t run = 0; run < numRuns; ++run) {
+      if (heads[run] < runEnds[run] &&
+          (next == numRuns || compareMomentum(crossings[heads[run]], crossings[heads[next]])))
+        next = run;
+    }
+    if (next == numRuns)
+      break;
+    intersections.emplace_back(crossings[heads[next]++]);
   }
-
-  // sort intersections by final momentum
-  std::stable_sort(intersections.begin(), intersections.end(), compareMomentum);
 }
 
 /**
@@ -1790,8 +1853,8 @@ void MDNorm::calcIntegralsForIntersections(const std::vector<double> &xValues, c
       yValues[i] = yMax;
     } else {
       double xi = xValues[i];
-      while (j < spSize - 1 && xi > xData[j])
-        j++;
+      // xValues are sorted, so search only the points past the previous one
+      j = static_cast<size_t>(std::lower_bound(xData.begin() + j, xData.begin() + (spSize - 1), xi) - xData.begin());
       // if x falls onto an interpolation point return the corresponding y
       if (xi == xData[j]) {
         yValues[i] = yData[j];
@@ -71,6 +71,12 @@ void SaveMD::init() {
                   "This saves it to a file AND makes the workspace into a "
                   "file-backed one.");
   setPropertySettings("MakeFileBacked", std::make_unique<EnabledWhenProperty>("UpdateFileBackEnd", IS_EQUAL_TO, "0"));
+
+  declareProperty("CompressEvents", false,
+                  "For an MDEventWorkspace saved to a new file: store each event field "
+                  "in its own compressed column. This makes much smaller files which are "
+                  "slower to save.");
+  setPropertySettings("CompressEvents", std::make_unique<EnabledWhenProperty>("UpdateFileBackEnd", IS_EQUAL_TO, "0"));
 }
 
 //----------------------------------------------------------------------------------------------
@@ -149,7 +155,9 @@ template <typename MDE, size_t nd> void SaveMD::doSaveEvents(typename MDEventWor
     // the boxes file positions are unknown and we need to calculate it.
     BoxFlatStruct.initFlatStructure(ws, filename);
     // create saver class
-    auto Saver = std::shared_ptr<API::IBoxControllerIO>(new DataObjects::BoxControllerNeXusIO(bc.get()));
+    auto nexusSaver = std::make_shared<DataObjects::BoxControllerNeXusIO>(bc.get());
+    nexusSaver->setCompressedColumns(getProperty("CompressEvents"));
+    auto Saver = std::shared_ptr<API::IBoxControllerIO>(nexusSaver);
     Saver->setDataType(sizeof(coord_t), MDE::getTypeName());
     if (makeFileBackend) {
       // store saver with box controller
@@ -60,6 +60,11 @@ void SaveMD2::init() {
                   "This saves it to a file AND makes the workspace into a "
                   "file-backed one.");
   setPropertySettings("MakeFileBacked", std::make_unique<EnabledWhenProperty>("UpdateFileBackEnd", IS_EQUAL_TO, "0"));
+  declareProperty("CompressEvents", false,
+                  "For an MDEventWorkspace saved to a new file: store each event field "
+                  "in its own compressed column. This makes much smaller files which are "
+                  "slower to save.");
+  setPropertySettings("CompressEvents", std::make_unique<EnabledWhenProperty>("UpdateFileBackEnd", IS_EQUAL_TO, "0"));
   declareProperty("SaveHistory", true, "Option to not save the Mantid history in the file. Only for MDHisto");
   declareProperty("SaveInstrument", true, "Option to not save the instrument in the file. Only for MDHisto");
   declareProperty("SaveSample", true, "Option to not save the sample in the file. Only for MDHisto");
@@ -200,6 +205,7 @@ void SaveMD2::exec() {
     saveMDv1->setProperty<std::string>("Filename", getProperty("Filename"));
     saveMDv1->setProperty<bool>("UpdateFileBackEnd", getProperty("UpdateFileBackEnd"));
     saveMDv1->setProperty<bool>("MakeFileBacked", getProperty("MakeFileBacked"));
+    saveMDv1->setProperty<bool>("CompressEvents", getProperty("CompressEvents"));
     saveMDv1->execute();
   } else if (histoWS) {
     this->doSaveHisto(histoWS);
@@ -187,6 +187,8 @@ void TransformMD::exec() {
   } else if (event) {
     // Call the method for this type of MDEventWorkspace.
     CALL_MDEVENT_FUNCTION(this->doTransform, outWS);
+    // The boxes were changed in place, so results cached from them are stale
+    event->markModified();
     Progress *prog2 = nullptr;
     ThreadScheduler *ts = new ThreadSchedulerFIFO();
     ThreadPool tp(ts, 0, prog2);
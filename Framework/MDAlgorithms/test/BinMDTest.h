@@ -344,6 +344,141 @@ public:
     AnalysisDataService::Instance().remove("BinMDTest_ws");
   }
 
+  void test_Incremental_matches_full_binning() {
+    auto in_ws = std::dynamic_pointer_cast<MDEventWorkspace3Lean>(createSimple3DWorkspace());
+    TS_ASSERT(in_ws);
+    if (!in_ws)
+      return;
+    AnalysisDataService::Instance().addOrReplace("BinMDTest_incremental_in", in_ws);
+    FakeMDEventData fake;
+    fake.initialize();
+    fake.setPropertyValue("InputWorkspace", "BinMDTest_incremental_in");
+    fake.setPropertyValue("UniformParams", "20000");
+    fake.execute();
+    TS_ASSERT_EQUALS(in_ws->getNPoints(), 20000);
+
+    auto bin = [](const std::string &xBinning, const bool incremental) {
+      BinMD alg;
+      alg.initialize();
+      alg.setPropertyValue("InputWorkspace", "BinMDTest_incremental_in");
+      alg.setPropertyValue("AlignedDim0", xBinning);
+      alg.setPropertyValue("AlignedDim1", "y,0,10,5");
+      alg.setPropertyValue("AlignedDim2", "z,0,10,1");
+      alg.setProperty("Incremental", incremental);
+      alg.setPropertyValue("OutputWorkspace", "BinMDTest_incremental_out");
+      alg.execute();
+      TS_ASSERT(alg.isExecuted());
+      return std::dynamic_pointer_cast<MDHistoWorkspace>(
+          AnalysisDataService::Instance().retrieve("BinMDTest_incremental_out"));
+    };
+
+    bin("x,0,5,10", true);
+    // Panned by two bins and extended by two more: the first 8 bins are reused
+    const auto incremental = bin("x,1,7,12", true);
+    const auto full = bin("x,1,7,12", false);
+    TS_ASSERT_EQUALS(incremental->getNPoints(), full->getNPoints());
+    TS_ASSERT_DELTA(incremental->getNEvents(), full->getNEvents(), 1e-6);
+    for (size_t i = 0; i < full->getNPoints(); i++) {
+      TS_ASSERT_DELTA(incremental->getSignalAt(i), full->getSignalAt(i), 1e-6);
+      TS_ASSERT_DELTA(incremental->getErrorAt(i), full->getErrorAt(i), 1e-6);
+      TS_ASSERT_DELTA(incremental->getNumEventsAt(i), full->getNumEventsAt(i), 1e-6);
+    }
+
+    AnalysisDataService::Instance().remove("BinMDTest_incremental_in");
+    AnalysisDataService::Instance().remove("BinMDTest_incremental_out");
+  }
+
+  void test_Incremental_after_masking_does_not_reuse_bins() {
+    auto in_ws = std::dynamic_pointer_cast<MDEventWorkspace3Lean>(createSimple3DWorkspace());
+    TS_ASSERT(in_ws);
+    if (!in_ws)
+      return;
+    AnalysisDataService::Instance().addOrReplace("BinMDTest_incremental_in", in_ws);
+    FakeMDEventData fake;
+    fake.initialize();
+    fake.setPropertyValue("InputWorkspace", "BinMDTest_incremental_in");
+    fake.setPropertyValue("UniformParams", "20000");
+    fake.execute();
+
+    auto bin = [](const bool incremental) {
+      BinMD alg;
+      alg.initialize();
+      alg.setPropertyValue("InputWorkspace", "BinMDTest_incremental_in");
+      alg.setPropertyValue("AlignedDim0", "x,0,10,10");
+      alg.setPropertyValue("AlignedDim1", "y,0,10,5");
+      alg.setPropertyValue("AlignedDim2", "z,0,10,1");
+      alg.setProperty("Incremental", incremental);
+      alg.setPropertyValue("OutputWorkspace", "BinMDTest_incremental_out");
+      alg.execute();
+      TS_ASSERT(alg.isExecuted());
+      return std::dynamic_pointer_cast<MDHistoWorkspace>(
+          AnalysisDataService::Instance().retrieve("BinMDTest_incremental_out"));
+    };
+
+    bin(true);
+    const auto modificationCount = in_ws->getModificationCount();
+    FrameworkManager::Instance().exec("MaskMD", 6, "Workspace", "BinMDTest_incremental_in", "Dimensions",
+                                      "x,y,z", "Extents", "0,5,0,10,0,10");
+    TS_ASSERT_DIFFERS(in_ws->getModificationCount(), modificationCount);
+    const auto incremental = bin(true);
+    const auto full = bin(false);
+    for (size_t i = 0; i < full->getNPoints(); i++) {
+      TS_ASSERT_DELTA(incremental->getSignalAt(i), full->getSignalAt(i), 1e-6);
+      TS_ASSERT_DELTA(incremental->getNumEventsAt(i), full->getNumEventsAt(i), 1e-6);
+    }
+    // The masked half of the workspace is empty
+    TS_ASSERT_DELTA(full->getSignalAt(0), 0., 1e-6);
+
+    AnalysisDataService::Instance().remove("BinMDTest_incremental_in");
+    AnalysisDataService::Instance().remove("BinMDTest_incremental_out");
+  }
+
+  void test_Incremental_after_in_place_TransformMD_does_not_reuse_bins() {
+    auto in_ws = std::dynamic_pointer_cast<MDEventWorkspace3Lean>(createSimple3DWorkspace());
+    TS_ASSERT(in_ws);
+    if (!in_ws)
+      return;
+    AnalysisDataService::Instance().addOrReplace("BinMDTest_incremental_in", in_ws);
+    FakeMDEventData fake;
+    fake.initialize();
+    fake.setPropertyValue("InputWorkspace", "BinMDTest_incremental_in");
+    fake.setPropertyValue("UniformParams", "20000");
+    fake.execute();
+
+    auto bin = [](const bool incremental) {
+      BinMD alg;
+      alg.initialize();
+      alg.setPropertyValue("InputWorkspace", "BinMDTest_incremental_in");
+      alg.setPropertyValue("AlignedDim0", "x,0,10,10");
+      alg.setPropertyValue("AlignedDim1", "y,0,10,5");
+      alg.setPropertyValue("AlignedDim2", "z,0,10,1");
+      alg.setProperty("Incremental", incremental);
+      alg.setPropertyValue("OutputWorkspace", "BinMDTest_incremental_out");
+      alg.execute();
+      TS_ASSERT(alg.isExecuted());
+      return std::dynamic_pointer_cast<MDHistoWorkspace>(
+          AnalysisDataService::Instance().retrieve("BinMDTest_incremental_out"));
+    };
+
+    bin(true);
+    // Moving the events in place leaves the number of events and the totals as they were
+    const auto modificationCount = in_ws->getModificationCount();
+    FrameworkManager::Instance().exec("TransformMD", 6, "InputWorkspace", "BinMDTest_incremental_in",
+                                      "OutputWorkspace", "BinMDTest_incremental_in", "Offset", "5,0,0");
+    TS_ASSERT_DIFFERS(in_ws->getModificationCount(), modificationCount);
+    const auto incremental = bin(true);
+    const auto full = bin(false);
+    for (size_t i = 0; i < full->getNPoints(); i++) {
+      TS_ASSERT_DELTA(incremental->getSignalAt(i), full->getSignalAt(i), 1e-6);
+      TS_ASSERT_DELTA(incremental->getNumEventsAt(i), full->getNumEventsAt(i), 1e-6);
+    }
+    // No events were moved into the first half of the range
+    TS_ASSERT_DELTA(full->getSignalAt(0), 0., 1e-6);
+
+    AnalysisDataService::Instance().remove("BinMDTest_incremental_in");
+    AnalysisDataService::Instance().remove("BinMDTest_incremental_out");
+  }
+
   void test_exec_with_impfunction() {
     // This describes the local implicit function that will always reject bins.
     // so output workspace should have zero.
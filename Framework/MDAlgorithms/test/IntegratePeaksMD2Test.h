@@ -60,7 +60,7 @@ public:
                     std::vector<double> BackgroundStartRadius = {}, bool edge = true, bool cyl = false,
                     std::string fnct = "NoFit", double adaptive = 0.0, bool ellip = false, bool fixQAxis = false,
                     bool useCentroid = false, bool fixMajorAxisLength = true, int maxIterations = 1,
-                    bool maskEdgeTubes = true) {
+                    bool maskEdgeTubes = true, bool batch = false) {
     IntegratePeaksMD2 alg;
     TS_ASSERT_THROWS_NOTHING(alg.initialize())
     TS_ASSERT(alg.isInitialized())
@@ -90,6 +90,7 @@ public:
     if (adaptive > 0.0)
       TS_ASSERT_THROWS_NOTHING(alg.setProperty("AdaptiveQBackground", true));
     TS_ASSERT_THROWS_NOTHING(alg.setProperty("MaskEdgeTubes", maskEdgeTubes));
+    TS_ASSERT_THROWS_NOTHING(alg.setProperty("BatchIntegration", batch));
     TS_ASSERT_THROWS_NOTHING(alg.execute());
     TS_ASSERT(alg.isExecuted());
   }
@@ -185,7 +186,8 @@ public:
   //-------------------------------------------------------------------------------
   /** Setup simple algorithm*/
   static void simpleRun(bool shouldPass, size_t numberValuesPeakRadius, size_t numberValuesBkgInnerRadius,
-                        size_t numberValuesBkgOuterRadius, bool cyl = false, bool ellip = false) {
+                        size_t numberValuesBkgOuterRadius, bool cyl = false, bool ellip = false,
+                        bool batch = false) {
     createMDEW();
     // --- Make a fake PeaksWorkspace ---
     PeaksWorkspace_sptr peakWS = std::make_shared<PeaksWorkspace>();
@@ -209,12 +211,13 @@ public:
     TS_ASSERT_THROWS_NOTHING(alg.setProperty("BackgroundOuterRadius", bkgOuterRadius));
     TS_ASSERT_THROWS_NOTHING(alg.setProperty("Ellipsoid", ellip));
     TS_ASSERT_THROWS_NOTHING(alg.setProperty("Cylinder", cyl));
+    TS_ASSERT_THROWS_NOTHING(alg.setProperty("BatchIntegration", batch));
     Logger logger("Logger_simpleRun");
     logger.notice() << "Running simpleRun with inputs: shouldPass:" << shouldPass
                     << " numberValuesPeakRadius:" << numberValuesPeakRadius
                     << " numberValuesBkgInnerRadius:" << numberValuesBkgInnerRadius
                     << " numberValuesBkgOuterRadius:" << numberValuesBkgOuterRadius << " cyl:" << cyl
-                    << " ellip:" << ellip << "\n";
+                    << " ellip:" << ellip << " batch:" << batch << "\n";
     if (shouldPass) {
       alg.setRethrows(true);
       TS_ASSERT_THROWS_NOTHING(alg.execute());
@@ -529,6 +532,58 @@ public:
                          peakWS->getPeak(0).getIntensity(), 1500);
   }
 
+  //-------------------------------------------------------------------------------
+  /// Batch integration gives the same result as integrating peak by peak
+  void test_exec_BatchIntegration() {
+    createMDEW();
+    addPeak(1000, 0., 0., 0., 1.0);
+    addPeak(1000 * 4, 0., 0., 0., 2.0);
+    addPeak(2000, 2., 3., 4., 0.5);
+    addPeak(3000, -6., 6., 5., 2.0);
+
+    // The real peaks, and a grid of others overlapping each other
+    PeaksWorkspace_sptr peakWS = std::make_shared<PeaksWorkspace>();
+    Instrument_sptr inst = ComponentCreationHelper::createTestInstrumentCylindrical(5);
+    peakWS->addPeak(Peak(inst, 1, 1.0, V3D(0., 0., 0.)));
+    peakWS->addPeak(Peak(inst, 1, 1.0, V3D(2., 3., 4.)));
+    peakWS->addPeak(Peak(inst, 1, 1.0, V3D(-6., 6., 5.)));
+    for (double x = -8.; x <= 8.; x += 1.5) {
+      for (double y = -8.; y <= 8.; y += 4.) {
+        peakWS->addPeak(Peak(inst, 1, 1.0, V3D(x, y, 0.5 * x)));
+      }
+    }
+    AnalysisDataService::Instance().addOrReplace("IntegratePeaksMD2Test_peaks", peakWS);
+
+    for (const bool shell : {false, true}) {
+      const std::vector<double> outer = shell ? std::vector<double>{2.5} : std::vector<double>{0.0};
+      const std::vector<double> inner = shell ? std::vector<double>{1.5} : std::vector<double>{0.0};
+      doRun({1.2}, outer, "IntegratePeaksMD2Test_peaks_single", inner, true, false, "NoFit", 0.0, false, false,
+            false, true, 1, true, false);
+      doRun({1.2}, outer, "IntegratePeaksMD2Test_peaks_batch", inner, true, false, "NoFit", 0.0, false, false, false,
+            true, 1, true, true);
+      auto &ads = AnalysisDataService::Instance();
+      const auto single = ads.retrieveWS<PeaksWorkspace>("IntegratePeaksMD2Test_peaks_single");
+      const auto batch = ads.retrieveWS<PeaksWorkspace>("IntegratePeaksMD2Test_peaks_batch");
+      TS_ASSERT_EQUALS(batch->getNumberPeaks(), single->getNumberPeaks());
+      TS_ASSERT_DELTA(batch->getPeak(0).getIntensity(), single->getPeak(0).getIntensity(), 1e-6);
+      TS_ASSERT_LESS_THAN(500., batch->getPeak(0).getIntensity());
+      for (int i = 0; i < single->getNumberPeaks(); ++i) {
+        TS_ASSERT_DELTA(batch->getPeak(i).getIntensity(), single->getPeak(i).getIntensity(), 1e-6);
+        TS_ASSERT_DELTA(batch->getPeak(i).getSigmaIntensity(), single->getPeak(i).getSigmaIntensity(), 1e-6);
+      }
+      ads.remove("IntegratePeaksMD2Test_peaks_single");
+      ads.remove("IntegratePeaksMD2Test_peaks_batch");
+    }
+    AnalysisDataService::Instance().remove("IntegratePeaksMD2Test_peaks");
+  }
+
+  void test_validationBatchIntegration() {
+    // Batch integration is only for spheres
+    simpleRun(true, 1, 1, 1, false, false, true);
+    simpleRun(false, 1, 1, 1, true, false, true);
+    simpleRun(false, 1, 1, 1, false, true, true);
+  }
+
   //-------------------------------------------------------------------------------
   //// Tests of ellipsoidal integration
 
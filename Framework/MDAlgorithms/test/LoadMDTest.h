@@ -165,7 +165,8 @@ public:
 
   //=================================================================================================================
   template <size_t nd>
-  void do_test_exec(bool FileBackEnd, bool deleteWorkspace = true, double memory = 0, bool BoxStructureOnly = false) {
+  void do_test_exec(bool FileBackEnd, bool deleteWorkspace = true, double memory = 0, bool BoxStructureOnly = false,
+                    bool CompressEvents = false) {
     using MDE = MDLeanEvent<nd>;
 
     //------ Start by creating the file
@@ -193,6 +194,7 @@ public:
     TS_ASSERT(saver.isInitialized())
     TS_ASSERT_THROWS_NOTHING(saver.setProperty("InputWorkspace", "LoadMDTest_ws"));
     TS_ASSERT_THROWS_NOTHING(saver.setPropertyValue("Filename", "LoadMDTest" + Strings::toString(nd) + ".nxs"));
+    TS_ASSERT_THROWS_NOTHING(saver.setProperty("CompressEvents", CompressEvents));
 
     // Retrieve the full path; delete any pre-existing file
     std::string filename = saver.getPropertyValue("Filename");
@@ -387,6 +389,13 @@ public:
     do_test_UpdateFileBackEnd<3>();
   }
 
+  /// Events saved in compressed columns
+  void test_exec_3D_CompressEvents() { do_test_exec<3>(false, true, 0.0, false, true); }
+
+  void test_exec_3D_CompressEvents_with_FileBackEnd_andSmallBuffer() {
+    do_test_exec<3>(true, true, 1.0, false, true);
+  }
+
   /// Only load the box structure, no events
   void test_exec_3D_BoxStructureOnly() { do_test_exec<3>(false, true, 0.0, true); }
 